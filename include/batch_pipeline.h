@@ -0,0 +1,108 @@
+#ifndef BATCH_PIPELINE_H
+#define BATCH_PIPELINE_H
+
+#include <opencv2/opencv.hpp>
+#include "image_decode.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Configuración del pipeline por lotes
+ */
+struct BatchPipelineConfig {
+    std::string filterName = "auto";   // Nombre para FilterFactory::createFilter
+    DecodeMode decodeMode = DecodeMode::COLOR;   // Flags de cv::imread (gris o reducida para previsualizar)
+    int decodeThreads = 2;              // Hilos con cv::imread
+    int filterThreads = 1;              // Hilos de filtro (una estrategia por hilo)
+    int encodeThreads = 2;              // Hilos con cv::imwrite
+    int queueCapacity = 4;              // Imágenes en espera entre dos etapas
+    int threshold = 50;                 // Umbral de la máscara
+    bool writeThreshold = true;         // Escribir también <nombre>_threshold<ext>
+    bool mapPgm = true;                 // PGM de 8 bits con mmap (MappedImage) en vez de imread/imwrite
+
+    void validate() const;
+};
+
+/**
+ * @brief Resultado de BatchPipeline::run
+ *
+ * Los tiempos por etapa suman el tiempo ocupado de todos sus hilos; con
+ * las etapas solapadas el tiempo total se acerca al de la etapa más
+ * lenta (dividida por sus hilos) en lugar de a la suma de las tres.
+ */
+struct BatchPipelineStats {
+    int images = 0;             // Imágenes escritas correctamente
+    int failed = 0;             // Imágenes que no se pudieron leer, filtrar o escribir
+    double decodeMs = 0.0;
+    double filterMs = 0.0;
+    double encodeMs = 0.0;
+    double totalMs = 0.0;
+    double imagesPerSecond = 0.0;
+
+    /**
+     * @brief Etapa con más tiempo por hilo ("lectura", "filtro" o "escritura")
+     */
+    std::string bottleneck;
+};
+
+/**
+ * @brief Procesa muchas imágenes con lectura, filtro y escritura solapados
+ *
+ * Tres grupos de hilos con tamaño independiente conectados por colas
+ * acotadas (BoundedQueue): los lectores decodifican con cv::imread (con
+ * decodeMode pueden leer directamente en gris o reducida), los
+ * hilos de filtro aplican una estrategia de la Factory (cada uno con su
+ * propia instancia, porque las estrategias guardan memoria de trabajo)
+ * y los escritores codifican con cv::imwrite. Las colas limitan las
+ * imágenes en memoria a unas pocas por etapa.
+ *
+ * Los PGM binarios de 8 bits (con mapPgm y lectura en color o gris) no
+ * pasan por el códec: la entrada se proyecta con mmap y el filtro
+ * escribe en salidas proyectadas, que la etapa de escritura solo cierra.
+ * Si alguna salida es un fichero de entrada del lote (mismo directorio
+ * de entrada y salida) todo el lote usa cv::imread/cv::imwrite.
+ *
+ * Una imagen que falla se cuenta en failed y el lote continúa.
+ *
+ * @example
+ * BatchPipelineConfig config;
+ * config.decodeThreads = 4;
+ * BatchPipeline pipeline(config);
+ * auto stats = pipeline.run(BatchPipeline::listInputs("entrada/"), "salida/");
+ */
+class BatchPipeline {
+private:
+    BatchPipelineConfig config_;
+
+public:
+    explicit BatchPipeline(const BatchPipelineConfig& config = BatchPipelineConfig{});
+
+    /**
+     * @brief Procesa inputs y escribe los resultados en outputDir
+     *
+     * Cada entrada produce outputDir/<nombre> (magnitud) y, si
+     * writeThreshold, outputDir/<nombre sin extensión>_threshold<ext>.
+     *
+     * @throws SobelFilterException si el filtro no existe o no se puede crear outputDir
+     */
+    BatchPipelineStats run(const std::vector<std::string>& inputs, const std::string& outputDir) const;
+
+    /**
+     * @brief Entradas de un directorio (imágenes, en orden alfabético) o de una lista
+     *
+     * Si path es un directorio se toman los ficheros con extensión de
+     * imagen conocida; si es un fichero se lee una ruta por línea
+     * (ignorando líneas vacías y las que empiezan por #).
+     */
+    static std::vector<std::string> listInputs(const std::string& path);
+
+    /**
+     * @brief Ruta de salida de input en outputDir con un sufijo antes de la extensión
+     */
+    static std::string outputPathFor(const std::string& input, const std::string& outputDir,
+                                     const std::string& suffix = "");
+
+    const BatchPipelineConfig& getConfig() const { return config_; }
+};
+
+#endif // BATCH_PIPELINE_H
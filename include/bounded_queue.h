@@ -0,0 +1,84 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+
+/**
+ * @brief Cola FIFO con capacidad fija para conectar etapas de un pipeline
+ *
+ * push bloquea mientras la cola está llena y pop mientras está vacía, de
+ * modo que una etapa rápida no acumula trabajo sin límite (la memoria
+ * queda acotada por la capacidad). close() despierta a todos: push
+ * devuelve false a partir de entonces y pop sigue entregando lo que
+ * quede antes de devolver false.
+ *
+ * @example
+ * BoundedQueue<Strip*> queue(3);
+ * queue.push(strip);            // Productor
+ * Strip* next;
+ * while (queue.pop(next)) { ... }   // Consumidor, hasta close()
+ */
+template <typename T>
+class BoundedQueue {
+private:
+    std::mutex mutex_;
+    std::condition_variable notFull_;
+    std::condition_variable notEmpty_;
+    std::deque<T> items_;
+    size_t capacity_;
+    bool closed_ = false;
+
+public:
+    explicit BoundedQueue(size_t capacity) : capacity_(capacity > 0 ? capacity : 1) {}
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    /**
+     * @brief Añade un elemento esperando a que haya hueco
+     * @return false si la cola se ha cerrado (el elemento no se añade)
+     */
+    bool push(T item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notFull_.wait(lock, [&] { return closed_ || items_.size() < capacity_; });
+        if (closed_) {
+            return false;
+        }
+        items_.push_back(std::move(item));
+        notEmpty_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Extrae el elemento más antiguo esperando a que haya alguno
+     * @return false si la cola está cerrada y vacía
+     */
+    bool pop(T& item) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        notEmpty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+        if (items_.empty()) {
+            return false;
+        }
+        item = std::move(items_.front());
+        items_.pop_front();
+        notFull_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Cierra la cola y despierta a productores y consumidores
+     */
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        notFull_.notify_all();
+        notEmpty_.notify_all();
+    }
+
+    size_t capacity() const { return capacity_; }
+};
+
+#endif // BOUNDED_QUEUE_H
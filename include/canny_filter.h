@@ -0,0 +1,110 @@
+#ifndef CANNY_FILTER_H
+#define CANNY_FILTER_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+#include "work_stealing_scheduler.h"
+
+/**
+ * @brief Detector de bordes de Canny sobre los kernels Sobel del proyecto
+ *
+ * La imagen se reparte en bandas horizontales que los hilos de OpenMP
+ * toman con el planificador de robo de trabajo. Cada banda hace en un
+ * único recorrido:
+ *
+ *   1. gradiente + orientación (4 sectores, sin atan2) fila a fila con el
+ *      kernel vectorizado, en un anillo de 3 filas de magnitud uint16
+ *      que cabe en la L1/L2 (la magnitud completa nunca se escribe),
+ *   2. supresión de no máximos comparando con los dos vecinos del
+ *      sector, y clasificación en débil (> low) o fuerte (> high).
+ *
+ * La histéresis se hace con un relleno por pila: primero cada banda en
+ * paralelo sin salir de sus filas, y después un único relleno global
+ * que parte de los bordes fuertes de las filas frontera entre bandas
+ * (solo recorre los débiles que cruzan de una banda a otra).
+ *
+ * Los umbrales están en unidades de la magnitud del modo elegido: EXACT
+ * equivale a L2gradient=true de cv::Canny y L1 a L2gradient=false. No
+ * se suaviza la entrada, igual que cv::Canny. La salida es 255/0 y no
+ * depende del número de hilos.
+ *
+ * @example
+ * CannyFilter canny(50, 150);
+ * cv::Mat edges = canny.applyCanny(input_image);
+ */
+class CannyFilter {
+public:
+    /**
+     * @brief Memoria de trabajo reutilizable entre llamadas
+     *
+     * Gris, anillos de filas y pilas por hilo, y el planificador. Un
+     * Scratch no debe compartirse entre llamadas concurrentes.
+     */
+    struct Scratch {
+        cv::Mat gray;
+        std::vector<std::vector<uint16_t>> magnitudeRings;
+        std::vector<std::vector<uchar>> directionRings;
+        std::vector<std::vector<int>> stacks;
+        std::unique_ptr<WorkStealingScheduler> scheduler;
+    };
+
+private:
+    SobelFilterSIMD engine_;
+    int lowThreshold_;
+    int highThreshold_;
+    int bandHeight_;
+
+public:
+    /**
+     * @brief Alto de banda por defecto (en filas)
+     */
+    static constexpr int DEFAULT_BAND_HEIGHT = 64;
+
+    /**
+     * @brief Constructor
+     * @param lowThreshold Umbral de histéresis bajo (bordes débiles)
+     * @param highThreshold Umbral de histéresis alto (bordes fuertes)
+     * @param mode EXACT (L2) o L1; LINF también se admite
+     * @param level Variante SIMD del gradiente (por defecto la mejor de la CPU)
+     */
+    explicit CannyFilter(int lowThreshold = 50, int highThreshold = 150,
+                         MagnitudeMode mode = MagnitudeMode::EXACT,
+                         SimdLevel level = SobelFilterSIMD::detectBestLevel());
+
+    /**
+     * @brief Detecta bordes con Canny
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @return Bordes (255) en CV_8UC1
+     */
+    cv::Mat applyCanny(const cv::Mat& inputImage) const;
+
+    /**
+     * @brief Igual que applyCanny reutilizando la salida y la memoria de trabajo
+     *
+     * outputImage no puede compartir datos con la entrada.
+     */
+    void applyCannyInto(const cv::Mat& inputImage, cv::Mat& outputImage, Scratch& scratch) const;
+
+    /**
+     * @brief Cambia los umbrales (0 <= low <= high)
+     */
+    void setThresholds(int lowThreshold, int highThreshold);
+    int getLowThreshold() const { return lowThreshold_; }
+    int getHighThreshold() const { return highThreshold_; }
+
+    /**
+     * @brief Cambia el alto de las bandas que se reparten entre hilos
+     */
+    void setBandHeight(int rows);
+    int getBandHeight() const { return bandHeight_; }
+
+    void setMagnitudeMode(MagnitudeMode mode) { engine_.setMagnitudeMode(mode); }
+    MagnitudeMode getMagnitudeMode() const { return engine_.getMagnitudeMode(); }
+    SimdLevel getLevel() const { return engine_.getLevel(); }
+};
+
+#endif // CANNY_FILTER_H
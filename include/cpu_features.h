@@ -0,0 +1,37 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief Extensiones SIMD disponibles en la CPU actual
+ *
+ * Se detectan una sola vez con cpuid (y xgetbv para confirmar que el
+ * sistema operativo guarda los registros extendidos). En arquitecturas
+ * distintas de x86 todas las extensiones quedan a false.
+ *
+ * @example
+ * if (CpuFeatures::get().avx2) { ... }
+ */
+struct CpuFeatures {
+    bool sse41 = false;
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+
+    // Tamaño de la caché L2 por núcleo (256 KB si no se puede consultar)
+    size_t l2CacheBytes = 256 * 1024;
+
+    /**
+     * @brief Devuelve las extensiones detectadas (se calculan una sola vez)
+     */
+    static const CpuFeatures& get();
+
+    /**
+     * @brief Lista legible de extensiones detectadas (p. ej. "sse4.1 avx2")
+     */
+    std::string toString() const;
+};
+
+#endif // CPU_FEATURES_H
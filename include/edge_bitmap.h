@@ -0,0 +1,126 @@
+#ifndef EDGE_BITMAP_H
+#define EDGE_BITMAP_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Máscara de bordes empaquetada a 1 bit por píxel
+ *
+ * Ocupa 8 veces menos que la máscara CV_8UC1 de 0/255. El píxel (r, c)
+ * es el bit (c % 64) de la palabra c / 64 de la fila r (el bit menos
+ * significativo es la columna más a la izquierda). Cada fila ocupa un
+ * número entero de palabras de 64 bits, así que el stride siempre está
+ * alineado a 64 bits, y los bits de relleno al final de la fila valen
+ * siempre 0: los conteos por fila o por bloque se reducen a popcount
+ * sobre palabras completas.
+ *
+ * @example
+ * EdgeBitmap bitmap = EdgeBitmap::fromMask(binaryMask);
+ * size_t edges = bitmap.count();
+ * cv::Mat density = bitmap.countTiles(32, 32);
+ */
+class EdgeBitmap {
+private:
+    int rows_ = 0;
+    int cols_ = 0;
+    size_t strideWords_ = 0;
+    std::vector<uint64_t> words_;
+
+public:
+    /**
+     * @brief Bitmap vacío (0x0)
+     */
+    EdgeBitmap() = default;
+
+    /**
+     * @brief Bitmap de rows x cols con todos los bits a 0
+     */
+    EdgeBitmap(int rows, int cols);
+
+    /**
+     * @brief Empaqueta una máscara CV_8UC1 (cualquier valor != 0 es borde)
+     * @param mask Máscara de 8 bits; puede ser un ROI con stride arbitrario
+     * @return Bitmap con las mismas dimensiones que la máscara
+     */
+    static EdgeBitmap fromMask(const cv::Mat& mask);
+
+    /**
+     * @brief Empaqueta una fila de cols bytes en ceil(cols/64) palabras
+     *
+     * Sirve para que los motores empaqueten fila a fila sin llegar a
+     * escribir la máscara de bytes completa. Los bits de relleno quedan a 0.
+     */
+    static void packRow(const uchar* src, int cols, uint64_t* dst);
+
+    /**
+     * @brief Desempaqueta a una máscara CV_8UC1 con valores 0/255
+     */
+    cv::Mat toMask() const;
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    bool empty() const { return rows_ == 0 || cols_ == 0; }
+
+    /**
+     * @brief Palabras de 64 bits por fila (y su equivalente en bytes)
+     */
+    size_t strideWords() const { return strideWords_; }
+    size_t strideBytes() const { return strideWords_ * sizeof(uint64_t); }
+
+    /**
+     * @brief Memoria ocupada por los bits (incluido el relleno de fila)
+     */
+    size_t sizeBytes() const { return words_.size() * sizeof(uint64_t); }
+
+    /**
+     * @brief Puntero a las palabras de la fila r
+     */
+    const uint64_t* row(int r) const { return words_.data() + static_cast<size_t>(r) * strideWords_; }
+    uint64_t* row(int r) { return words_.data() + static_cast<size_t>(r) * strideWords_; }
+
+    /**
+     * @brief Lee/escribe el píxel (r, c)
+     */
+    bool get(int r, int c) const { return (row(r)[c >> 6] >> (c & 63)) & 1u; }
+    void set(int r, int c, bool edge) {
+        uint64_t bit = uint64_t{1} << (c & 63);
+        uint64_t& word = row(r)[c >> 6];
+        word = edge ? (word | bit) : (word & ~bit);
+    }
+
+    /**
+     * @brief Número de píxeles de borde en la fila r
+     */
+    int countRow(int r) const;
+
+    /**
+     * @brief Número de píxeles de borde por fila (CV_32SC1 de rows x 1)
+     */
+    cv::Mat countRows() const;
+
+    /**
+     * @brief Número total de píxeles de borde
+     */
+    size_t count() const;
+
+    /**
+     * @brief Píxeles de borde en el rectángulo [x, x+width) x [y, y+height)
+     *
+     * El rectángulo se recorta a los límites del bitmap.
+     */
+    int countTile(int x, int y, int width, int height) const;
+
+    /**
+     * @brief Píxeles de borde en cada bloque de tileWidth x tileHeight
+     *
+     * Los bloques del borde derecho/inferior pueden ser más pequeños.
+     *
+     * @return CV_32SC1 de ceil(rows/tileHeight) x ceil(cols/tileWidth)
+     */
+    cv::Mat countTiles(int tileWidth, int tileHeight) const;
+};
+
+#endif // EDGE_BITMAP_H
@@ -5,6 +5,29 @@
 #include <optional>
 #include <string>
 #include <memory>
+#include <vector>
+#include "edge_bitmap.h"
+#include "sobel_magnitude.h"
+#include "sobel_gradients.h"
+
+/**
+ * @brief Cómo se reparten los hilos en un lote de imágenes
+ */
+enum class BatchParallelism {
+    ACROSS_IMAGES,      // Cada hilo procesa imágenes completas (imágenes pequeñas)
+    WITHIN_IMAGE        // Imágenes de una en una con el paralelismo propio del motor
+};
+
+/**
+ * @brief Resultado de procesar un lote con detectEdgesBatch
+ */
+struct BatchStats {
+    size_t images = 0;              // Imágenes del lote
+    size_t failed = 0;              // Imágenes con error (salida vacía)
+    double elapsedMs = 0.0;         // Tiempo total del lote
+    double imagesPerSecond = 0.0;   // Rendimiento del lote
+    BatchParallelism parallelism = BatchParallelism::WITHIN_IMAGE;
+};
 
 /**
  * @brief Estrategia base para algoritmos de detección de bordes
@@ -43,6 +66,174 @@ public:
      */
     virtual std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) = 0;
     
+    /**
+     * @brief Detecta bordes escribiendo en un buffer del llamador
+     * 
+     * Pensado para bucles de vídeo: output solo se reserva si no tiene ya
+     * el tamaño y tipo de la salida, y las estrategias que lo sobrescriben
+     * guardan su memoria de trabajo entre llamadas, de modo que en régimen
+     * estacionario no hay reservas de memoria por fotograma. Por defecto
+     * copia el resultado de detectEdges en output.
+     * 
+     * @param input Imagen de entrada (no puede compartir datos con output)
+     * @param output Imagen de salida, reutilizada entre llamadas
+     * @return true si se ha procesado, false si hay error
+     */
+    virtual bool detectEdgesInto(const cv::Mat& input, cv::Mat& output) {
+        auto result = detectEdges(input);
+        if (!result) {
+            return false;
+        }
+        result->copyTo(output);
+        return true;
+    }
+    
+    /**
+     * @brief Detecta bordes con umbral escribiendo en un buffer del llamador
+     * @param input Imagen de entrada (no puede compartir datos con output)
+     * @param output Imagen binaria de salida, reutilizada entre llamadas
+     * @param threshold Umbral para binarización (0-255)
+     * @return true si se ha procesado, false si hay error
+     * @see detectEdgesInto
+     */
+    virtual bool detectEdgesWithThresholdInto(const cv::Mat& input, cv::Mat& output, int threshold = 128) {
+        auto result = detectEdgesWithThreshold(input, threshold);
+        if (!result) {
+            return false;
+        }
+        result->copyTo(output);
+        return true;
+    }
+
+    /**
+     * @brief Magnitud y máscara con umbral con una sola convolución
+     *
+     * Para quien guarda las dos salidas: llamar a detectEdgesInto y luego
+     * a detectEdgesWithThresholdInto repite el Sobel completo. Aquí la
+     * máscara se deriva de la magnitud con sobelThresholdMagnitude, que da
+     * el mismo resultado que detectEdgesWithThresholdInto en los filtros
+     * Sobel. Los detectores cuya máscara no es un umbral de su salida
+     * (Canny) lo sobrescriben.
+     *
+     * @param input Imagen de entrada (no puede compartir datos con las salidas)
+     * @param magnitude Salida de detectEdgesInto, reutilizada entre llamadas
+     * @param mask Máscara binaria 0/255, reutilizada entre llamadas
+     * @param threshold Umbral para binarización (0-255)
+     * @return true si se ha procesado, false si hay error
+     */
+    virtual bool detectEdgesAndThresholdInto(const cv::Mat& input, cv::Mat& magnitude, cv::Mat& mask,
+                                             int threshold = 128) {
+        if (!detectEdgesInto(input, magnitude)) {
+            return false;
+        }
+        sobelThresholdMagnitude(magnitude, mask, threshold);
+        return true;
+    }
+
+    /**
+     * @brief Detecta bordes con umbral y devuelve la máscara a 1 bit por píxel
+     * 
+     * Pensado para consumidores que solo necesitan saber qué píxeles son
+     * borde (componentes conexas, densidades): ocupa 8 veces menos que la
+     * máscara CV_8UC1 y permite contar bordes por fila o por bloque con
+     * popcount (ver EdgeBitmap). Por defecto empaqueta el resultado de
+     * detectEdgesWithThreshold; los motores que pueden empaquetar fila a
+     * fila lo sobrescriben.
+     * 
+     * @param input Imagen de entrada
+     * @param threshold Umbral para binarización (0-255)
+     * @return Bitmap con los bordes o std::nullopt si hay error
+     */
+    virtual std::optional<EdgeBitmap> detectEdgesPacked(const cv::Mat& input, int threshold = 128) {
+        auto mask = detectEdgesWithThreshold(input, threshold);
+        if (!mask) {
+            return std::nullopt;
+        }
+        return EdgeBitmap::fromMask(*mask);
+    }
+    
+    /**
+     * @brief Magnitud y gradientes con signo (Gx, Gy) en una sola pasada
+     * 
+     * Para etapas posteriores que necesitan la dirección del gradiente
+     * (NMS de Canny, HOG, flujo óptico): en vez de volver a convolucionar
+     * la imagen, Gx y Gy se escriben en CV_16S a la vez que la magnitud,
+     * intercalados en una imagen CV_16SC2 o en dos planos CV_16SC1 según
+     * layout. La magnitud usa getMagnitudeMode(), igual que detectEdges.
+     * 
+     * Solo entradas de 8 bits (CV_8UC1 o CV_8UC3): con 16 bits o float los
+     * gradientes no caben en CV_16S. La implementación por defecto recorre
+     * la imagen una vez en el hilo que llama; los motores vectorizados la
+     * sobrescriben. Las imágenes de output se reutilizan entre llamadas.
+     * 
+     * @param input Imagen de entrada (no puede compartir datos con output)
+     * @param output Magnitud y gradientes (ver SobelGradients)
+     * @param layout INTERLEAVED (output.gxy) o PLANAR (output.gx, output.gy)
+     * @return true si se ha procesado, false si hay error
+     */
+    virtual bool detectGradientsInto(const cv::Mat& input, SobelGradients& output,
+                                     GradientLayout layout = GradientLayout::INTERLEAVED);
+    
+    /**
+     * @brief Igual que detectGradientsInto pero devolviendo imágenes nuevas
+     * @return Magnitud y gradientes o std::nullopt si hay error
+     */
+    std::optional<SobelGradients> detectGradients(const cv::Mat& input,
+                                                  GradientLayout layout = GradientLayout::INTERLEAVED) {
+        SobelGradients gradients;
+        if (!detectGradientsInto(input, gradients, layout)) {
+            return std::nullopt;
+        }
+        return gradients;
+    }
+    
+    /**
+     * @brief Píxeles por imagen por debajo de los cuales un lote se reparte por imágenes
+     */
+    static constexpr int BATCH_SMALL_IMAGE_PIXELS = 512 * 512;
+    
+    /**
+     * @brief Procesa un lote de imágenes en una sola llamada
+     * 
+     * Con imágenes pequeñas (miniaturas) el coste de abrir y cerrar una
+     * región paralela por imagen domina, así que cada hilo procesa
+     * imágenes completas de una cola con robo de trabajo. Con imágenes
+     * grandes se procesan de una en una usando el paralelismo interno
+     * del motor. Ver chooseBatchParallelism().
+     * 
+     * @param inputs Imágenes de entrada
+     * @param outputs Se redimensiona a inputs.size(); las imágenes con error quedan vacías
+     * @param threshold Si se indica, salida binaria con ese umbral
+     * @return Estadísticas del lote (incluye imágenes/s)
+     */
+    BatchStats detectEdgesBatch(const std::vector<cv::Mat>& inputs, std::vector<cv::Mat>& outputs,
+                                std::optional<int> threshold = std::nullopt);
+    
+    /**
+     * @brief Reparto que usaría detectEdgesBatch para estas entradas
+     * 
+     * ACROSS_IMAGES si la estrategia admite llamadas concurrentes
+     * (supportsSerialBatch), hay más de una imagen y su tamaño medio no
+     * supera BATCH_SMALL_IMAGE_PIXELS; WITHIN_IMAGE en otro caso.
+     */
+    BatchParallelism chooseBatchParallelism(const std::vector<cv::Mat>& inputs) const;
+    
+    /**
+     * @brief Selecciona cómo se calcula la magnitud del gradiente
+     * 
+     * EXACT reproduce la raíz euclídea original; L1 y LINF son
+     * aproximaciones más baratas, suficientes cuando solo interesa
+     * el resultado con umbral.
+     * 
+     * @param mode Modo de magnitud
+     */
+    virtual void setMagnitudeMode(MagnitudeMode mode) = 0;
+    
+    /**
+     * @brief Obtiene el modo de magnitud actual
+     */
+    virtual MagnitudeMode getMagnitudeMode() const = 0;
+    
     /**
      * @brief Obtiene el nombre del algoritmo
      * @return String con el nombre del algoritmo
@@ -71,6 +262,36 @@ public:
      * @brief Resetea las estadísticas de ejecución
      */
     virtual void resetStats() = 0;
+
+protected:
+    /**
+     * @brief Indica si detectEdgesSerial está disponible
+     */
+    virtual bool supportsSerialBatch() const { return false; }
+    
+    /**
+     * @brief Procesa una imagen en el hilo que llama, sin paralelismo interno
+     * 
+     * Solo se usa si supportsSerialBatch() es true. Debe poder llamarse
+     * desde varios hilos a la vez (sin escribir estado de la estrategia).
+     * 
+     * @param input Imagen de entrada
+     * @param threshold Si se indica, salida binaria con ese umbral
+     * @return Imagen con bordes
+     * @throws std::exception si hay error
+     */
+    virtual cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const;
+    
+    /**
+     * @brief Pasada escalar de referencia para detectGradientsInto
+     * 
+     * @param gray Imagen CV_8UC1
+     * @param output Se reserva con prepareSobelGradients
+     * @param layout Disposición de Gx/Gy
+     * @param mode Cálculo de la magnitud
+     */
+    static void computeGradients(const cv::Mat& gray, SobelGradients& output,
+                                 GradientLayout layout, MagnitudeMode mode);
 };
 
 #endif // EDGE_DETECTION_STRATEGY_H 
\ No newline at end of file
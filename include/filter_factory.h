@@ -29,7 +29,13 @@ public:
         SOBEL_IMPROVED,     // Filtro Sobel mejorado (C++ moderno)
         SOBEL_OMP,          // Filtro Sobel con OpenMP
         SOBEL_PTHREAD,      // Filtro Sobel con pThreads
-        CANNY               // Filtro Canny (futuro)
+        SOBEL_SIMD,         // Filtro Sobel vectorizado (SSE4.1/AVX2/AVX-512)
+        SOBEL_SEPARABLE,    // Filtro Sobel separable en dos pasadas
+        SOBEL_TILED,        // Filtro Sobel OpenMP por bloques 2D ajustados a la L2
+        SOBEL_TEMPLATE,             // Filtro Sobel con kernel en tiempo de compilación (3x3)
+        SOBEL_TEMPLATE_REPLICATE,   // Ídem calculando también el borde (BorderReplicate)
+        SOBEL_TEMPLATE_5X5,         // Ídem con kernel de Sobel 5x5
+        CANNY               // Detector de Canny (gradiente SIMD, histéresis por bandas)
     };
     
     /**
@@ -41,7 +47,14 @@ public:
     
     /**
      * @brief Crea un filtro a partir de su nombre
-     * @param name Nombre del filtro ("sobel", "sobel_omp", etc.)
+     * 
+     * El nombre "auto" crea el kernel más rápido que soporta la CPU
+     * (escalar, SSE4.1, AVX2 o AVX-512), detectado con cpuid al primer
+     * uso. También se acepta "sobel_simd_<variante>" para forzar una
+     * variante concreta (p. ej. "sobel_simd_avx2") y "sobel_pthread_<N>"
+     * para fijar el número de hilos del pool (p. ej. "sobel_pthread_8").
+     * 
+     * @param name Nombre del filtro ("sobel", "sobel_omp", "auto", etc.)
      * @return Puntero único al filtro creado o nullptr si no se pudo crear
      */
     static std::unique_ptr<EdgeDetectionStrategy> createFilter(const std::string& name);
@@ -0,0 +1,130 @@
+#ifndef IMAGE_DECODE_H
+#define IMAGE_DECODE_H
+
+#include <opencv2/opencv.hpp>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <string>
+
+/**
+ * @brief Cómo decodificar la imagen de entrada
+ *
+ * Todos los filtros trabajan en gris: decodificar en color y convertir
+ * después paga tres canales que se descartan. GRAY decodifica un único
+ * canal (en JPEG se toma la luminancia sin reconstruir BGR). Los modos
+ * REDUCED usan además el escalado en el dominio DCT del JPEG (1/2, 1/4,
+ * 1/8), mucho más barato que decodificar y redimensionar; en otros
+ * formatos OpenCV decodifica completo y reduce después.
+ */
+enum class DecodeMode {
+    COLOR,          // cv::IMREAD_COLOR (comportamiento anterior)
+    GRAY,           // cv::IMREAD_GRAYSCALE
+    REDUCED_2,      // cv::IMREAD_REDUCED_GRAYSCALE_2 (vista previa)
+    REDUCED_4,      // cv::IMREAD_REDUCED_GRAYSCALE_4
+    REDUCED_8       // cv::IMREAD_REDUCED_GRAYSCALE_8
+};
+
+/**
+ * @brief Flags de cv::imread para cada modo
+ */
+inline int decodeModeFlags(DecodeMode mode) {
+    switch (mode) {
+        case DecodeMode::GRAY:      return cv::IMREAD_GRAYSCALE;
+        case DecodeMode::REDUCED_2: return cv::IMREAD_REDUCED_GRAYSCALE_2;
+        case DecodeMode::REDUCED_4: return cv::IMREAD_REDUCED_GRAYSCALE_4;
+        case DecodeMode::REDUCED_8: return cv::IMREAD_REDUCED_GRAYSCALE_8;
+        default:                    return cv::IMREAD_COLOR;
+    }
+}
+
+/**
+ * @brief Convierte el modo a string ("color", "gray", "reduced2", "reduced4", "reduced8")
+ */
+inline std::string decodeModeToString(DecodeMode mode) {
+    switch (mode) {
+        case DecodeMode::GRAY:      return "gray";
+        case DecodeMode::REDUCED_2: return "reduced2";
+        case DecodeMode::REDUCED_4: return "reduced4";
+        case DecodeMode::REDUCED_8: return "reduced8";
+        default:                    return "color";
+    }
+}
+
+/**
+ * @brief Convierte un nombre ("color", "gray", "reduced2/4/8") a DecodeMode
+ * @return false si el nombre no es válido (mode no se modifica)
+ */
+inline bool stringToDecodeMode(const std::string& name, DecodeMode& mode) {
+    for (DecodeMode candidate : {DecodeMode::COLOR, DecodeMode::GRAY, DecodeMode::REDUCED_2,
+                                 DecodeMode::REDUCED_4, DecodeMode::REDUCED_8}) {
+        if (name == decodeModeToString(candidate)) {
+            mode = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief cv::imread con el modo indicado, midiendo el tiempo de decodificación
+ * @param elapsedMs Si no es nullptr, recibe los milisegundos empleados
+ */
+inline cv::Mat decodeImage(const std::string& path, DecodeMode mode, double* elapsedMs = nullptr) {
+    auto start = std::chrono::high_resolution_clock::now();
+    cv::Mat image = cv::imread(path, decodeModeFlags(mode));
+    auto end = std::chrono::high_resolution_clock::now();
+    if (elapsedMs) {
+        *elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    }
+    return image;
+}
+
+/**
+ * @brief Línea de informe con el tiempo de decodificación
+ *
+ * Por defecto solo da el tiempo de la lectura ya hecha. Con compareColor
+ * (opción --decode-report de las CLI) y un modo distinto de COLOR vuelve
+ * a decodificar el fichero en el modo pedido y en color para medir lo
+ * ahorrado: las dos lecturas extra encuentran el fichero en la caché de
+ * páginas, así que se comparan entre sí y no con la primera.
+ */
+inline std::string decodeReport(const std::string& path, DecodeMode mode, double elapsedMs,
+                                bool compareColor = false) {
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2)
+           << "Decodificación (" << decodeModeToString(mode) << "): " << elapsedMs << " ms";
+    if (compareColor && mode != DecodeMode::COLOR) {
+        double modeMs = 0.0;
+        double colorMs = 0.0;
+        decodeImage(path, mode, &modeMs);
+        decodeImage(path, DecodeMode::COLOR, &colorMs);
+        report << " (en caché: " << decodeModeToString(mode) << " " << modeMs << " ms, color " << colorMs
+               << " ms, ahorro " << (colorMs - modeMs) << " ms)";
+    }
+    return report.str();
+}
+
+/**
+ * @brief Quita "--decode-report" de los argumentos de una CLI
+ *
+ * Deja argc/argv como si la opción no estuviera, para que el resto del
+ * análisis posicional no cambie.
+ *
+ * @return true si la opción estaba presente
+ */
+inline bool takeDecodeReportFlag(int& argc, char** argv) {
+    bool found = false;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        if (std::string(argv[i]) == "--decode-report") {
+            found = true;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    return found;
+}
+
+#endif // IMAGE_DECODE_H
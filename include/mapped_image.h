@@ -0,0 +1,136 @@
+#ifndef MAPPED_IMAGE_H
+#define MAPPED_IMAGE_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <string>
+#include <sys/types.h>
+
+/**
+ * @brief Imagen respaldada por un fichero proyectado en memoria (mmap)
+ *
+ * Para pasar imágenes entre etapas propias no hace falta codificar: un
+ * PGM binario o un fichero raw se proyecta en memoria y mat() devuelve
+ * un cv::Mat que apunta directamente a las páginas del fichero, sin
+ * copias ni reservas. Las salidas se crean ya con su tamaño final y el
+ * filtro escribe en ellas como en cualquier otra imagen; leer y escribir
+ * se reduce a fallos de página.
+ *
+ * Formatos:
+ * - PGM binario (P5) de 8 bits (maxval <= 255) o 16 bits (<= 65535).
+ *   El de 16 bits se guarda en big-endian, así que al abrirlo se
+ *   proyecta en privado (copy-on-write) y se invierten los bytes en el
+ *   sitio; al crear uno, close() los invierte antes de soltar la
+ *   proyección. Si la cabecera deja los píxeles en una posición impar
+ *   se copian a memoria propia (createPgm rellena la cabecera para
+ *   que no ocurra).
+ * - Raw planar: planos de rows x cols píxeles CV_8U o CV_16U
+ *   (orden de bytes de la máquina) uno tras otro, sin cabecera.
+ *
+ * El cv::Mat deja de ser válido tras close() o al destruir el objeto.
+ * Una salida no puede ser un fichero que siga proyectado como entrada
+ * (truncarlo dejaría la entrada a ceros): createPgm/createRaw lo
+ * rechazan.
+ *
+ * @example
+ * MappedImage input = MappedImage::openPgm("frame.pgm");
+ * MappedImage edges = MappedImage::createPgm("edges.pgm", input.rows(), input.cols());
+ * cv::Mat out = edges.mat();
+ * strategy->detectEdgesInto(input.mat(), out);
+ * edges.close();
+ */
+class MappedImage {
+private:
+    int fd_ = -1;
+    void* data_ = nullptr;           // Inicio de la proyección
+    size_t mappedBytes_ = 0;
+    size_t headerBytes_ = 0;         // Cabecera PGM antes de los píxeles (0 en raw)
+    int rows_ = 0;
+    int cols_ = 0;
+    int depth_ = CV_8U;
+    int planes_ = 1;
+    bool writable_ = false;
+    bool bigEndianPixels_ = false;   // PGM de 16 bits: invertir bytes al cerrar una salida
+    cv::Mat owned_;                  // PGM de 16 bits con píxeles en posición impar: copia alineada
+    std::string path_;
+    bool registered_ = false;        // Entrada anotada en el registro de ficheros proyectados
+    dev_t device_ = 0;
+    ino_t inode_ = 0;
+
+    // Proyecta el fichero entero; con createBytes > 0 lo crea antes con ese tamaño
+    void map(const std::string& path, size_t createBytes);
+    void release() noexcept;
+
+public:
+    MappedImage() = default;
+    ~MappedImage();
+
+    MappedImage(MappedImage&& other) noexcept;
+    MappedImage& operator=(MappedImage&& other) noexcept;
+    MappedImage(const MappedImage&) = delete;
+    MappedImage& operator=(const MappedImage&) = delete;
+
+    /**
+     * @brief Proyecta un PGM binario (P5) de solo lectura
+     * @throws InvalidImageException si no es un P5 válido o el fichero está truncado
+     */
+    static MappedImage openPgm(const std::string& path);
+
+    /**
+     * @brief Proyecta un fichero raw planar de solo lectura
+     * @param depth CV_8U o CV_16U
+     * @param planes Número de planos consecutivos de rows x cols
+     * @throws InvalidImageException si el tamaño del fichero no corresponde
+     */
+    static MappedImage openRaw(const std::string& path, int rows, int cols, int depth = CV_8U, int planes = 1);
+
+    /**
+     * @brief Crea (o trunca) un PGM del tamaño final y lo proyecta para escritura
+     * @param depth CV_8U (maxval 255) o CV_16U (maxval 65535)
+     * @throws SobelFilterException si no se puede crear o si path es un
+     *         fichero proyectado como entrada en este proceso
+     */
+    static MappedImage createPgm(const std::string& path, int rows, int cols, int depth = CV_8U);
+
+    /**
+     * @brief Crea (o trunca) un raw planar del tamaño final y lo proyecta para escritura
+     * @throws SobelFilterException si no se puede crear o si path está proyectado como entrada
+     */
+    static MappedImage createRaw(const std::string& path, int rows, int cols, int depth = CV_8U, int planes = 1);
+
+    /**
+     * @brief Vista sin copia de un plano (CV_8UC1 o CV_16UC1)
+     */
+    cv::Mat mat(int plane = 0) const;
+
+    /**
+     * @brief Suelta la proyección; en salidas PGM de 16 bits pasa antes a big-endian
+     *
+     * Los datos quedan en la caché de páginas y el sistema los escribe
+     * cuando le conviene; con sync = true se espera a que lleguen al disco.
+     *
+     * @throws SobelFilterException si msync falla
+     */
+    void close(bool sync = false);
+
+    bool isOpen() const { return data_ != nullptr; }
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int depth() const { return depth_; }
+    int planes() const { return planes_; }
+    size_t fileBytes() const { return mappedBytes_; }
+
+    /**
+     * @brief Indica si la ruta tiene extensión .raw (sin distinguir mayúsculas)
+     */
+    static bool isRawPath(const std::string& path);
+
+    /**
+     * @brief Indica si las dos rutas son el mismo fichero (enlaces incluidos)
+     *
+     * false si alguna no existe: una salida que aún no existe no puede ser la entrada.
+     */
+    static bool sameFile(const std::string& first, const std::string& second);
+};
+
+#endif // MAPPED_IMAGE_H
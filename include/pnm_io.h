@@ -0,0 +1,95 @@
+#ifndef PNM_IO_H
+#define PNM_IO_H
+
+#include <opencv2/opencv.hpp>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Lectura por filas de PGM (P5) y PPM (P6) binarios de 8 bits
+ *
+ * cv::imread solo decodifica imágenes completas; para mosaicos que no
+ * caben en memoria se usa este lector, que avanza fila a fila sobre el
+ * fichero y entrega las filas ya en gris. Los PPM se convierten con
+ * COLOR_RGB2GRAY (mismo resultado que imread + COLOR_BGR2GRAY).
+ *
+ * @example
+ * PnmReader reader("mosaico.ppm");
+ * cv::Mat strip(256, reader.cols(), CV_8UC1);
+ * reader.readGrayRows(strip);   // Filas 0..255
+ */
+class PnmReader {
+private:
+    std::ifstream file_;
+    std::string path_;
+    int rows_ = 0;
+    int cols_ = 0;
+    int channels_ = 0;
+    int nextRow_ = 0;
+    std::vector<uchar> rgbBuffer_;   // Filas RGB antes de convertir (solo P6)
+
+public:
+    /**
+     * @brief Abre el fichero y lee la cabecera
+     * @throws InvalidImageException si no es un P5/P6 de 8 bits válido
+     */
+    explicit PnmReader(const std::string& path);
+
+    /**
+     * @brief Lee las siguientes rows.rows filas en gris
+     * @param rows Destino CV_8UC1 de ancho cols() (puede ser una vista de otra imagen)
+     * @throws InvalidImageException si el fichero se acaba antes de tiempo
+     */
+    void readGrayRows(cv::Mat& rows);
+
+    int rows() const { return rows_; }
+    int cols() const { return cols_; }
+    int channels() const { return channels_; }
+
+    /**
+     * @brief Índice de la siguiente fila que se leerá
+     */
+    int nextRow() const { return nextRow_; }
+
+    /**
+     * @brief Indica si el fichero empieza por la firma P5 o P6
+     */
+    static bool isPnmFile(const std::string& path);
+};
+
+/**
+ * @brief Escritura por filas de PGM binario (P5) de 8 bits
+ *
+ * La cabecera se escribe al abrir; close() comprueba que se han escrito
+ * exactamente las filas anunciadas.
+ */
+class PnmWriter {
+private:
+    std::ofstream file_;
+    std::string path_;
+    int rows_;
+    int cols_;
+    int writtenRows_ = 0;
+
+public:
+    /**
+     * @brief Crea el fichero y escribe la cabecera
+     * @throws SobelFilterException si no se puede crear
+     */
+    PnmWriter(const std::string& path, int rows, int cols);
+
+    /**
+     * @brief Añade filas CV_8UC1 de ancho cols al final del fichero
+     */
+    void writeRows(const cv::Mat& rows);
+
+    /**
+     * @brief Vacía el fichero y verifica que está completo
+     */
+    void close();
+
+    int writtenRows() const { return writtenRows_; }
+};
+
+#endif // PNM_IO_H
@@ -0,0 +1,86 @@
+#ifndef PTHREAD_POOL_H
+#define PTHREAD_POOL_H
+
+#include <pthread.h>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * @brief Pool de hilos persistente basado en pThreads
+ *
+ * Los hilos se crean una sola vez en el constructor y se reutilizan
+ * en cada llamada, evitando el coste de pthread_create/pthread_join
+ * por frame. El trabajo se reparte en bandas (p. ej. rangos de filas)
+ * a través de una cola protegida por mutex y variables de condición.
+ *
+ * @example
+ * PThreadPool pool(8);
+ * pool.parallelFor(8, [&](int band) { procesarBanda(band); });
+ */
+class PThreadPool {
+private:
+    /**
+     * @brief Grupo de tareas de una llamada a parallelFor
+     */
+    struct Batch {
+        const std::function<void(int)>* function;
+        int pending;
+    };
+
+    /**
+     * @brief Tarea individual: una banda de un grupo
+     */
+    struct Task {
+        Batch* batch;
+        int band;
+    };
+
+    std::vector<pthread_t> threads_;
+    std::deque<Task> tasks_;
+    pthread_mutex_t mutex_;
+    pthread_cond_t taskAvailable_;
+    pthread_cond_t batchDone_;
+    bool stop_ = false;
+
+    // Función que ejecuta cada hilo del pool
+    static void* workerMain(void* arg);
+
+public:
+    /**
+     * @brief Crea el pool y lanza los hilos
+     *
+     * Si pthread_create falla a mitad, el pool se queda con los hilos ya
+     * creados (size() lo refleja).
+     *
+     * @param numThreads Número de hilos (si es <= 0 usa hardware_concurrency)
+     * @throws std::runtime_error si no se pudo crear ningún hilo
+     */
+    explicit PThreadPool(int numThreads = 0);
+
+    /**
+     * @brief Detiene y espera a todos los hilos
+     */
+    ~PThreadPool();
+
+    PThreadPool(const PThreadPool&) = delete;
+    PThreadPool& operator=(const PThreadPool&) = delete;
+
+    /**
+     * @brief Ejecuta function(band) para cada band en [0, numBands)
+     *
+     * Bloquea hasta que todas las bandas han terminado. Puede llamarse
+     * desde varios hilos a la vez; cada llamada espera solo a sus bandas.
+     *
+     * @param numBands Número de bandas a ejecutar
+     * @param function Trabajo a realizar para cada banda
+     */
+    void parallelFor(int numBands, const std::function<void(int)>& function);
+
+    /**
+     * @brief Obtiene el número de hilos del pool
+     */
+    int size() const { return static_cast<int>(threads_.size()); }
+};
+
+#endif // PTHREAD_POOL_H
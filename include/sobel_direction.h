@@ -0,0 +1,79 @@
+#ifndef SOBEL_DIRECTION_H
+#define SOBEL_DIRECTION_H
+
+#include <opencv2/opencv.hpp>
+#include <cstdlib>
+#include <string>
+
+/**
+ * @brief Número de sectores en que se cuantiza la dirección del gradiente
+ */
+enum class DirectionBins {
+    NONE = 0,       // Sin imagen de direcciones
+    FOUR = 4,       // Orientación módulo 180°: 0°, 45°, 90°, 135°
+    EIGHT = 8       // Dirección completa: 0°, 45°, ..., 315°
+};
+
+/**
+ * @brief Pendientes de los límites de sector: tan(22.5°) ≈ 408 / 985
+ *
+ * 408/985 es una convergente de √2 - 1; la siguiente fracción que se
+ * acerca más tiene denominador 1393, así que con |gx|, |gy| <= 1020
+ * (entrada de 8 bits) el sector coincide con el de atan2. Los productos
+ * caben en int32 y los coeficientes en int16 (madd en SIMD).
+ */
+constexpr int SOBEL_TAN22_NUM = 408;
+constexpr int SOBEL_TAN22_DEN = 985;
+
+/**
+ * @brief Sector de la dirección del gradiente sin atan2
+ *
+ * El ángulo es atan2(gy, gx) con y hacia abajo, y cada sector está
+ * centrado en un múltiplo de 45°:
+ *
+ * | Sector | FOUR            | EIGHT                  |
+ * |--------|-----------------|------------------------|
+ * | 0      | 0° / 180°       | 0° (gx > 0)            |
+ * | 1      | 45° / 225°      | 45° (gx > 0, gy > 0)   |
+ * | 2      | 90° / 270°      | 90° (gy > 0)           |
+ * | 3      | 135° / 315°     | 135° (gx < 0, gy > 0)  |
+ * | 4..7   | -               | 180°, 225°, 270°, 315° |
+ *
+ * Con FOUR el sector es el de EIGHT módulo 4. Un gradiente nulo va al
+ * sector 0.
+ */
+inline uchar sobelDirectionBin(int gx, int gy, DirectionBins bins) {
+    int ax = std::abs(gx);
+    int ay = std::abs(gy);
+
+    int sector;
+    bool negative;
+    if (ay * SOBEL_TAN22_DEN <= ax * SOBEL_TAN22_NUM) {
+        sector = 0;                                 // |θ| <= 22.5° (o gradiente nulo)
+        negative = gx < 0;
+    } else if (ay * SOBEL_TAN22_NUM >= ax * SOBEL_TAN22_DEN) {
+        sector = 2;                                 // |θ| >= 67.5°
+        negative = gy < 0;
+    } else {
+        sector = ((gx ^ gy) >= 0) ? 1 : 3;          // Diagonales: mismo signo o signo opuesto
+        negative = gy < 0;
+    }
+
+    if (bins == DirectionBins::EIGHT && negative) {
+        sector += 4;
+    }
+    return static_cast<uchar>(sector);
+}
+
+/**
+ * @brief Convierte el número de sectores a string ("none", "4", "8")
+ */
+inline std::string directionBinsToString(DirectionBins bins) {
+    switch (bins) {
+        case DirectionBins::FOUR:  return "4";
+        case DirectionBins::EIGHT: return "8";
+        default:                   return "none";
+    }
+}
+
+#endif // SOBEL_DIRECTION_H
@@ -9,8 +9,15 @@
 #include <stdexcept>
 #include <optional>
 #include <array>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <utility>
 #include <type_traits>
 #include <string>
+#include "sobel_magnitude.h"
+#include "sobel_direction.h"
+#include "sobel_filter_hdr.h"
 
 /**
  * @brief Excepción personalizada para errores del filtro Sobel
@@ -39,6 +46,21 @@ struct FilterConfig {
     bool useGaussianBlur = false;
     double gaussianSigma = 1.0;
     
+    // Pipeline fusionado: gris + blur + Sobel + umbral en una sola pasada
+    // con ventana de filas, sin imágenes intermedias completas
+    bool fusedPipeline = false;
+    
+    // Cálculo de la magnitud: exacta (tabla de raíces) o aproximaciones L1/L∞
+    MagnitudeMode magnitudeMode = MagnitudeMode::EXACT;
+    
+    // Entradas CV_16UC1/CV_32FC1: salida de 16 bits o 8 bits normalizada, y
+    // valor del blanco del sensor (0 = rango completo: 65535 o 1.0)
+    HdrOutput hdrOutput = HdrOutput::NORMALIZED_8U;
+    double inputRange = 0.0;
+    
+    // Sectores de dirección que genera applyFilterWithDirection (NONE = desactivado)
+    DirectionBins directionBins = DirectionBins::NONE;
+    
     // Validación de configuración
     void validate() const;
 };
@@ -93,6 +115,28 @@ private:
                    const std::array<std::array<int, 3>, 3>& kernel) const;
     double calculateMagnitude(int gx, int gy) const;
     uchar normalizeValue(double value) const;
+    
+    /**
+     * @brief Pipeline fusionado de una sola pasada (config_.fusedPipeline)
+     *
+     * Lee la entrada una vez y genera las filas grises (y suavizadas si
+     * useGaussianBlur está activo) sobre la marcha en ventanas de pocas
+     * filas. Escribe la magnitud y/o la imagen binaria en el mismo
+     * recorrido; cualquiera de las dos salidas puede ser nullptr.
+     *
+     * Sin blur la salida es idéntica a la ruta clásica. Con blur se usa
+     * un kernel gaussiano en punto fijo, por lo que el gris suavizado
+     * puede diferir en ±1 respecto a cv::GaussianBlur.
+     */
+    void applyFused(const cv::Mat& input, cv::Mat* magnitude, cv::Mat* binary, int threshold) const;
+    
+    /**
+     * @brief Ruta nativa para CV_16UC1 y CV_32FC1 (SobelFilterHDR)
+     *
+     * El blur, si está activo, se aplica en la profundidad original. El
+     * umbral se interpreta en unidades de la salida (ver FilterConfig::hdrOutput).
+     */
+    cv::Mat applyHighDynamicRange(const cv::Mat& input, bool binary, int threshold) const;
 
 public:
     /**
@@ -131,6 +175,34 @@ public:
      */
     std::optional<cv::Mat> applyFilterWithThreshold(const cv::Mat& input, int threshold = -1) const;
     
+    /**
+     * @brief Binariza una magnitud que ya devolvió applyFilter
+     * 
+     * Da la misma máscara que applyFilterWithThreshold sobre la imagen de
+     * entrada sin volver a convolucionar (también con salidas HDR de 16
+     * bits o float, con el umbral en sus unidades).
+     * 
+     * @param magnitude Resultado de applyFilter
+     * @param threshold Umbral (usa el configurado si es -1)
+     * @return Imagen binaria CV_8UC1 o std::nullopt si hay error
+     */
+    std::optional<cv::Mat> applyThreshold(const cv::Mat& magnitude, int threshold = -1) const;
+    
+    /**
+     * @brief Aplica el filtro Sobel y genera la dirección cuantizada en el mismo recorrido
+     * 
+     * direction recibe, por píxel, el sector de config.directionBins (0-3
+     * u 0-7, ver sobelDirectionBin) obtenido comparando gx y gy con
+     * enteros, sin atan2. Con normalize activo se usa el kernel SIMD; la
+     * magnitud devuelta es la misma que la de applyFilter (sin el pipeline
+     * fusionado: el blur, si está activo, es cv::GaussianBlur).
+     * 
+     * @param input Imagen de entrada de 8 bits (CV_8UC1 o CV_8UC3)
+     * @param direction Imagen CV_8UC1 de sectores, reutilizada si ya tiene el tamaño
+     * @return Magnitud o std::nullopt si hay error (o directionBins es NONE)
+     */
+    std::optional<cv::Mat> applyFilterWithDirection(const cv::Mat& input, cv::Mat& direction) const;
+    
     // Getters y setters para configuración
     void setThreshold(int threshold);
     int getThreshold() const;
@@ -140,6 +212,16 @@ public:
     bool getUseGaussianBlur() const;
     void setGaussianSigma(double sigma);
     double getGaussianSigma() const;
+    void setDirectionBins(DirectionBins bins);
+    DirectionBins getDirectionBins() const;
+    void setFusedPipeline(bool fused);
+    bool getFusedPipeline() const;
+    void setMagnitudeMode(MagnitudeMode mode);
+    MagnitudeMode getMagnitudeMode() const;
+    void setHdrOutput(HdrOutput output);
+    HdrOutput getHdrOutput() const;
+    void setInputRange(double range);
+    double getInputRange() const;
     
     /**
      * @brief Obtiene información sobre el filtro
@@ -148,62 +230,170 @@ public:
     std::string getInfo() const;
 };
 
+/**
+ * @brief Política de borde: el marco de KernelSize/2 píxeles no se calcula y queda a 0
+ *
+ * Es el comportamiento del resto de filtros del proyecto.
+ */
+struct BorderSkip {
+    static constexpr bool COMPUTES_BORDER = false;
+    static constexpr const char* NAME = "skip";
+    static int index(int i, int) { return i; }
+};
+
+/**
+ * @brief Política de borde: se repite el píxel del borde (aaa|abcd|ddd)
+ */
+struct BorderReplicate {
+    static constexpr bool COMPUTES_BORDER = true;
+    static constexpr const char* NAME = "replicate";
+    static int index(int i, int n) { return std::min(std::max(i, 0), n - 1); }
+};
+
+/**
+ * @brief Política de borde: reflejo sin repetir el borde (cb|abcd|cb), como BORDER_REFLECT_101
+ */
+struct BorderReflect101 {
+    static constexpr bool COMPUTES_BORDER = true;
+    static constexpr const char* NAME = "reflect101";
+    static int index(int i, int n) {
+        if (n == 1) {
+            return 0;
+        }
+        while (i < 0 || i >= n) {
+            i = (i < 0) ? -i : 2 * n - 2 - i;
+        }
+        return i;
+    }
+};
+
+/**
+ * @brief Pesos de Sobel KxK generados en tiempo de compilación
+ *
+ * Cada kernel es el producto exterior de un suavizado binomial
+ * (fila K-1 del triángulo de Pascal) y una derivada (diferencia de la
+ * fila K-2). Para K = 3 se obtienen exactamente SOBEL_X y SOBEL_Y.
+ */
+template<int K>
+struct SobelKernel {
+    static constexpr int binomial(int n, int k) {
+        if (k < 0 || k > n) {
+            return 0;
+        }
+        int result = 1;
+        for (int i = 1; i <= k; i++) {
+            result = result * (n - k + i) / i;
+        }
+        return result;
+    }
+    
+    static constexpr int smooth(int i) { return binomial(K - 1, i); }
+    static constexpr int derivative(int i) { return binomial(K - 2, i - 1) - binomial(K - 2, i); }
+    
+    // Gx: suavizado vertical x derivada horizontal; Gy: al revés
+    static constexpr int x(int row, int col) { return smooth(row) * derivative(col); }
+    static constexpr int y(int row, int col) { return derivative(row) * smooth(col); }
+};
+
+/**
+ * @brief Tipos de píxel admitidos por SobelFilterTemplate
+ *
+ * Los enteros acumulan en 32 bits (suficiente hasta 7x7 con 16 bits
+ * por píxel) y float en float.
+ */
+template<typename T>
+struct SobelPixelTraits {
+    static constexpr bool SUPPORTED = false;
+};
+
+template<>
+struct SobelPixelTraits<uint8_t> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr int DEPTH = CV_8U;
+    static constexpr const char* NAME = "uint8_t";
+    using Accumulator = int32_t;
+};
+
+template<>
+struct SobelPixelTraits<uint16_t> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr int DEPTH = CV_16U;
+    static constexpr const char* NAME = "uint16_t";
+    using Accumulator = int32_t;
+};
+
+template<>
+struct SobelPixelTraits<float> {
+    static constexpr bool SUPPORTED = true;
+    static constexpr int DEPTH = CV_32F;
+    static constexpr const char* NAME = "float";
+    using Accumulator = float;
+};
+
 /**
  * @brief Filtro de detección de bordes usando el operador de Sobel con templates
  * 
- * Esta clase implementa el algoritmo de Sobel para detectar bordes
- * en imágenes usando templates para mayor flexibilidad en tipos de datos.
+ * Todo lo que en SobelFilter se decide en tiempo de ejecución se fija
+ * aquí en tiempo de compilación: los pesos del kernel (SobelKernel), el
+ * tipo de píxel y la política de borde. El bucle interno se despliega
+ * por completo con una fold expression y los pesos nulos desaparecen
+ * (el kernel 3x3 queda en 6 lecturas por gradiente sin multiplicar por 0).
  * 
- * @tparam T Tipo de datos para los cálculos (uint8_t, float, double)
- * @tparam KernelSize Tamaño del kernel (3 para Sobel estándar)
+ * @tparam T Tipo de píxel de entrada y de la magnitud (uint8_t, uint16_t, float)
+ * @tparam KernelSize Tamaño del kernel (3, 5 o 7)
+ * @tparam Border Política de borde (BorderSkip, BorderReplicate, BorderReflect101)
  * 
- * Características:
- * - Implementación manual del algoritmo (no usa OpenCV para el filtro)
- * - Soporte para diferentes tipos de datos mediante templates
- * - Configuración flexible
- * - Manejo robusto de errores
- * - Optimizaciones de rendimiento
+ * La entrada debe tener la profundidad de T (1 canal, o 3 canales BGR
+ * que se convierten a gris). La magnitud se devuelve en el mismo tipo,
+ * saturada en los tipos enteros; la salida con umbral es CV_8UC1 (0/255).
+ * Con uint8_t, 3x3 y BorderSkip la salida es idéntica a SobelFilter.
  * 
  * @example
- * SobelFilterTemplate<uint8_t> filter;  // Para imágenes 8-bit
- * SobelFilterTemplate<float> filter;    // Para cálculos de precisión
+ * SobelFilterTemplate<uint8_t> filter;                       // 8 bits, 3x3
+ * SobelFilterTemplate<uint16_t, 5> deep;                     // 16 bits, 5x5
+ * SobelFilterTemplate<float, 3, BorderReflect101> precise;   // float con reflejo
  * 
  * @see https://en.wikipedia.org/wiki/Sobel_operator
  */
-template<typename T = uint8_t, int KernelSize = 3>
+template<typename T = uint8_t, int KernelSize = 3, typename Border = BorderSkip>
 class SobelFilterTemplate {
     static_assert(std::is_arithmetic_v<T>, "T must be arithmetic type");
-    static_assert(KernelSize > 0 && KernelSize % 2 == 1, "KernelSize must be positive odd number");
+    static_assert(SobelPixelTraits<T>::SUPPORTED, "T must be uint8_t, uint16_t or float");
+    static_assert(KernelSize >= 3 && KernelSize <= 7 && KernelSize % 2 == 1,
+                  "KernelSize must be 3, 5 or 7");
     
 private:
-    // Kernels del filtro Sobel como constantes en tiempo de compilación
-    static constexpr std::array<std::array<int, 3>, 3> SOBEL_X = {{
-        {{-1, 0, 1}},
-        {{-2, 0, 2}},
-        {{-1, 0, 1}}
-    }};
-    
-    static constexpr std::array<std::array<int, 3>, 3> SOBEL_Y = {{
-        {{-1, -2, -1}},
-        {{ 0,  0,  0}},
-        {{ 1,  2,  1}}
-    }};
+    using Kernel = SobelKernel<KernelSize>;
+    using Accumulator = typename SobelPixelTraits<T>::Accumulator;
     
     static constexpr int KERNEL_OFFSET = KernelSize / 2;
+    static constexpr int INPUT_DEPTH = SobelPixelTraits<T>::DEPTH;
     static constexpr T MAX_VALUE = std::numeric_limits<T>::max();
-    static constexpr T MIN_VALUE = std::numeric_limits<T>::min();
     
     FilterConfig config_;
-    std::unique_ptr<cv::Mat> cached_result_;
     
     // Métodos privados
     void validateInput(const cv::Mat& input) const;
     cv::Mat convertToGrayscale(const cv::Mat& input) const;
-    T applyKernel(const cv::Mat& image, int row, int col, 
-                 const std::array<std::array<int, 3>, 3>& kernel) const;
-    double calculateMagnitude(T gx, T gy) const;
-    T normalizeValue(double value) const;
-    uchar convertToOutputType(T value) const;
+    
+    // Suma desplegada de los KernelSize² productos (MAPPED: columnas remapeadas por el borde)
+    template<bool MAPPED, size_t... Taps>
+    static void accumulate(const T* const* rows, int col, const int* mappedCols,
+                           Accumulator& gx, Accumulator& gy, std::index_sequence<Taps...>);
+    template<bool MAPPED, int Row, int Col>
+    static void accumulateTap(const T* const* rows, int col, const int* mappedCols,
+                              Accumulator& gx, Accumulator& gy);
+    
+    template<MagnitudeMode M>
+    static T calculateMagnitude(Accumulator gx, Accumulator gy);
+    
+    // Recorrido común: magnitud en T o, si BINARY, máscara 0/255
+    template<bool BINARY, MagnitudeMode M>
+    static void process(const cv::Mat& gray, cv::Mat& output, double threshold);
+    
+    // Elige la instancia de process según config_.magnitudeMode
+    template<bool BINARY>
+    void processFor(const cv::Mat& gray, cv::Mat& output, double threshold) const;
 
 public:
     /**
@@ -229,19 +419,27 @@ public:
     
     /**
      * @brief Aplica el filtro Sobel a una imagen
-     * @param input Imagen de entrada
-     * @return Imagen procesada o std::nullopt si hay error
+     * @param input Imagen de entrada (profundidad de T, 1 o 3 canales)
+     * @return Magnitud en el tipo de T o std::nullopt si hay error
      */
     std::optional<cv::Mat> applyFilter(const cv::Mat& input) const;
     
     /**
      * @brief Aplica el filtro Sobel con umbral
      * @param input Imagen de entrada
-     * @param threshold Umbral (usa el configurado si es -1)
-     * @return Imagen procesada con umbral o std::nullopt si hay error
+     * @param threshold Umbral en unidades de T (usa el configurado si es -1)
+     * @return Imagen binaria CV_8UC1 o std::nullopt si hay error
      */
     std::optional<cv::Mat> applyFilterWithThreshold(const cv::Mat& input, int threshold = -1) const;
     
+    /**
+     * @brief Umbral sobre una magnitud ya calculada con applyFilter
+     * @param magnitude Resultado de applyFilter (tipo de T)
+     * @param threshold Umbral en unidades de T (usa el configurado si es -1)
+     * @return Imagen binaria CV_8UC1, igual a la de applyFilterWithThreshold
+     */
+    std::optional<cv::Mat> applyThreshold(const cv::Mat& magnitude, int threshold = -1) const;
+    
     // Getters y setters para configuración
     void setThreshold(int threshold);
     int getThreshold() const;
@@ -251,6 +449,8 @@ public:
     bool getUseGaussianBlur() const;
     void setGaussianSigma(double sigma);
     double getGaussianSigma() const;
+    void setMagnitudeMode(MagnitudeMode mode);
+    MagnitudeMode getMagnitudeMode() const;
     
     /**
      * @brief Obtiene información sobre el filtro
@@ -263,9 +463,14 @@ public:
      * @return String con el nombre del tipo
      */
     static std::string getTypeName();
+    
+    /**
+     * @brief Nombre de la instancia, p. ej. "uint8_t 3x3 skip"
+     */
+    static std::string getVariantName();
 };
 
-// Incluir implementaciones de templates (comentado por ahora)
-// #include "sobel_filter.hpp"
+// Implementaciones de los templates
+#include "sobel_filter.hpp"
 
 #endif // SOBEL_FILTER_H 
\ No newline at end of file
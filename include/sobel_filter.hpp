@@ -0,0 +1,332 @@
+// =============================================================
+//  SOBEL_FILTER.HPP
+//  -----------------------------------------------------------
+//  Implementación de SobelFilterTemplate. Se incluye al final de
+//  sobel_filter.h: kernel, tipo de píxel y política de borde son
+//  parámetros de plantilla, así que el compilador ve los pesos
+//  como constantes y despliega el bucle interno por completo.
+// =============================================================
+
+#ifndef SOBEL_FILTER_HPP
+#define SOBEL_FILTER_HPP
+
+#include "sobel_filter.h"
+
+// Sin forzarlo GCC deja fuera de línea la suma de 5x5 y 7x7 (gx y gy pasan por memoria)
+#if defined(__GNUC__)
+#define SOBEL_FORCE_INLINE inline __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define SOBEL_FORCE_INLINE __forceinline
+#else
+#define SOBEL_FORCE_INLINE inline
+#endif
+
+template<typename T, int KernelSize, typename Border>
+SobelFilterTemplate<T, KernelSize, Border>::SobelFilterTemplate(const FilterConfig& config)
+    : config_(config) {
+    config_.validate();
+}
+
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::validateInput(const cv::Mat& input) const {
+    if (input.empty()) {
+        throw InvalidImageException("Input image is empty");
+    }
+    if (input.dims != 2) {
+        throw InvalidImageException("Input image must be 2D");
+    }
+    if (input.depth() != INPUT_DEPTH || (input.channels() != 1 && input.channels() != 3)) {
+        throw InvalidImageException("Input image must be " + getTypeName() + " grayscale or BGR");
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+cv::Mat SobelFilterTemplate<T, KernelSize, Border>::convertToGrayscale(const cv::Mat& input) const {
+    cv::Mat grayImage;
+    if (input.channels() == 3) {
+        cv::cvtColor(input, grayImage, cv::COLOR_BGR2GRAY);
+    } else {
+        grayImage = input;
+    }
+    if (config_.useGaussianBlur) {
+        // No in situ: grayImage puede ser la entrada del llamador
+        cv::Mat blurredImage;
+        cv::GaussianBlur(grayImage, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+        grayImage = blurredImage;
+    }
+    return grayImage;
+}
+
+template<typename T, int KernelSize, typename Border>
+template<bool MAPPED, int Row, int Col>
+SOBEL_FORCE_INLINE void SobelFilterTemplate<T, KernelSize, Border>::accumulateTap(
+    const T* const* rows, int col, const int* mappedCols, Accumulator& gx, Accumulator& gy) {
+    constexpr int WX = Kernel::x(Row, Col);
+    constexpr int WY = Kernel::y(Row, Col);
+
+    // Los pesos nulos (columna central de Gx, fila central de Gy) no generan código
+    if constexpr (WX != 0 || WY != 0) {
+        const int c = MAPPED ? mappedCols[Col] : col + Col - KERNEL_OFFSET;
+        const Accumulator pixel = static_cast<Accumulator>(rows[Row][c]);
+        if constexpr (WX != 0) {
+            gx += static_cast<Accumulator>(WX) * pixel;
+        }
+        if constexpr (WY != 0) {
+            gy += static_cast<Accumulator>(WY) * pixel;
+        }
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+template<bool MAPPED, size_t... Taps>
+SOBEL_FORCE_INLINE void SobelFilterTemplate<T, KernelSize, Border>::accumulate(
+    const T* const* rows, int col, const int* mappedCols, Accumulator& gx, Accumulator& gy,
+    std::index_sequence<Taps...>) {
+    (accumulateTap<MAPPED, static_cast<int>(Taps) / KernelSize, static_cast<int>(Taps) % KernelSize>(
+         rows, col, mappedCols, gx, gy), ...);
+}
+
+template<typename T, int KernelSize, typename Border>
+template<MagnitudeMode M>
+SOBEL_FORCE_INLINE T SobelFilterTemplate<T, KernelSize, Border>::calculateMagnitude(Accumulator gx, Accumulator gy) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if constexpr (M == MagnitudeMode::L1) {
+            return std::abs(gx) + std::abs(gy);
+        } else if constexpr (M == MagnitudeMode::LINF) {
+            return std::max(std::abs(gx), std::abs(gy));
+        } else {
+            return std::sqrt(gx * gx + gy * gy);
+        }
+    } else if constexpr (std::is_same_v<T, uint8_t>) {
+        if constexpr (M == MagnitudeMode::L1) {
+            return static_cast<T>(std::min(255, std::abs(gx) + std::abs(gy)));
+        } else if constexpr (M == MagnitudeMode::LINF) {
+            return static_cast<T>(std::min(255, std::max(std::abs(gx), std::abs(gy))));
+        } else {
+            // Cualquier suma >= 65536 satura a 255: basta la tabla de raíces de 16 bits.
+            // Hasta 5x5 (|g| <= 96 * 255) la suma de cuadrados cabe en 32 bits.
+            using Square = std::conditional_t<KernelSize <= 5, int32_t, int64_t>;
+            Square sq = static_cast<Square>(gx) * gx + static_cast<Square>(gy) * gy;
+            return SOBEL_SQRT_LUT[static_cast<size_t>(std::min<Square>(sq, 65535))];
+        }
+    } else {
+        // gx² + gy² no cabe en 32 bits: raíz en double, truncada y saturada
+        double magnitude;
+        if constexpr (M == MagnitudeMode::L1) {
+            magnitude = std::abs(static_cast<double>(gx)) + std::abs(static_cast<double>(gy));
+        } else if constexpr (M == MagnitudeMode::LINF) {
+            magnitude = std::max(std::abs(static_cast<double>(gx)), std::abs(static_cast<double>(gy)));
+        } else {
+            magnitude = std::sqrt(static_cast<double>(gx) * gx + static_cast<double>(gy) * gy);
+        }
+        return static_cast<T>(std::min(magnitude, static_cast<double>(MAX_VALUE)));
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+template<bool BINARY, MagnitudeMode M>
+void SobelFilterTemplate<T, KernelSize, Border>::process(const cv::Mat& gray, cv::Mat& output,
+                                                         double threshold) {
+    using OutputType = std::conditional_t<BINARY, uchar, T>;
+    constexpr auto TAPS = std::make_index_sequence<KernelSize * KernelSize>{};
+
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    output = cv::Mat::zeros(rows, cols, BINARY ? CV_8UC1 : CV_MAKETYPE(INPUT_DEPTH, 1));
+
+    // Con BorderSkip solo se calcula el interior y el marco queda a 0
+    const int firstRow = Border::COMPUTES_BORDER ? 0 : KERNEL_OFFSET;
+    const int endRow = Border::COMPUTES_BORDER ? rows : rows - KERNEL_OFFSET;
+    const int endCol = Border::COMPUTES_BORDER ? cols : cols - KERNEL_OFFSET;
+
+    // Columnas donde el kernel se sale de la imagen: [0, leftEnd) y [rightBegin, endCol)
+    const int leftEnd = Border::COMPUTES_BORDER ? std::min(KERNEL_OFFSET, cols) : KERNEL_OFFSET;
+    const int rightBegin = std::max(cols - KERNEL_OFFSET, leftEnd);
+
+    const T* rowPtrs[KernelSize];
+    int mappedCols[KernelSize];
+
+    for (int i = firstRow; i < endRow; i++) {
+        for (int r = 0; r < KernelSize; r++) {
+            rowPtrs[r] = gray.ptr<T>(Border::index(i + r - KERNEL_OFFSET, rows));
+        }
+        OutputType* dst = output.ptr<OutputType>(i);
+
+        auto store = [&](int j, Accumulator gx, Accumulator gy) {
+            T magnitude = calculateMagnitude<M>(gx, gy);
+            if constexpr (BINARY) {
+                dst[j] = (magnitude > threshold) ? 255 : 0;
+            } else {
+                dst[j] = magnitude;
+            }
+        };
+
+        auto mappedPixel = [&](int j) {
+            for (int c = 0; c < KernelSize; c++) {
+                mappedCols[c] = Border::index(j + c - KERNEL_OFFSET, cols);
+            }
+            Accumulator gx = 0, gy = 0;
+            accumulate<true>(rowPtrs, j, mappedCols, gx, gy, TAPS);
+            store(j, gx, gy);
+        };
+
+        if constexpr (Border::COMPUTES_BORDER) {
+            for (int j = 0; j < leftEnd; j++) {
+                mappedPixel(j);
+            }
+        }
+
+        // Interior: índices directos, sin remapear
+        for (int j = KERNEL_OFFSET; j < cols - KERNEL_OFFSET; j++) {
+            Accumulator gx = 0, gy = 0;
+            accumulate<false>(rowPtrs, j, nullptr, gx, gy, TAPS);
+            store(j, gx, gy);
+        }
+
+        if constexpr (Border::COMPUTES_BORDER) {
+            for (int j = rightBegin; j < endCol; j++) {
+                mappedPixel(j);
+            }
+        }
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+template<bool BINARY>
+void SobelFilterTemplate<T, KernelSize, Border>::processFor(const cv::Mat& gray, cv::Mat& output,
+                                                            double threshold) const {
+    // El modo de magnitud se resuelve una vez por imagen, no por píxel
+    switch (config_.magnitudeMode) {
+        case MagnitudeMode::L1:
+            process<BINARY, MagnitudeMode::L1>(gray, output, threshold);
+            break;
+        case MagnitudeMode::LINF:
+            process<BINARY, MagnitudeMode::LINF>(gray, output, threshold);
+            break;
+        default:
+            process<BINARY, MagnitudeMode::EXACT>(gray, output, threshold);
+            break;
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+std::optional<cv::Mat> SobelFilterTemplate<T, KernelSize, Border>::applyFilter(const cv::Mat& input) const {
+    try {
+        validateInput(input);
+
+        cv::Mat outputImage;
+        processFor<false>(convertToGrayscale(input), outputImage, 0.0);
+        return outputImage;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error applying Sobel filter: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+std::optional<cv::Mat> SobelFilterTemplate<T, KernelSize, Border>::applyFilterWithThreshold(
+    const cv::Mat& input, int threshold) const {
+    try {
+        // Usar umbral configurado si no se especifica uno
+        int actualThreshold = (threshold >= 0) ? threshold : config_.threshold;
+
+        // El umbral está en unidades de T (0-65535 con uint16_t)
+        if (actualThreshold < 0 || (std::is_integral_v<T> && actualThreshold > static_cast<int>(MAX_VALUE))) {
+            throw SobelFilterException("Threshold out of range for " + getTypeName());
+        }
+
+        validateInput(input);
+
+        // Máscara directa en el mismo recorrido, sin imagen de magnitud intermedia
+        cv::Mat thresholdedImage;
+        processFor<true>(convertToGrayscale(input), thresholdedImage, actualThreshold);
+        return thresholdedImage;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error applying Sobel filter with threshold: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+template<typename T, int KernelSize, typename Border>
+std::optional<cv::Mat> SobelFilterTemplate<T, KernelSize, Border>::applyThreshold(
+    const cv::Mat& magnitude, int threshold) const {
+    try {
+        int actualThreshold = (threshold >= 0) ? threshold : config_.threshold;
+
+        if (actualThreshold < 0 || (std::is_integral_v<T> && actualThreshold > static_cast<int>(MAX_VALUE))) {
+            throw SobelFilterException("Threshold out of range for " + getTypeName());
+        }
+        if (magnitude.type() != CV_MAKETYPE(INPUT_DEPTH, 1)) {
+            throw InvalidImageException("Magnitude type does not match " + getTypeName());
+        }
+
+        // El marco sin calcular vale 0 y el umbral no es negativo: queda a 0 como en processFor
+        cv::Mat thresholdedImage;
+        sobelThresholdMagnitude(magnitude, thresholdedImage, actualThreshold);
+        return thresholdedImage;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error applying threshold: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+// Getters y setters
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::setThreshold(int threshold) {
+    config_.threshold = threshold;
+    config_.validate();
+}
+
+template<typename T, int KernelSize, typename Border>
+int SobelFilterTemplate<T, KernelSize, Border>::getThreshold() const { return config_.threshold; }
+
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::setNormalize(bool normalize) { config_.normalize = normalize; }
+
+template<typename T, int KernelSize, typename Border>
+bool SobelFilterTemplate<T, KernelSize, Border>::getNormalize() const { return config_.normalize; }
+
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::setUseGaussianBlur(bool useBlur) { config_.useGaussianBlur = useBlur; }
+
+template<typename T, int KernelSize, typename Border>
+bool SobelFilterTemplate<T, KernelSize, Border>::getUseGaussianBlur() const { return config_.useGaussianBlur; }
+
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::setGaussianSigma(double sigma) {
+    config_.gaussianSigma = sigma;
+    config_.validate();
+}
+
+template<typename T, int KernelSize, typename Border>
+double SobelFilterTemplate<T, KernelSize, Border>::getGaussianSigma() const { return config_.gaussianSigma; }
+
+template<typename T, int KernelSize, typename Border>
+void SobelFilterTemplate<T, KernelSize, Border>::setMagnitudeMode(MagnitudeMode mode) { config_.magnitudeMode = mode; }
+
+template<typename T, int KernelSize, typename Border>
+MagnitudeMode SobelFilterTemplate<T, KernelSize, Border>::getMagnitudeMode() const { return config_.magnitudeMode; }
+
+template<typename T, int KernelSize, typename Border>
+std::string SobelFilterTemplate<T, KernelSize, Border>::getInfo() const {
+    return "SobelFilterTemplate<" + getVariantName() + ">[threshold=" + std::to_string(config_.threshold) +
+           ", gaussianBlur=" + std::to_string(config_.useGaussianBlur) +
+           ", sigma=" + std::to_string(config_.gaussianSigma) +
+           ", magnitude=" + magnitudeModeToString(config_.magnitudeMode) + "]";
+}
+
+template<typename T, int KernelSize, typename Border>
+std::string SobelFilterTemplate<T, KernelSize, Border>::getTypeName() {
+    return SobelPixelTraits<T>::NAME;
+}
+
+template<typename T, int KernelSize, typename Border>
+std::string SobelFilterTemplate<T, KernelSize, Border>::getVariantName() {
+    return getTypeName() + " " + std::to_string(KernelSize) + "x" + std::to_string(KernelSize) +
+           " " + Border::NAME;
+}
+
+#endif // SOBEL_FILTER_HPP
@@ -0,0 +1,152 @@
+#ifndef SOBEL_FILTER_HDR_H
+#define SOBEL_FILTER_HDR_H
+
+#include <opencv2/opencv.hpp>
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+
+/**
+ * @brief Formato de salida para entradas de 16 bits o float
+ */
+enum class HdrOutput {
+    MAGNITUDE_16U,  // CV_16UC1 saturada a 65535 (en unidades del sensor si la entrada es 16U)
+    NORMALIZED_8U   // CV_8UC1: magnitud * 255 / rango de entrada, saturada a 255
+};
+
+/**
+ * @brief Convierte un formato de salida a string ("16u", "8u")
+ */
+inline const char* hdrOutputToString(HdrOutput output) {
+    return output == HdrOutput::MAGNITUDE_16U ? "16u" : "8u";
+}
+
+/**
+ * @brief Filtro Sobel nativo para sensores de alto rango (CV_16UC1 y CV_32FC1)
+ *
+ * Lee la imagen de 16 bits o float directamente, sin convertirla antes a
+ * 8 bits, y escribe la salida elegida en la misma pasada:
+ *
+ * - CV_16UC1: gradientes en int32 (|G| <= 4 * 65535 cabe de sobra). En
+ *   modo EXACT gx² + gy² (hasta 2^37) se suma en double, donde es exacto,
+ *   y la raíz truncada coincide con floor(sqrt(n)).
+ * - CV_32FC1: gradientes y magnitud en float.
+ *
+ * La salida se obtiene multiplicando la magnitud por una escala fija:
+ *
+ * | Entrada | MAGNITUDE_16U          | NORMALIZED_8U    |
+ * |---------|------------------------|------------------|
+ * | 16U     | magnitud (escala 1)    | 255 / rango      |
+ * | 32F     | 65535 / rango          | 255 / rango      |
+ *
+ * El rango es 65535 para 16U y 1.0 para float salvo que se indique otro
+ * con setInputRange() (p. ej. 4095 para una cámara de 12 bits). Al ser
+ * una escala fija no hace falta una pasada previa para buscar el máximo.
+ *
+ * Cada variante (SSE4.1, AVX2, AVX-512) procesa 4/8/16 píxeles por
+ * iteración en carriles de 32 bits; la versión escalar da el mismo
+ * resultado para 16U (en float puede variar en el último bit si el
+ * compilador fusiona multiplicaciones y sumas).
+ *
+ * @example
+ * SobelFilterHDR filter;
+ * filter.setInputRange(4095);  // cámara de 12 bits
+ * cv::Mat edges = filter.applySobel(raw16);
+ */
+class SobelFilterHDR {
+private:
+    SimdLevel level_;
+    MagnitudeMode mode_;
+    HdrOutput output_;
+    double inputRange_ = 0.0;
+
+    // Recorrido común: salida escalada o, si binary, máscara 0/255 contra threshold
+    void process(const cv::Mat& inputImage, cv::Mat& outputImage, int rowBegin, int rowEnd,
+                 bool binary, int threshold) const;
+
+public:
+    /**
+     * @brief Constructor
+     * @param level Variante del kernel (por defecto la mejor soportada por la CPU)
+     * @param mode Cálculo de la magnitud (exacta por defecto)
+     * @param output Formato de salida (8 bits normalizado por defecto)
+     */
+    explicit SobelFilterHDR(SimdLevel level = SobelFilterSIMD::detectBestLevel(),
+                            MagnitudeMode mode = MagnitudeMode::EXACT,
+                            HdrOutput output = HdrOutput::NORMALIZED_8U);
+
+    /**
+     * @brief Aplica el filtro Sobel a una imagen de 16 bits o float
+     * @param inputImage Imagen de entrada (CV_16UC1 o CV_32FC1)
+     * @return Magnitud en CV_16UC1 o CV_8UC1 según getOutput()
+     */
+    cv::Mat applySobel(const cv::Mat& inputImage) const;
+
+    /**
+     * @brief Aplica el filtro Sobel con umbral
+     *
+     * El umbral se compara con el valor de salida (0-255 con NORMALIZED_8U,
+     * 0-65535 con MAGNITUDE_16U): un píxel es borde si supera el umbral.
+     *
+     * @return Imagen binaria (0/255) en CV_8UC1
+     */
+    cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold) const;
+
+    /**
+     * @brief Igual que applySobel pero reutilizando la salida del llamador
+     *
+     * outputImage solo se reserva si no tiene ya el tamaño y tipo de la
+     * salida. No puede compartir datos con la entrada.
+     */
+    void applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage) const;
+
+    /**
+     * @brief Igual que applySobelWithThreshold pero reutilizando la salida del llamador
+     */
+    void applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage, int threshold) const;
+
+    /**
+     * @brief Procesa las filas interiores de [rowBegin, rowEnd)
+     *
+     * outputImage debe estar ya reservada con el tamaño de la entrada y el
+     * tipo de outputType(); permite repartir bandas entre hilos.
+     */
+    void applyRows(const cv::Mat& inputImage, cv::Mat& outputImage, int rowBegin, int rowEnd) const;
+
+    /**
+     * @brief Tipo OpenCV de la salida (CV_16UC1 o CV_8UC1)
+     */
+    int outputType() const;
+
+    /**
+     * @brief Valor máximo de la salida (65535 o 255)
+     */
+    int outputMax() const;
+
+    /**
+     * @brief Escala aplicada a la magnitud para una entrada de la profundidad dada
+     */
+    double scaleFor(int depth) const;
+
+    // Getters y setters
+    SimdLevel getLevel() const { return level_; }
+    void setMagnitudeMode(MagnitudeMode mode) { mode_ = mode; }
+    MagnitudeMode getMagnitudeMode() const { return mode_; }
+    void setOutput(HdrOutput output) { output_ = output; }
+    HdrOutput getOutput() const { return output_; }
+
+    /**
+     * @brief Fija el valor que corresponde al blanco del sensor
+     * @param range Máximo de la entrada (0 = rango completo del tipo)
+     */
+    void setInputRange(double range);
+    double getInputRange() const { return inputRange_; }
+
+    /**
+     * @brief Indica si el tipo de imagen lo procesa este filtro (CV_16UC1, CV_32FC1)
+     */
+    static bool isSupportedType(int type) {
+        return type == CV_16UC1 || type == CV_32FC1;
+    }
+};
+
+#endif // SOBEL_FILTER_HDR_H
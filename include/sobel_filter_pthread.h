@@ -0,0 +1,127 @@
+#ifndef SOBEL_FILTER_PTHREAD_H
+#define SOBEL_FILTER_PTHREAD_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+#include "pthread_pool.h"
+#include "sobel_magnitude.h"
+
+/**
+ * @brief Filtro Sobel paralelizado manualmente con pThreads
+ *
+ * Divide la imagen en bandas de filas y las procesa en un pool de
+ * hilos persistente propiedad del filtro. Los hilos se crean una sola
+ * vez y se reutilizan entre frames y entre las pasadas Sobel y umbral.
+ * Cada hilo recibe varias bandas finas y, al terminar las suyas, roba
+ * las pendientes de otros (WorkStealingScheduler), así que un núcleo
+ * compartido con otro proceso no retrasa el frame completo.
+ *
+ * @example
+ * SobelFilterPThread filter(8);
+ * cv::Mat edges = filter.applySobel(input_image);
+ */
+class SobelFilterPThread {
+private:
+    // Kernels del filtro Sobel
+    const std::vector<std::vector<int>> sobelX = {
+        {-1, 0, 1},
+        {-2, 0, 2},
+        {-1, 0, 1}
+    };
+
+    const std::vector<std::vector<int>> sobelY = {
+        {-1, -2, -1},
+        { 0,  0,  0},
+        { 1,  2,  1}
+    };
+
+    // Hilos persistentes reutilizados en cada llamada
+    PThreadPool pool_;
+    
+    // Cálculo de la magnitud del gradiente
+    MagnitudeMode mode_ = MagnitudeMode::EXACT;
+    
+    // Bandas robadas entre hilos en la última llamada
+    int lastSteals_ = 0;
+
+    // Estructura para pasar datos a los hilos
+    struct ThreadData {
+        const cv::Mat* grayImage;   // Imagen gris compartida (solo lectura)
+        cv::Mat* outputImage;
+        int startRow;
+        int endRow;
+        int startCol;
+        int endCol;
+        const std::vector<std::vector<int>>* sobelX;
+        const std::vector<std::vector<int>>* sobelY;
+        MagnitudeMode mode;
+        bool binary;                // Escribir máscara 255/0 en vez de magnitud
+        int limit;                  // Límite de sobelEdgeLimit (solo si binary)
+    };
+
+    // Función que ejecuta cada hilo
+    static void* sobelThread(void* arg);
+
+    // Convierte a gris una vez y reparte las bandas en el pool
+    cv::Mat runBands(const cv::Mat& inputImage, bool binary, int threshold);
+
+public:
+    /**
+     * @brief Bandas por hilo (más bandas = más margen para repartir con robo)
+     */
+    static constexpr int BANDS_PER_THREAD = 8;
+
+    /**
+     * @brief Crea el filtro con su pool de hilos (se crean una sola vez)
+     * @param numThreads Número de hilos (si es <= 0 usa hardware_concurrency)
+     */
+    explicit SobelFilterPThread(int numThreads = 0);
+
+    /**
+     * @brief Número de hilos del pool
+     */
+    int getNumThreads() const { return pool_.size(); }
+    
+    /**
+     * @brief Bandas que se robaron entre hilos en la última llamada
+     */
+    int getLastSteals() const { return lastSteals_; }
+    
+    /**
+     * @brief Cambia/obtiene el cálculo de la magnitud
+     */
+    void setMagnitudeMode(MagnitudeMode mode) { mode_ = mode; }
+    MagnitudeMode getMagnitudeMode() const { return mode_; }
+
+    /**
+     * @brief Memoria por frame que ya no se reserva al compartir la imagen gris
+     *
+     * Antes cada hilo hacía su propio cvtColor/clone de la imagen completa.
+     */
+    size_t getMemorySavedPerFrame(const cv::Mat& inputImage) const;
+
+    /**
+     * @brief Aplica el filtro Sobel usando pThreads
+     */
+    cv::Mat applySobel(const cv::Mat& inputImage);
+
+    /**
+     * @brief Aplica el filtro Sobel con umbral usando pThreads
+     */
+    cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50);
+
+    /**
+     * @brief Máscara con umbral a partir de la salida de applySobel
+     *
+     * Mismo resultado que applySobelWithThreshold sobre la imagen original,
+     * para quien guarda las dos salidas y no quiere lanzar otra vez los hilos.
+     */
+    cv::Mat applyThreshold(const cv::Mat& magnitude, int threshold = 50) const;
+
+    /**
+     * @brief Versión secuencial para comparación
+     */
+    cv::Mat applySobelSequential(const cv::Mat& inputImage);
+};
+
+#endif // SOBEL_FILTER_PTHREAD_H
@@ -0,0 +1,232 @@
+#ifndef SOBEL_FILTER_SIMD_H
+#define SOBEL_FILTER_SIMD_H
+
+#include <opencv2/opencv.hpp>
+#include <string>
+#include "edge_bitmap.h"
+#include "sobel_magnitude.h"
+#include "sobel_gradients.h"
+#include "sobel_direction.h"
+
+/**
+ * @brief Variantes del kernel Sobel vectorizado
+ */
+enum class SimdLevel {
+    SCALAR,     // Sin vectorización (referencia y fallback portable)
+    SSE41,      // 128 bits: 16 píxeles por iteración
+    AVX2,       // 256 bits: 32 píxeles por iteración
+    AVX512      // 512 bits (AVX-512BW): 32 píxeles por registro
+};
+
+/**
+ * @brief Filtro Sobel vectorizado con SSE4.1/AVX2/AVX-512
+ *
+ * Calcula varios píxeles de salida por iteración usando carriles de
+ * 16 bits para los gradientes y una magnitud entera. La salida es
+ * idéntica bit a bit a la de SobelBasicStrategy:
+ *
+ * - Gx y Gy caben en int16 (|G| <= 4 * 255)
+ * - gx² + gy² se obtiene con una sola instrucción madd en int32
+ * - La raíz se calcula en float sobre un entero < 2^24, por lo que
+ *   truncarla da exactamente floor(sqrt(n)), igual que el double original
+ * - El empaquetado con saturación aplica el mismo clamp a 255
+ *
+ * Con MagnitudeMode::L1 o LINF la raíz se sustituye por |gx| + |gy| o
+ * max(|gx|, |gy|) en carriles de 16 bits (más barato, aproximado).
+ *
+ * Los bordes (primera/última fila y columna) quedan a cero, como en
+ * el resto de implementaciones.
+ *
+ * @example
+ * SobelFilterSIMD filter;
+ * cv::Mat edges = filter.applySobel(input_image);
+ */
+class SobelFilterSIMD {
+private:
+    SimdLevel level_;
+    MagnitudeMode mode_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param level Variante del kernel (por defecto la mejor soportada por la CPU)
+     * @param mode Cálculo de la magnitud (exacta por defecto)
+     */
+    explicit SobelFilterSIMD(SimdLevel level = detectBestLevel(),
+                             MagnitudeMode mode = MagnitudeMode::EXACT);
+
+    /**
+     * @brief Aplica el filtro Sobel a una imagen
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @return Magnitud del gradiente en CV_8UC1
+     */
+    cv::Mat applySobel(const cv::Mat& inputImage) const;
+
+    /**
+     * @brief Aplica el filtro Sobel con umbral
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param threshold Umbral (0-255)
+     * @return Imagen binaria (0/255) en CV_8UC1
+     */
+    cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) const;
+
+    /**
+     * @brief Igual que applySobel pero reutilizando buffers del llamador
+     *
+     * outputImage solo se reserva si no tiene ya el tamaño y tipo de la
+     * salida; grayScratch guarda la conversión a gris de entradas BGR
+     * (una entrada gris se lee directamente). Con buffers ya dimensionados
+     * no se reserva memoria. outputImage no puede compartir datos con la entrada.
+     *
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param outputImage Magnitud del gradiente en CV_8UC1
+     * @param grayScratch Buffer de trabajo para la imagen gris
+     */
+    void applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage, cv::Mat& grayScratch) const;
+
+    /**
+     * @brief Igual que applySobelWithThreshold pero reutilizando buffers del llamador
+     * @param threshold Umbral (0-255)
+     */
+    void applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                     int threshold, cv::Mat& grayScratch) const;
+
+    /**
+     * @brief Magnitud y gradientes con signo (Gx, Gy) en una sola pasada
+     *
+     * Los gradientes en int16 que ya calcula el kernel se escriben además
+     * en gradients.gxy (INTERLEAVED) o en gradients.gx / gradients.gy
+     * (PLANAR); la magnitud es idéntica a la de applySobel. Las imágenes
+     * se reutilizan si ya tienen el tamaño y tipo correctos.
+     *
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param gradients Salida: magnitud y gradientes
+     * @param layout Disposición de Gx/Gy
+     * @param grayScratch Buffer de trabajo para la imagen gris
+     */
+    void applyGradientsInto(const cv::Mat& inputImage, SobelGradients& gradients,
+                            GradientLayout layout, cv::Mat& grayScratch) const;
+
+    /**
+     * @brief Magnitud y sector de dirección del gradiente en una sola pasada
+     *
+     * direction recibe el sector de sobelDirectionBin (0-3 o 0-7) por
+     * píxel, calculado con comparaciones enteras sobre gx/gy sin atan2;
+     * magnitude es idéntica a la de applySobel. Marco a 0 en ambas.
+     *
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param magnitude Magnitud en CV_8UC1
+     * @param direction Sectores en CV_8UC1
+     * @param bins FOUR u EIGHT
+     * @param grayScratch Buffer de trabajo para la imagen gris
+     */
+    void applyDirectionInto(const cv::Mat& inputImage, cv::Mat& magnitude, cv::Mat& direction,
+                            DirectionBins bins, cv::Mat& grayScratch) const;
+
+    /**
+     * @brief Una fila de magnitud sin saturar y orientación en 4 sectores
+     *
+     * Para etapas que comparan magnitudes por encima de 255 (supresión de
+     * no máximos de Canny). above, row y below son tres filas grises
+     * consecutivas; se escriben las columnas [1, cols - 1) de magnitude
+     * (hasta 1442 en EXACT) y de direction (sector de sobelDirectionBin
+     * con DirectionBins::FOUR).
+     */
+    void applyMagnitudeDirectionRow(const uchar* above, const uchar* row, const uchar* below,
+                                    uint16_t* magnitude, uchar* direction, int cols) const;
+
+    /**
+     * @brief Aplica el filtro Sobel con umbral y devuelve la máscara a 1 bit por píxel
+     *
+     * Cada fila se umbraliza en un buffer de una fila y se empaqueta
+     * enseguida, así que la máscara de bytes completa no llega a escribirse.
+     *
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param threshold Umbral (0-255)
+     * @return Bitmap equivalente a applySobelWithThreshold
+     */
+    EdgeBitmap applySobelPacked(const cv::Mat& inputImage, int threshold = 50) const;
+
+    /**
+     * @brief Procesa un rango de filas de una imagen ya en escala de grises
+     *
+     * Permite repartir el trabajo por bandas entre hilos. Solo escribe
+     * las filas interiores dentro de [rowBegin, rowEnd).
+     *
+     * @param grayImage Imagen CV_8UC1
+     * @param outputImage Imagen CV_8UC1 del mismo tamaño (ya reservada)
+     * @param rowBegin Primera fila a procesar
+     * @param rowEnd Fila siguiente a la última a procesar
+     */
+    void applyRows(const cv::Mat& grayImage, cv::Mat& outputImage, int rowBegin, int rowEnd) const;
+
+    /**
+     * @brief Igual que applyRows pero escribe directamente la máscara binaria
+     *
+     * Compara gx² + gy² contra (threshold + 1)² - 1 (o la métrica L1/L∞
+     * contra threshold), sin raíz y sin imagen de magnitud intermedia.
+     * El resultado coincide con umbralizar la salida de applyRows.
+     *
+     * @param threshold Umbral (0-255)
+     */
+    void applyThresholdRows(const cv::Mat& grayImage, cv::Mat& outputImage,
+                            int rowBegin, int rowEnd, int threshold) const;
+
+    /**
+     * @brief Procesa un rectángulo de una imagen ya en escala de grises
+     *
+     * Permite repartir el trabajo por bloques 2D. Solo escribe los píxeles
+     * interiores de la imagen que caen dentro de region, así que bloques
+     * disjuntos pueden procesarse en paralelo sobre la misma salida.
+     *
+     * @param grayImage Imagen CV_8UC1
+     * @param outputImage Imagen CV_8UC1 del mismo tamaño (ya reservada)
+     * @param region Rectángulo a procesar (se recorta a la imagen)
+     */
+    void applyRegion(const cv::Mat& grayImage, cv::Mat& outputImage, const cv::Rect& region) const;
+
+    /**
+     * @brief Igual que applyRegion pero escribe directamente la máscara binaria
+     * @param threshold Umbral (0-255)
+     */
+    void applyThresholdRegion(const cv::Mat& grayImage, cv::Mat& outputImage,
+                              const cv::Rect& region, int threshold) const;
+
+    /**
+     * @brief Obtiene la variante usada por esta instancia
+     */
+    SimdLevel getLevel() const { return level_; }
+
+    /**
+     * @brief Cambia/obtiene el cálculo de la magnitud
+     */
+    void setMagnitudeMode(MagnitudeMode mode) { mode_ = mode; }
+    MagnitudeMode getMagnitudeMode() const { return mode_; }
+
+    /**
+     * @brief Detecta la mejor variante soportada por la CPU actual
+     *
+     * La CPU se consulta con cpuid una única vez (ver CpuFeatures).
+     */
+    static SimdLevel detectBestLevel();
+
+    /**
+     * @brief Verifica si una variante puede ejecutarse en la CPU actual
+     */
+    static bool isLevelSupported(SimdLevel level);
+
+    /**
+     * @brief Convierte una variante a string ("scalar", "sse4.1", "avx2", "avx512")
+     */
+    static std::string levelToString(SimdLevel level);
+
+    /**
+     * @brief Convierte un string a variante
+     * @param name Nombre ("scalar", "sse4.1", "avx2", "avx512")
+     * @param level Variante resultante
+     * @return true si el nombre es válido
+     */
+    static bool stringToLevel(const std::string& name, SimdLevel& level);
+};
+
+#endif // SOBEL_FILTER_SIMD_H
@@ -0,0 +1,152 @@
+#ifndef SOBEL_FILTER_TILED_H
+#define SOBEL_FILTER_TILED_H
+
+#include <opencv2/opencv.hpp>
+#include <memory>
+#include <vector>
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+#include "work_stealing_scheduler.h"
+
+/**
+ * @brief Filtro Sobel con OpenMP por bloques 2D del tamaño de la caché
+ *
+ * En lugar de repartir píxeles sueltos (collapse(2)), cada hilo toma
+ * bloques completos de tileWidth x tileHeight y los recorre fila a fila
+ * con el kernel vectorizado. Así:
+ *
+ *   - el planificador solo interviene una vez por bloque (cola propia
+ *     por hilo con robo de trabajo, ver WorkStealingScheduler),
+ *   - las filas de entrada de un bloque (más el halo de una fila) y su
+ *     salida caben en la L2 del núcleo que lo procesa,
+ *   - el ancho del bloque es múltiplo de 64 bytes y los bloques se
+ *     escriben en una salida con filas alineadas a 64 bytes (la del
+ *     llamador si ya lo está o, si no, un buffer con filas rellenadas
+ *     que luego se copia), de modo que ninguna línea de caché de la
+ *     salida se escribe desde dos hilos.
+ *
+ * Con tileWidth/tileHeight a 0 el tamaño se calcula a partir de la L2
+ * detectada (ver CpuFeatures::l2CacheBytes) y del tamaño de la imagen.
+ * La salida es idéntica a la de SobelFilterSIMD.
+ *
+ * @example
+ * SobelFilterTiled filter;              // Bloques ajustados a la L2
+ * SobelFilterTiled fixed(256, 64);      // Bloques de 256x64
+ * cv::Mat edges = filter.applySobel(input_image);
+ */
+class SobelFilterTiled {
+public:
+    /**
+     * @brief Memoria de trabajo reutilizable entre llamadas
+     *
+     * Guarda la conversión a gris, la salida con filas alineadas a 64 bytes
+     * (solo se usa si la del llamador no lo está), la rejilla de bloques (se
+     * recalcula solo si cambia el tamaño de imagen o de bloque) y el
+     * planificador (solo si cambia el número de hilos). Un Scratch no debe
+     * compartirse entre llamadas concurrentes.
+     */
+    struct Scratch {
+        cv::Mat gray;
+        cv::Mat alignedBuffer;   // Memoria de alignedOutput (con margen para alinear)
+        cv::Mat alignedOutput;   // Vista de filas múltiplo de 64 bytes sobre alignedBuffer
+        cv::Size imageSize;
+        cv::Size tileSize;
+        std::vector<cv::Rect> tiles;
+        std::unique_ptr<WorkStealingScheduler> scheduler;
+    };
+
+private:
+    SobelFilterSIMD engine_;
+    int tileWidth_;
+    int tileHeight_;
+
+    // Recorrido común: magnitud o, si binary, máscara directa sin raíz
+    void process(const cv::Mat& inputImage, cv::Mat& outputImage, bool binary, int threshold,
+                 Scratch& scratch) const;
+
+public:
+    /**
+     * @brief Alineación del ancho de bloque (una línea de caché)
+     */
+    static constexpr int TILE_ALIGN = 64;
+
+    /**
+     * @brief Ancho máximo de bloque en automático (imágenes más anchas se parten en columnas)
+     */
+    static constexpr int MAX_AUTO_TILE_WIDTH = 4096;
+
+    /**
+     * @brief Constructor
+     * @param tileWidth Ancho del bloque en píxeles (0 = automático); se redondea a 64
+     * @param tileHeight Alto del bloque en filas (0 = automático)
+     * @param mode Cálculo de la magnitud (exacta por defecto)
+     */
+    explicit SobelFilterTiled(int tileWidth = 0, int tileHeight = 0,
+                              MagnitudeMode mode = MagnitudeMode::EXACT);
+
+    /**
+     * @brief Aplica el filtro Sobel a una imagen
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @return Magnitud del gradiente en CV_8UC1
+     */
+    cv::Mat applySobel(const cv::Mat& inputImage) const;
+
+    /**
+     * @brief Aplica el filtro Sobel con umbral (máscara directa, sin raíz)
+     * @param inputImage Imagen de entrada (CV_8UC1 o CV_8UC3)
+     * @param threshold Umbral (0-255)
+     * @return Imagen binaria (0/255) en CV_8UC1
+     */
+    cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) const;
+
+    /**
+     * @brief Igual que applySobel reutilizando la salida y la memoria de trabajo
+     *
+     * Con outputImage ya dimensionada y el mismo tamaño de imagen que en la
+     * llamada anterior no se reserva memoria.
+     */
+    void applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage, Scratch& scratch) const;
+
+    /**
+     * @brief Igual que applySobelWithThreshold reutilizando la salida y la memoria de trabajo
+     */
+    void applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                     int threshold, Scratch& scratch) const;
+
+    /**
+     * @brief Cambia el tamaño de bloque (0 = automático)
+     */
+    void setTileSize(int tileWidth, int tileHeight);
+
+    /**
+     * @brief Tamaño de bloque efectivo para una imagen dada
+     *
+     * En automático el ancho es el de la imagen redondeado a 64 (como mucho
+     * MAX_AUTO_TILE_WIDTH) y el alto hace que entrada + salida del bloque
+     * ocupen media L2, reduciéndolo si no hay al menos 4 bloques por hilo.
+     */
+    cv::Size getTileSize(const cv::Size& imageSize) const;
+
+    /**
+     * @brief Divide la imagen en bloques del tamaño efectivo
+     */
+    std::vector<cv::Rect> makeTiles(const cv::Size& imageSize) const;
+
+    /**
+     * @brief Cambia/obtiene el cálculo de la magnitud
+     */
+    void setMagnitudeMode(MagnitudeMode mode) { engine_.setMagnitudeMode(mode); }
+    MagnitudeMode getMagnitudeMode() const { return engine_.getMagnitudeMode(); }
+
+    /**
+     * @brief Variante SIMD usada dentro de cada bloque
+     */
+    SimdLevel getLevel() const { return engine_.getLevel(); }
+
+    /**
+     * @brief Kernel usado en cada bloque (procesa una imagen completa en un solo hilo)
+     */
+    const SobelFilterSIMD& getEngine() const { return engine_; }
+};
+
+#endif // SOBEL_FILTER_TILED_H
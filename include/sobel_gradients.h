@@ -0,0 +1,107 @@
+#ifndef SOBEL_GRADIENTS_H
+#define SOBEL_GRADIENTS_H
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <cstdint>
+#include "sobel_magnitude.h"
+
+/**
+ * @brief Disposición de los gradientes con signo
+ */
+enum class GradientLayout {
+    INTERLEAVED,    // Una imagen CV_16SC2 con (Gx, Gy) por píxel
+    PLANAR          // Dos imágenes CV_16SC1: Gx y Gy por separado
+};
+
+/**
+ * @brief Magnitud y gradientes con signo obtenidos en la misma pasada
+ *
+ * Gx y Gy son las respuestas de los kernels 3x3 sin escalar (|G| <= 1020
+ * con entrada de 8 bits) y tienen el mismo signo que
+ * cv::Sobel(gris, dst, CV_16S, 1, 0) y (0, 1). Solo se escriben las
+ * imágenes de la disposición pedida; las demás no se tocan. El marco de
+ * 1 píxel queda a 0 en todas, como en la magnitud.
+ *
+ * Las imágenes se reservan solo si no tienen ya el tamaño y tipo
+ * correctos, así que una misma instancia puede reutilizarse por fotograma.
+ */
+struct SobelGradients {
+    cv::Mat magnitude;      // CV_8UC1, igual que detectEdges
+    cv::Mat gxy;            // INTERLEAVED: CV_16SC2 con (Gx, Gy)
+    cv::Mat gx;             // PLANAR: CV_16SC1
+    cv::Mat gy;             // PLANAR: CV_16SC1
+};
+
+/**
+ * @brief Convierte una disposición a string ("interleaved", "planar")
+ */
+inline const char* gradientLayoutToString(GradientLayout layout) {
+    return layout == GradientLayout::PLANAR ? "planar" : "interleaved";
+}
+
+/**
+ * @brief Reserva (si hace falta) las imágenes de salida y pone a 0 su marco
+ */
+inline void prepareSobelGradients(const cv::Size& size, GradientLayout layout, SobelGradients& gradients) {
+    gradients.magnitude.create(size, CV_8UC1);
+    fillSobelBorder(gradients.magnitude, 0);
+
+    auto zeroBorder = [](cv::Mat& image) {
+        if (image.empty()) {
+            return;
+        }
+        image.row(0).setTo(cv::Scalar::all(0));
+        image.row(image.rows - 1).setTo(cv::Scalar::all(0));
+        image.col(0).setTo(cv::Scalar::all(0));
+        image.col(image.cols - 1).setTo(cv::Scalar::all(0));
+    };
+
+    if (layout == GradientLayout::INTERLEAVED) {
+        gradients.gxy.create(size, CV_16SC2);
+        zeroBorder(gradients.gxy);
+    } else {
+        gradients.gx.create(size, CV_16SC1);
+        gradients.gy.create(size, CV_16SC1);
+        zeroBorder(gradients.gx);
+        zeroBorder(gradients.gy);
+    }
+}
+
+/**
+ * @brief Punteros de escritura de una fila de gradientes
+ *
+ * En INTERLEAVED gx y gy apuntan a la misma fila CV_16SC2 (desplazados
+ * un elemento) con paso 2; en PLANAR a dos filas distintas con paso 1.
+ */
+struct GradientRow {
+    int16_t* gx;
+    int16_t* gy;
+    int step;
+};
+
+inline GradientRow sobelGradientRow(SobelGradients& gradients, GradientLayout layout, int row) {
+    if (layout == GradientLayout::INTERLEAVED) {
+        int16_t* interleaved = gradients.gxy.ptr<int16_t>(row);
+        return {interleaved, interleaved + 1, 2};
+    }
+    return {gradients.gx.ptr<int16_t>(row), gradients.gy.ptr<int16_t>(row), 1};
+}
+
+/**
+ * @brief Fila escalar: magnitud y gradientes de las columnas [start, cols - 1)
+ *
+ * p0, p1 y p2 apuntan a las filas i-1, i, i+1 de la imagen gris.
+ */
+inline void sobelGradientRowScalar(const uchar* p0, const uchar* p1, const uchar* p2, uchar* magnitude,
+                                   const GradientRow& out, int start, int cols, MagnitudeMode mode) {
+    for (int j = start; j < cols - 1; j++) {
+        int gx = (p0[j + 1] - p0[j - 1]) + 2 * (p1[j + 1] - p1[j - 1]) + (p2[j + 1] - p2[j - 1]);
+        int gy = (p2[j - 1] + 2 * p2[j] + p2[j + 1]) - (p0[j - 1] + 2 * p0[j] + p0[j + 1]);
+        magnitude[j] = sobelMagnitude(gx, gy, mode);
+        out.gx[j * out.step] = static_cast<int16_t>(gx);
+        out.gy[j * out.step] = static_cast<int16_t>(gy);
+    }
+}
+
+#endif // SOBEL_GRADIENTS_H
@@ -0,0 +1,180 @@
+#ifndef SOBEL_MAGNITUDE_H
+#define SOBEL_MAGNITUDE_H
+
+#include <opencv2/opencv.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <string>
+
+/**
+ * @brief Forma de calcular la magnitud del gradiente a partir de (Gx, Gy)
+ */
+enum class MagnitudeMode {
+    EXACT,      // floor(sqrt(gx² + gy²)), idéntico a la versión con double
+    L1,         // |gx| + |gy| (aproximación, sin raíz ni multiplicaciones)
+    LINF        // max(|gx|, |gy|) (aproximación más barata)
+};
+
+/**
+ * @brief Tabla floor(sqrt(n)) para n en [0, 65535]
+ *
+ * Se genera en tiempo de compilación. Como la salida se satura a 255,
+ * cualquier n >= 65536 (sqrt >= 256) se resuelve con la última entrada.
+ */
+inline constexpr std::array<uchar, 65536> SOBEL_SQRT_LUT = [] {
+    std::array<uchar, 65536> table{};
+    int root = 0;
+    for (int n = 0; n < 65536; n++) {
+        while ((root + 1) * (root + 1) <= n) {
+            root++;
+        }
+        table[n] = static_cast<uchar>(root);
+    }
+    return table;
+}();
+
+/**
+ * @brief Magnitud sin saturar (para rutas que no normalizan a 255)
+ */
+inline int sobelMagnitudeRaw(int gx, int gy, MagnitudeMode mode) {
+    switch (mode) {
+        case MagnitudeMode::L1:
+            return std::abs(gx) + std::abs(gy);
+        case MagnitudeMode::LINF:
+            return std::max(std::abs(gx), std::abs(gy));
+        default: {
+            int sq = gx * gx + gy * gy;
+            // gx² + gy² < 2^24: fuera de la tabla la raíz en float truncada es exacta
+            return sq < 65536 ? SOBEL_SQRT_LUT[sq]
+                              : static_cast<int>(std::sqrt(static_cast<float>(sq)));
+        }
+    }
+}
+
+/**
+ * @brief Magnitud saturada a 255 lista para escribir en CV_8UC1
+ */
+inline uchar sobelMagnitude(int gx, int gy, MagnitudeMode mode) {
+    switch (mode) {
+        case MagnitudeMode::L1:
+            return static_cast<uchar>(std::min(255, std::abs(gx) + std::abs(gy)));
+        case MagnitudeMode::LINF:
+            return static_cast<uchar>(std::min(255, std::max(std::abs(gx), std::abs(gy))));
+        default: {
+            unsigned sq = static_cast<unsigned>(gx * gx + gy * gy);
+            return SOBEL_SQRT_LUT[std::min(sq, 65535u)];
+        }
+    }
+}
+
+/**
+ * @brief Métrica comparable contra el límite de sobelEdgeLimit
+ *
+ * En modo EXACT es gx² + gy² (sin raíz); en L1/LINF la propia magnitud.
+ */
+inline int sobelEdgeMetric(int gx, int gy, MagnitudeMode mode) {
+    switch (mode) {
+        case MagnitudeMode::L1:
+            return std::abs(gx) + std::abs(gy);
+        case MagnitudeMode::LINF:
+            return std::max(std::abs(gx), std::abs(gy));
+        default:
+            return gx * gx + gy * gy;
+    }
+}
+
+/**
+ * @brief Límite equivalente a "magnitud saturada > threshold"
+ *
+ * Para 0 <= T < 255: floor(sqrt(s)) > T  <=>  s >= (T + 1)²,
+ * por lo que basta comparar s > (T + 1)² - 1 sin calcular la raíz.
+ * Un píxel es borde si sobelEdgeMetric(gx, gy, mode) > límite.
+ */
+inline int sobelEdgeLimit(int threshold, MagnitudeMode mode) {
+    if (threshold < 0) {
+        return -1;                                  // Todo es borde (incluso magnitud 0)
+    }
+    if (threshold >= 255) {
+        return std::numeric_limits<int>::max();     // Nada supera 255 tras saturar
+    }
+    return mode == MagnitudeMode::EXACT ? (threshold + 1) * (threshold + 1) - 1 : threshold;
+}
+
+/**
+ * @brief Valor del marco de 1 píxel que los kernels no calculan
+ *
+ * La magnitud en el borde de la imagen es 0, así que solo es 255 en la
+ * máscara binaria con umbral negativo.
+ */
+inline uchar sobelBorderValue(bool binary, int threshold) {
+    return (binary && threshold < 0) ? 255 : 0;
+}
+
+/**
+ * @brief Escribe solo el marco de 1 píxel de una imagen CV_8UC1
+ *
+ * Permite reutilizar un buffer de salida sin volver a inicializarlo
+ * entero: el interior lo sobrescriben los kernels.
+ */
+inline void fillSobelBorder(cv::Mat& image, uchar value) {
+    if (image.empty()) {
+        return;
+    }
+    int last = image.cols - 1;
+    std::fill_n(image.ptr<uchar>(0), image.cols, value);
+    std::fill_n(image.ptr<uchar>(image.rows - 1), image.cols, value);
+    for (int i = 1; i < image.rows - 1; i++) {
+        uchar* row = image.ptr<uchar>(i);
+        row[0] = value;
+        row[last] = value;
+    }
+}
+
+/**
+ * @brief Máscara con umbral a partir de una magnitud ya calculada
+ *
+ * mask = 255 donde magnitude > threshold y 0 en el resto (CV_8UC1, del
+ * tamaño de magnitude). Es exactamente lo que producen las variantes
+ * "WithThreshold" de los filtros Sobel (ver sobelEdgeLimit y
+ * sobelBorderValue, incluidos umbrales negativos y >= 255), así que
+ * quien ya tiene la magnitud se ahorra la segunda convolución. Admite
+ * magnitudes CV_8U, CV_16U y CV_32F; mask se reutiliza si ya tiene el
+ * tamaño y no puede compartir datos con magnitude.
+ */
+inline void sobelThresholdMagnitude(const cv::Mat& magnitude, cv::Mat& mask, int threshold) {
+    cv::compare(magnitude, threshold, mask, cv::CMP_GT);
+}
+
+/**
+ * @brief Convierte un modo a string ("exact", "l1", "linf")
+ */
+inline std::string magnitudeModeToString(MagnitudeMode mode) {
+    switch (mode) {
+        case MagnitudeMode::EXACT: return "exact";
+        case MagnitudeMode::L1:    return "l1";
+        case MagnitudeMode::LINF:  return "linf";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Convierte un string a modo de magnitud
+ * @return true si el nombre es válido
+ */
+inline bool stringToMagnitudeMode(const std::string& name, MagnitudeMode& mode) {
+    if (name == "exact" || name == "l2") {
+        mode = MagnitudeMode::EXACT;
+    } else if (name == "l1") {
+        mode = MagnitudeMode::L1;
+    } else if (name == "linf" || name == "max") {
+        mode = MagnitudeMode::LINF;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+#endif // SOBEL_MAGNITUDE_H
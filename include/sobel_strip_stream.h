@@ -0,0 +1,92 @@
+#ifndef SOBEL_STRIP_STREAM_H
+#define SOBEL_STRIP_STREAM_H
+
+#include <opencv2/opencv.hpp>
+#include <cstddef>
+#include <string>
+#include "sobel_filter_tiled.h"
+#include "sobel_magnitude.h"
+
+/**
+ * @brief Estadísticas de una ejecución de SobelStripStreamer
+ *
+ * Los tiempos por etapa son tiempo ocupado (sin esperas en las colas);
+ * si las etapas se solapan su suma supera totalMs.
+ */
+struct StripStreamStats {
+    int strips = 0;             // Franjas procesadas
+    size_t bufferBytes = 0;     // Memoria de franjas reservada (cota del pico)
+    double decodeMs = 0.0;      // Lectura + conversión a gris
+    double filterMs = 0.0;      // Sobel (y umbral) de cada franja
+    double encodeMs = 0.0;      // Escritura de las salidas
+    double totalMs = 0.0;       // Tiempo real de principio a fin
+};
+
+/**
+ * @brief Sobel en streaming para imágenes que no caben en memoria
+ *
+ * Lee la entrada (PGM/PPM binario) en franjas horizontales de stripRows
+ * filas más una fila de halo arriba y abajo, filtra cada franja con
+ * SobelFilterTiled y escribe las filas resultantes directamente en un
+ * PGM de salida. Tres etapas en hilos distintos (lectura, filtro y
+ * escritura) se comunican por colas de queueDepth franjas que se
+ * reciclan, así que la memoria depende solo del ancho, de stripRows y de
+ * queueDepth, no del alto de la imagen.
+ *
+ * La salida es idéntica byte a byte a filtrar la imagen completa: el
+ * halo da a cada fila sus dos vecinas y el marco de 1 píxel sigue en 0
+ * (o en el valor de borde del umbral).
+ *
+ * @example
+ * SobelStripStreamer streamer(256);
+ * StripStreamStats stats = streamer.process("mosaico.ppm", "bordes.pgm", "mascara.pgm", 50);
+ */
+class SobelStripStreamer {
+private:
+    SobelFilterTiled filter_;
+    int stripRows_;
+    int queueDepth_;
+
+public:
+    /**
+     * @brief Filas por franja por defecto
+     */
+    static constexpr int DEFAULT_STRIP_ROWS = 256;
+
+    /**
+     * @brief Franjas en circulación por defecto (una por etapa)
+     */
+    static constexpr int DEFAULT_QUEUE_DEPTH = 3;
+
+    /**
+     * @brief Constructor
+     * @param stripRows Filas de salida por franja (>= 1)
+     * @param queueDepth Franjas en circulación entre etapas (>= 1)
+     * @param mode Cálculo de la magnitud (exacta por defecto)
+     */
+    explicit SobelStripStreamer(int stripRows = DEFAULT_STRIP_ROWS, int queueDepth = DEFAULT_QUEUE_DEPTH,
+                                MagnitudeMode mode = MagnitudeMode::EXACT);
+
+    /**
+     * @brief Filtra inputPath franja a franja
+     * @param inputPath PGM (P5) o PPM (P6) binario de 8 bits
+     * @param outputPath PGM de salida con la magnitud (vacío = no se escribe)
+     * @param thresholdPath PGM de salida con la máscara 0/255 (vacío = no se escribe)
+     * @param threshold Umbral de la máscara
+     * @return Estadísticas de memoria y tiempos por etapa
+     * @throws InvalidImageException / SobelFilterException si falla la lectura o la escritura
+     */
+    StripStreamStats process(const std::string& inputPath, const std::string& outputPath,
+                             const std::string& thresholdPath = "", int threshold = 50) const;
+
+    void setStripRows(int rows);
+    int getStripRows() const { return stripRows_; }
+
+    void setQueueDepth(int depth);
+    int getQueueDepth() const { return queueDepth_; }
+
+    void setMagnitudeMode(MagnitudeMode mode) { filter_.setMagnitudeMode(mode); }
+    MagnitudeMode getMagnitudeMode() const { return filter_.getMagnitudeMode(); }
+};
+
+#endif // SOBEL_STRIP_STREAM_H
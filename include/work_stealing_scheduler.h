@@ -0,0 +1,112 @@
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include <opencv2/opencv.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Planificador de bloques con robo de trabajo (work stealing)
+ *
+ * Reparte los índices de tarea [0, numTasks) en una cola por hilo: cada
+ * hilo recibe al principio un rango contiguo (bloques vecinos, buena
+ * localidad) y lo consume por delante. Cuando se queda sin trabajo roba
+ * la mitad final de la cola de otro hilo. Si un núcleo va lento porque
+ * lo comparte otro proceso, el resto de hilos se lleva su trabajo
+ * pendiente y el tiempo total no queda atado al hilo más lento.
+ *
+ * Cada cola es un rango [begin, end) empaquetado en un único entero
+ * atómico de 64 bits, así que sacar y robar son un compare-exchange sin
+ * mutex. Las colas van alineadas a 64 bytes para no compartir línea de
+ * caché entre hilos.
+ *
+ * No depende del modelo de hilos: sirve igual dentro de una región
+ * `#pragma omp parallel` (worker = omp_get_thread_num()) que desde un
+ * PThreadPool (worker = índice de banda).
+ *
+ * @example
+ * WorkStealingScheduler scheduler(numThreads);
+ * scheduler.reset(static_cast<int>(tiles.size()));
+ * pool.parallelFor(numThreads, [&](int worker) {
+ *     scheduler.run(worker, [&](int t) { procesarBloque(tiles[t]); });
+ * });
+ */
+class WorkStealingScheduler {
+private:
+    /**
+     * @brief Cola de un hilo: begin en los 32 bits altos, end en los bajos
+     */
+    struct alignas(64) WorkerQueue {
+        std::atomic<uint64_t> range{0};
+    };
+
+    int numWorkers_;
+    std::unique_ptr<WorkerQueue[]> queues_;
+    std::atomic<int> steals_{0};
+
+    static uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+
+    // Intenta robar la mitad final de la cola de otro hilo
+    bool steal(int worker, int& task);
+
+public:
+    /**
+     * @brief Crea el planificador con una cola por hilo
+     * @param numWorkers Número de hilos que llamarán a next() (mínimo 1)
+     */
+    explicit WorkStealingScheduler(int numWorkers);
+
+    WorkStealingScheduler(const WorkStealingScheduler&) = delete;
+    WorkStealingScheduler& operator=(const WorkStealingScheduler&) = delete;
+
+    /**
+     * @brief Reparte numTasks tareas en rangos contiguos, uno por hilo
+     *
+     * No es seguro llamarlo mientras algún hilo está dentro de next().
+     */
+    void reset(int numTasks);
+
+    /**
+     * @brief Obtiene la siguiente tarea para el hilo worker
+     *
+     * Primero saca de su propia cola y, si está vacía, roba de las demás.
+     *
+     * @return false cuando no queda trabajo en ninguna cola
+     */
+    bool next(int worker, int& task);
+
+    /**
+     * @brief Ejecuta fn(task) para todas las tareas que consiga el hilo worker
+     */
+    template <typename Fn>
+    void run(int worker, Fn&& fn) {
+        int task;
+        while (next(worker, task)) {
+            fn(task);
+        }
+    }
+
+    /**
+     * @brief Número de hilos/colas
+     */
+    int getNumWorkers() const { return numWorkers_; }
+
+    /**
+     * @brief Robos realizados desde el último reset()
+     */
+    int getSteals() const { return steals_.load(std::memory_order_relaxed); }
+};
+
+/**
+ * @brief Divide una imagen en una rejilla de bloques (los del borde pueden ser menores)
+ *
+ * Los bloques se devuelven por filas, así que los rangos contiguos que
+ * recibe cada hilo son bloques vecinos.
+ */
+std::vector<cv::Rect> makeTileGrid(const cv::Size& imageSize, const cv::Size& tileSize);
+
+#endif // WORK_STEALING_SCHEDULER_H
@@ -0,0 +1,336 @@
+// =============================================================
+//  BATCH_PIPELINE.CPP
+//  -----------------------------------------------------------
+//  Procesamiento por lotes en tres etapas solapadas:
+//  lectura (cv::imread) -> filtro (estrategia de la Factory)
+//  -> escritura (cv::imwrite), cada una con sus propios hilos
+//  y unidas por colas acotadas. Los PGM de 8 bits se
+//  proyectan con mmap y no pasan por el códec.
+// =============================================================
+
+#include "batch_pipeline.h"
+#include "bounded_queue.h"
+#include "edge_detection_strategy.h"
+#include "filter_factory.h"
+#include "mapped_image.h"
+#include "sobel_filter.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/**
+ * @brief Imagen en tránsito por el pipeline
+ */
+struct BatchItem {
+    std::string path;
+    cv::Mat image;
+    cv::Mat edges;
+    cv::Mat mask;
+
+    // PGM proyectados: image apunta a input y edges/mask a sus ficheros de salida
+    MappedImage input;
+    MappedImage edgesFile;
+    MappedImage maskFile;
+};
+
+using ItemQueue = BoundedQueue<std::unique_ptr<BatchItem>>;
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// Alguna salida sobrescribe una entrada del lote (p. ej. sobel_batch dir dir)
+bool overwritesInputs(const std::vector<std::string>& inputs, const std::string& outputDir) {
+    std::set<fs::path> existing;
+    std::error_code ec;
+    for (const std::string& input : inputs) {
+        fs::path resolved = fs::weakly_canonical(input, ec);
+        if (!ec) {
+            existing.insert(resolved);
+        }
+    }
+    for (const std::string& input : inputs) {
+        for (const char* suffix : {"", "_threshold"}) {
+            fs::path output = fs::weakly_canonical(BatchPipeline::outputPathFor(input, outputDir, suffix), ec);
+            if (!ec && existing.count(output) > 0) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool hasImageExtension(const fs::path& path) {
+    static const char* const extensions[] = {".jpg", ".jpeg", ".png", ".bmp", ".tif", ".tiff",
+                                             ".webp", ".pgm", ".ppm", ".pbm", ".pnm"};
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return std::find(std::begin(extensions), std::end(extensions), ext) != std::end(extensions);
+}
+
+bool hasPgmExtension(const std::string& path) {
+    std::string ext = fs::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".pgm";
+}
+
+/**
+ * @brief Proyecta path si es un PGM binario de 8 bits; si no, deja input cerrado
+ *
+ * Los de 16 bits siguen por cv::imread para que todas las estrategias
+ * reciban la misma entrada de 8 bits que antes.
+ */
+void tryMapPgm(const std::string& path, MappedImage& input) {
+    try {
+        input = MappedImage::openPgm(path);
+        if (input.depth() != CV_8U) {
+            input.close();
+        }
+    } catch (const std::exception&) {
+        input.close();
+    }
+}
+
+/**
+ * @brief Lanza count hilos con fn(); el último en terminar cierra output
+ */
+template <typename Fn>
+void launchStage(std::vector<std::thread>& threads, int count, ItemQueue& output, Fn fn) {
+    auto remaining = std::make_shared<std::atomic<int>>(count);
+    for (int t = 0; t < count; t++) {
+        threads.emplace_back([fn, remaining, &output] {
+            fn();
+            if (remaining->fetch_sub(1) == 1) {
+                output.close();
+            }
+        });
+    }
+}
+
+} // namespace
+
+void BatchPipelineConfig::validate() const {
+    if (decodeThreads < 1 || filterThreads < 1 || encodeThreads < 1) {
+        throw SobelFilterException("Every pipeline stage needs at least one thread");
+    }
+    if (queueCapacity < 1) {
+        throw SobelFilterException("Queue capacity must be positive");
+    }
+}
+
+BatchPipeline::BatchPipeline(const BatchPipelineConfig& config) : config_(config) {
+    config_.validate();
+}
+
+std::vector<std::string> BatchPipeline::listInputs(const std::string& path) {
+    std::vector<std::string> inputs;
+    if (fs::is_directory(path)) {
+        for (const auto& entry : fs::directory_iterator(path)) {
+            if (entry.is_regular_file() && hasImageExtension(entry.path())) {
+                inputs.push_back(entry.path().string());
+            }
+        }
+        std::sort(inputs.begin(), inputs.end());
+        return inputs;
+    }
+
+    std::ifstream list(path);
+    if (!list) {
+        throw SobelFilterException("Cannot read input list " + path);
+    }
+    std::string line;
+    while (std::getline(list, line)) {
+        // Sin espacios finales (listas generadas en Windows incluidas)
+        while (!line.empty() && std::isspace(static_cast<unsigned char>(line.back()))) {
+            line.pop_back();
+        }
+        if (!line.empty() && line[0] != '#') {
+            inputs.push_back(line);
+        }
+    }
+    return inputs;
+}
+
+std::string BatchPipeline::outputPathFor(const std::string& input, const std::string& outputDir,
+                                         const std::string& suffix) {
+    fs::path name = fs::path(input).filename();
+    std::string file = name.stem().string() + suffix + name.extension().string();
+    return (fs::path(outputDir) / file).string();
+}
+
+BatchPipelineStats BatchPipeline::run(const std::vector<std::string>& inputs, const std::string& outputDir) const {
+    // Se comprueba el filtro antes de lanzar hilos
+    if (!FilterFactory::createFilter(config_.filterName)) {
+        throw SobelFilterException("Unknown filter " + config_.filterName);
+    }
+    std::error_code ec;
+    fs::create_directories(outputDir, ec);
+    if (ec || !fs::is_directory(outputDir)) {
+        throw SobelFilterException("Cannot create output directory " + outputDir);
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+    const size_t capacity = static_cast<size_t>(config_.queueCapacity);
+    ItemQueue decoded(capacity);
+    ItemQueue filtered(capacity);
+
+    std::atomic<size_t> nextInput{0};
+    std::atomic<int> written{0};
+    std::atomic<int> failed{0};
+    std::mutex statsMutex;
+    std::mutex logMutex;
+    BatchPipelineStats stats;
+
+    auto reportFailure = [&](const std::string& stage, const std::string& path) {
+        failed++;
+        std::lock_guard<std::mutex> lock(logMutex);
+        std::cerr << "Error en " << stage << ": " << path << std::endl;
+    };
+
+    std::vector<std::thread> threads;
+
+    // Las lecturas reducidas cambian el tamaño: esas siguen por cv::imread. Si
+    // alguna salida pisa una entrada, truncarla con la entrada aún proyectada
+    // la dejaría a ceros (o daría SIGBUS al leerla): todo el lote va por el códec
+    const bool mapInputs = config_.mapPgm &&
+                           (config_.decodeMode == DecodeMode::COLOR || config_.decodeMode == DecodeMode::GRAY) &&
+                           !overwritesInputs(inputs, outputDir);
+
+    // 1) Lectura: cada hilo toma la siguiente ruta libre
+    launchStage(threads, config_.decodeThreads, decoded, [&] {
+        double busyMs = 0.0;
+        for (size_t i = nextInput++; i < inputs.size(); i = nextInput++) {
+            auto stageStart = std::chrono::high_resolution_clock::now();
+            auto item = std::make_unique<BatchItem>();
+            item->path = inputs[i];
+            try {
+                if (mapInputs && hasPgmExtension(item->path)) {
+                    tryMapPgm(item->path, item->input);
+                }
+                item->image = item->input.isOpen() ? item->input.mat()
+                                                   : decodeImage(item->path, config_.decodeMode);
+            } catch (const std::exception&) {
+                item->image.release();
+            }
+            busyMs += elapsedMs(stageStart);
+            if (item->image.empty()) {
+                reportFailure("lectura", item->path);
+                continue;
+            }
+            if (!decoded.push(std::move(item))) {
+                break;
+            }
+        }
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.decodeMs += busyMs;
+    });
+
+    // 2) Filtro: una estrategia por hilo
+    launchStage(threads, config_.filterThreads, filtered, [&] {
+        double busyMs = 0.0;
+        auto strategy = FilterFactory::createFilter(config_.filterName);
+        std::unique_ptr<BatchItem> item;
+        while (decoded.pop(item)) {
+            auto stageStart = std::chrono::high_resolution_clock::now();
+            bool ok = true;
+            if (item->input.isOpen()) {
+                // Salidas del tamaño final proyectadas: el filtro escribe en el fichero
+                try {
+                    item->edgesFile = MappedImage::createPgm(outputPathFor(item->path, outputDir),
+                                                             item->image.rows, item->image.cols);
+                    item->edges = item->edgesFile.mat();
+                    if (config_.writeThreshold) {
+                        item->maskFile = MappedImage::createPgm(outputPathFor(item->path, outputDir, "_threshold"),
+                                                                item->image.rows, item->image.cols);
+                        item->mask = item->maskFile.mat();
+                    }
+                } catch (const std::exception&) {
+                    // Salida no proyectable (p. ej. es un fichero proyectado): se escribe con cv::imwrite
+                    item->edgesFile.close();
+                    item->maskFile.close();
+                    item->edges.release();
+                    item->mask.release();
+                }
+            }
+            if (config_.writeThreshold) {
+                // Magnitud y máscara con una sola convolución
+                ok = ok && strategy->detectEdgesAndThresholdInto(item->image, item->edges, item->mask,
+                                                                 config_.threshold);
+            } else {
+                ok = ok && strategy->detectEdgesInto(item->image, item->edges);
+            }
+            item->image.release();   // La entrada ya no hace falta en la etapa de escritura
+            item->input.close();
+            busyMs += elapsedMs(stageStart);
+            if (!ok) {
+                reportFailure("filtro", item->path);
+                continue;
+            }
+            filtered.push(std::move(item));
+        }
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.filterMs += busyMs;
+    });
+
+    // 3) Escritura
+    for (int t = 0; t < config_.encodeThreads; t++) {
+        threads.emplace_back([&] {
+            double busyMs = 0.0;
+            std::unique_ptr<BatchItem> item;
+            while (filtered.pop(item)) {
+                auto stageStart = std::chrono::high_resolution_clock::now();
+                bool ok;
+                try {
+                    // Lo que el filtro escribió en una salida proyectada ya está en el
+                    // fichero; si reservó su propia imagen se escribe con cv::imwrite
+                    bool edgesInPlace = item->edgesFile.isOpen() && item->edges.data == item->edgesFile.mat().data;
+                    bool maskInPlace = item->maskFile.isOpen() && item->mask.data == item->maskFile.mat().data;
+                    item->edgesFile.close();
+                    item->maskFile.close();
+                    ok = edgesInPlace || cv::imwrite(outputPathFor(item->path, outputDir), item->edges);
+                    if (ok && config_.writeThreshold) {
+                        ok = maskInPlace || cv::imwrite(outputPathFor(item->path, outputDir, "_threshold"), item->mask);
+                    }
+                } catch (const std::exception&) {
+                    ok = false;
+                }
+                busyMs += elapsedMs(stageStart);
+                if (ok) {
+                    written++;
+                } else {
+                    reportFailure("escritura", item->path);
+                }
+            }
+            std::lock_guard<std::mutex> lock(statsMutex);
+            stats.encodeMs += busyMs;
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    stats.images = written.load();
+    stats.failed = failed.load();
+    stats.totalMs = elapsedMs(start);
+    stats.imagesPerSecond = stats.totalMs > 0.0 ? stats.images * 1000.0 / stats.totalMs : 0.0;
+
+    const double perThread[] = {stats.decodeMs / config_.decodeThreads, stats.filterMs / config_.filterThreads,
+                                stats.encodeMs / config_.encodeThreads};
+    const char* const names[] = {"lectura", "filtro", "escritura"};
+    stats.bottleneck = names[std::max_element(std::begin(perThread), std::end(perThread)) - std::begin(perThread)];
+    return stats;
+}
@@ -0,0 +1,255 @@
+// =============================================================
+//  CANNY_FILTER.CPP
+//  -----------------------------------------------------------
+//  Canny por bandas con OpenMP: cada banda calcula gradiente y
+//  orientación con el kernel vectorizado en un anillo de 3 filas,
+//  suprime no máximos y clasifica débil/fuerte en la misma
+//  pasada. La histéresis se resuelve con rellenos por pila,
+//  primero dentro de cada banda y luego entre bandas.
+// =============================================================
+
+#include "canny_filter.h"
+#include "sobel_filter.h"
+#include <algorithm>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Valor provisional de los bordes débiles en la salida antes de la histéresis
+constexpr uchar CANNY_WEAK = 1;
+constexpr uchar CANNY_EDGE = 255;
+
+/**
+ * @brief Propaga CANNY_EDGE a los débiles vecinos (8-conectividad) de la pila
+ *
+ * Solo recorre las filas [rowBegin, rowEnd). Las posiciones se guardan
+ * como i * cols + j.
+ */
+void floodWeak(cv::Mat& edges, std::vector<int>& stack, int rowBegin, int rowEnd) {
+    const int cols = edges.cols;
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        int i = index / cols;
+        int j = index % cols;
+        for (int ni = std::max(i - 1, rowBegin); ni <= std::min(i + 1, rowEnd - 1); ni++) {
+            uchar* row = edges.ptr<uchar>(ni);
+            for (int nj = std::max(j - 1, 0); nj <= std::min(j + 1, cols - 1); nj++) {
+                if (row[nj] == CANNY_WEAK) {
+                    row[nj] = CANNY_EDGE;
+                    stack.push_back(ni * cols + nj);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Apila los bordes fuertes de una fila
+ */
+void pushEdges(const cv::Mat& edges, int row, std::vector<int>& stack) {
+    const uchar* p = edges.ptr<uchar>(row);
+    for (int j = 0; j < edges.cols; j++) {
+        if (p[j] == CANNY_EDGE) {
+            stack.push_back(row * edges.cols + j);
+        }
+    }
+}
+
+/**
+ * @brief Supresión de no máximos y clasificación de una fila
+ *
+ * up, mid y down son las magnitudes de las filas i-1, i, i+1 y sector la
+ * orientación de la fila i. En horizontal y vertical un píxel sobrevive
+ * si supera al vecino anterior y no es menor que el siguiente (el
+ * desempate asimétrico evita bordes de dos píxeles en mesetas); en las
+ * diagonales debe superar a ambos. Son las mismas reglas que cv::Canny.
+ */
+void suppressRow(const uint16_t* up, const uint16_t* mid, const uint16_t* down, const uchar* sector,
+                 uchar* out, int cols, int low, int high) {
+    out[0] = 0;
+    out[cols - 1] = 0;
+    for (int j = 1; j < cols - 1; j++) {
+        int m = mid[j];
+        if (m <= low) {
+            out[j] = 0;
+            continue;
+        }
+        bool isMaximum;
+        switch (sector[j]) {
+            case 0:  isMaximum = m > mid[j - 1] && m >= mid[j + 1]; break;    // Gradiente horizontal
+            case 2:  isMaximum = m > up[j] && m >= down[j];         break;    // Gradiente vertical
+            case 1:  isMaximum = m > up[j - 1] && m > down[j + 1];  break;    // 45°: gx y gy del mismo signo
+            default: isMaximum = m > up[j + 1] && m > down[j - 1];  break;    // 135°
+        }
+        out[j] = !isMaximum ? 0 : (m > high ? CANNY_EDGE : CANNY_WEAK);
+    }
+}
+
+} // namespace
+
+CannyFilter::CannyFilter(int lowThreshold, int highThreshold, MagnitudeMode mode, SimdLevel level)
+    : engine_(level, mode), lowThreshold_(0), highThreshold_(0), bandHeight_(DEFAULT_BAND_HEIGHT) {
+    setThresholds(lowThreshold, highThreshold);
+}
+
+void CannyFilter::setThresholds(int lowThreshold, int highThreshold) {
+    if (lowThreshold < 0 || highThreshold < lowThreshold) {
+        throw SobelFilterException("Canny thresholds must satisfy 0 <= low <= high");
+    }
+    lowThreshold_ = lowThreshold;
+    highThreshold_ = highThreshold;
+}
+
+void CannyFilter::setBandHeight(int rows) {
+    if (rows < 1) {
+        throw SobelFilterException("Band height must be positive");
+    }
+    bandHeight_ = rows;
+}
+
+void CannyFilter::applyCannyInto(const cv::Mat& inputImage, cv::Mat& outputImage, Scratch& scratch) const {
+    if (inputImage.type() != CV_8UC1 && inputImage.type() != CV_8UC3) {
+        throw InvalidImageException("Input image must be 8-bit grayscale or BGR");
+    }
+    if (!outputImage.empty() && outputImage.datastart == inputImage.datastart) {
+        throw InvalidImageException("Output buffer must not alias the input");
+    }
+
+    const cv::Mat* grayImage = &inputImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, scratch.gray, cv::COLOR_BGR2GRAY);
+        grayImage = &scratch.gray;
+    }
+    const cv::Mat& gray = *grayImage;
+
+    outputImage.create(gray.size(), CV_8UC1);
+    const int rows = gray.rows;
+    const int cols = gray.cols;
+    if (rows < 3 || cols < 3) {
+        outputImage.setTo(cv::Scalar::all(0));
+        return;
+    }
+
+    const int numBands = (rows + bandHeight_ - 1) / bandHeight_;
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = std::min(omp_get_max_threads(), numBands);
+#endif
+
+    if (static_cast<int>(scratch.stacks.size()) < numThreads) {
+        scratch.magnitudeRings.resize(numThreads);
+        scratch.directionRings.resize(numThreads);
+        scratch.stacks.resize(numThreads);
+    }
+    for (int t = 0; t < numThreads; t++) {
+        scratch.magnitudeRings[t].resize(3 * static_cast<size_t>(cols));
+        scratch.directionRings[t].resize(3 * static_cast<size_t>(cols));
+    }
+    if (!scratch.scheduler || scratch.scheduler->getNumWorkers() != numThreads) {
+        scratch.scheduler = std::make_unique<WorkStealingScheduler>(numThreads);
+    }
+    WorkStealingScheduler& scheduler = *scratch.scheduler;
+
+    // Ejecuta fn(worker, banda) para todas las bandas repartidas entre los hilos
+    auto forEachBand = [&](auto&& fn) {
+        scheduler.reset(numBands);
+        if (numThreads == 1) {
+            scheduler.run(0, [&](int band) { fn(0, band); });
+            return;
+        }
+        #pragma omp parallel num_threads(numThreads)
+        {
+            int worker = 0;
+#ifdef _OPENMP
+            worker = omp_get_thread_num();
+#endif
+            scheduler.run(worker, [&](int band) { fn(worker, band); });
+        }
+    };
+
+    const int low = lowThreshold_;
+    const int high = highThreshold_;
+
+    // 1) Gradiente + orientación + NMS + histéresis local, banda a banda
+    forEachBand([&](int worker, int band) {
+        const int rowBegin = band * bandHeight_;
+        const int rowEnd = std::min(rows, rowBegin + bandHeight_);
+        uint16_t* magnitudeRing = scratch.magnitudeRings[worker].data();
+        uchar* directionRing = scratch.directionRings[worker].data();
+
+        // Fila i del gradiente en el hueco i % 3; las filas 0 y rows - 1 tienen magnitud 0
+        auto loadRow = [&](int i) {
+            uint16_t* magnitude = magnitudeRing + (i % 3) * cols;
+            uchar* direction = directionRing + (i % 3) * cols;
+            if (i == 0 || i == rows - 1) {
+                std::fill_n(magnitude, cols, 0);
+                return;
+            }
+            engine_.applyMagnitudeDirectionRow(gray.ptr<uchar>(i - 1), gray.ptr<uchar>(i), gray.ptr<uchar>(i + 1),
+                                               magnitude, direction, cols);
+            magnitude[0] = 0;
+            magnitude[cols - 1] = 0;
+        };
+
+        const int first = std::max(rowBegin, 1);
+        const int last = std::min(rowEnd, rows - 1);
+        if (rowBegin == 0) {
+            std::fill_n(outputImage.ptr<uchar>(0), cols, 0);
+        }
+        if (rowEnd == rows) {
+            std::fill_n(outputImage.ptr<uchar>(rows - 1), cols, 0);
+        }
+        if (first < last) {
+            loadRow(first - 1);
+            loadRow(first);
+            for (int i = first; i < last; i++) {
+                loadRow(i + 1);
+                suppressRow(magnitudeRing + ((i - 1) % 3) * cols, magnitudeRing + (i % 3) * cols,
+                            magnitudeRing + ((i + 1) % 3) * cols, directionRing + (i % 3) * cols,
+                            outputImage.ptr<uchar>(i), cols, low, high);
+            }
+        }
+
+        // Relleno dentro de la banda: no se escriben filas de otros hilos
+        std::vector<int>& stack = scratch.stacks[worker];
+        stack.clear();
+        for (int i = rowBegin; i < rowEnd; i++) {
+            pushEdges(outputImage, i, stack);
+        }
+        floodWeak(outputImage, stack, rowBegin, rowEnd);
+    });
+
+    // 2) Cadenas que cruzan bandas: se parte de los bordes de las filas frontera
+    if (numBands > 1) {
+        std::vector<int>& stack = scratch.stacks[0];
+        stack.clear();
+        for (int band = 1; band < numBands; band++) {
+            int boundary = band * bandHeight_;
+            pushEdges(outputImage, boundary - 1, stack);
+            pushEdges(outputImage, boundary, stack);
+        }
+        floodWeak(outputImage, stack, 0, rows);
+    }
+
+    // 3) Los débiles no conectados a un borde fuerte se descartan
+    forEachBand([&](int, int band) {
+        const int rowEnd = std::min(rows, (band + 1) * bandHeight_);
+        for (int i = band * bandHeight_; i < rowEnd; i++) {
+            uchar* p = outputImage.ptr<uchar>(i);
+            for (int j = 0; j < cols; j++) {
+                p[j] = p[j] == CANNY_EDGE ? CANNY_EDGE : 0;
+            }
+        }
+    });
+}
+
+cv::Mat CannyFilter::applyCanny(const cv::Mat& inputImage) const {
+    cv::Mat outputImage;
+    Scratch scratch;
+    applyCannyInto(inputImage, outputImage, scratch);
+    return outputImage;
+}
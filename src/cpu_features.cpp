@@ -0,0 +1,113 @@
+// =============================================================
+//  CPU_FEATURES.CPP
+//  -----------------------------------------------------------
+//  Detección de extensiones SIMD en tiempo de ejecución. Permite
+//  desplegar un único binario en máquinas con SSE, AVX2 o
+//  AVX-512 y elegir el kernel más rápido al arrancar.
+// =============================================================
+
+#include "cpu_features.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define CPU_FEATURES_X86 1
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CPU_FEATURES_X86 1
+#endif
+
+namespace {
+
+#ifdef CPU_FEATURES_X86
+
+void cpuid(unsigned leaf, unsigned subleaf, unsigned regs[4]) {
+#if defined(_MSC_VER)
+    int out[4];
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for (int i = 0; i < 4; i++) {
+        regs[i] = static_cast<unsigned>(out[i]);
+    }
+#else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned eax, edx;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<unsigned long long>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures probe() {
+    CpuFeatures features;
+    unsigned regs[4];
+
+    cpuid(0, 0, regs);
+    unsigned maxLeaf = regs[0];
+    if (maxLeaf < 1) {
+        return features;
+    }
+
+    // L2 por núcleo en KB (ECX[31:16] de 0x80000006, válido en Intel y AMD)
+    cpuid(0x80000000, 0, regs);
+    if (regs[0] >= 0x80000006) {
+        cpuid(0x80000006, 0, regs);
+        size_t l2Kb = regs[2] >> 16;
+        if (l2Kb > 0) {
+            features.l2CacheBytes = l2Kb * 1024;
+        }
+    }
+
+    cpuid(1, 0, regs);
+    features.sse41 = (regs[2] & (1u << 19)) != 0;
+
+    // AVX/AVX-512 solo son utilizables si el SO guarda los registros (OSXSAVE + XCR0)
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    if (!osxsave || maxLeaf < 7) {
+        return features;
+    }
+
+    unsigned long long xcr0 = xgetbv0();
+    bool osAvx = (xcr0 & 0x6) == 0x6;        // estado XMM + YMM
+    bool osAvx512 = (xcr0 & 0xE6) == 0xE6;   // además opmask + ZMM
+
+    cpuid(7, 0, regs);
+    features.avx2 = osAvx && (regs[1] & (1u << 5)) != 0;
+    features.avx512f = osAvx512 && (regs[1] & (1u << 16)) != 0;
+    features.avx512bw = osAvx512 && (regs[1] & (1u << 30)) != 0;
+
+    return features;
+}
+
+#else
+
+CpuFeatures probe() {
+    return CpuFeatures{};
+}
+
+#endif // CPU_FEATURES_X86
+
+} // namespace
+
+const CpuFeatures& CpuFeatures::get() {
+    static const CpuFeatures features = probe();
+    return features;
+}
+
+std::string CpuFeatures::toString() const {
+    std::string result;
+    if (sse41) result += "sse4.1 ";
+    if (avx2) result += "avx2 ";
+    if (avx512f) result += "avx512f ";
+    if (avx512bw) result += "avx512bw ";
+
+    if (result.empty()) {
+        return "none";
+    }
+    result.pop_back();
+    return result;
+}
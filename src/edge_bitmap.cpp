@@ -0,0 +1,180 @@
+// =============================================================
+//  EDGE_BITMAP.CPP
+//  -----------------------------------------------------------
+//  Empaquetado de máscaras de bordes a 1 bit por píxel y conteos
+//  por fila y por bloque con popcount.
+// =============================================================
+
+#include "edge_bitmap.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+namespace {
+
+inline int popcount64(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(word);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(word));
+#else
+    word = word - ((word >> 1) & 0x5555555555555555ULL);
+    word = (word & 0x3333333333333333ULL) + ((word >> 2) & 0x3333333333333333ULL);
+    word = (word + (word >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<int>((word * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * @brief Empaqueta 8 bytes consecutivos en 8 bits (byte i -> bit i)
+ *
+ * Primero deja el bit alto de cada byte a 1 si el byte no es cero (sin
+ * acarreos entre bytes) y después los reúne con una multiplicación: los
+ * productos parciales caen en posiciones distintas, así que no hay
+ * acarreos y el byte i termina en el bit 56 + i.
+ */
+inline uint64_t packEightBytes(const uchar* src) {
+    const uint64_t low7 = 0x7F7F7F7F7F7F7F7FULL;
+    uint64_t x;
+    std::memcpy(&x, src, sizeof(x));    // Carga little-endian (x86/ARM)
+    uint64_t nonZero = (((x & low7) + low7) | x) & ~low7;
+    return ((nonZero >> 7) * 0x0102040810204080ULL) >> 56;
+}
+
+// Píxeles de borde de una fila en las columnas [begin, end)
+inline int countRange(const uint64_t* row, int begin, int end) {
+    if (begin >= end) {
+        return 0;
+    }
+    int firstWord = begin >> 6;
+    int lastWord = (end - 1) >> 6;
+    uint64_t firstMask = ~uint64_t{0} << (begin & 63);
+    uint64_t lastMask = ~uint64_t{0} >> (63 - ((end - 1) & 63));
+
+    if (firstWord == lastWord) {
+        return popcount64(row[firstWord] & firstMask & lastMask);
+    }
+    int total = popcount64(row[firstWord] & firstMask);
+    for (int w = firstWord + 1; w < lastWord; w++) {
+        total += popcount64(row[w]);
+    }
+    return total + popcount64(row[lastWord] & lastMask);
+}
+
+} // namespace
+
+// =============================================================
+//  CONSTRUCCIÓN Y CONVERSIÓN
+// =============================================================
+
+EdgeBitmap::EdgeBitmap(int rows, int cols)
+    : rows_(std::max(rows, 0)),
+      cols_(std::max(cols, 0)),
+      strideWords_((static_cast<size_t>(std::max(cols, 0)) + 63) / 64),
+      words_(static_cast<size_t>(rows_) * strideWords_, 0) {}
+
+void EdgeBitmap::packRow(const uchar* src, int cols, uint64_t* dst) {
+    // Palabras completas: 8 grupos de 8 bytes
+    const int fullWords = cols / 64;
+    for (int w = 0; w < fullWords; w++) {
+        uint64_t word = 0;
+        for (int b = 0; b < 8; b++) {
+            word |= packEightBytes(src + w * 64 + b * 8) << (b * 8);
+        }
+        dst[w] = word;
+    }
+
+    // Cola: los bits que no existen quedan a 0
+    if (cols % 64 != 0) {
+        uint64_t word = 0;
+        for (int c = fullWords * 64; c < cols; c++) {
+            word |= static_cast<uint64_t>(src[c] != 0) << (c & 63);
+        }
+        dst[fullWords] = word;
+    }
+}
+
+EdgeBitmap EdgeBitmap::fromMask(const cv::Mat& mask) {
+    CV_Assert(mask.type() == CV_8UC1);
+    EdgeBitmap bitmap(mask.rows, mask.cols);
+    for (int r = 0; r < mask.rows; r++) {
+        packRow(mask.ptr<uchar>(r), mask.cols, bitmap.row(r));
+    }
+    return bitmap;
+}
+
+cv::Mat EdgeBitmap::toMask() const {
+    cv::Mat mask(rows_, cols_, CV_8UC1);
+    for (int r = 0; r < rows_; r++) {
+        const uint64_t* src = row(r);
+        uchar* dst = mask.ptr<uchar>(r);
+        for (int c = 0; c < cols_; c++) {
+            dst[c] = ((src[c >> 6] >> (c & 63)) & 1u) ? 255 : 0;
+        }
+    }
+    return mask;
+}
+
+// =============================================================
+//  CONTEOS CON POPCOUNT
+// =============================================================
+
+int EdgeBitmap::countRow(int r) const {
+    // El relleno está a 0: basta sumar palabras completas
+    const uint64_t* words = row(r);
+    int total = 0;
+    for (size_t w = 0; w < strideWords_; w++) {
+        total += popcount64(words[w]);
+    }
+    return total;
+}
+
+cv::Mat EdgeBitmap::countRows() const {
+    cv::Mat counts(rows_, 1, CV_32SC1);
+    for (int r = 0; r < rows_; r++) {
+        counts.at<int>(r, 0) = countRow(r);
+    }
+    return counts;
+}
+
+size_t EdgeBitmap::count() const {
+    size_t total = 0;
+    for (uint64_t word : words_) {
+        total += popcount64(word);
+    }
+    return total;
+}
+
+int EdgeBitmap::countTile(int x, int y, int width, int height) const {
+    int x0 = std::max(x, 0);
+    int y0 = std::max(y, 0);
+    int x1 = std::min(x + width, cols_);
+    int y1 = std::min(y + height, rows_);
+
+    int total = 0;
+    for (int r = y0; r < y1; r++) {
+        total += countRange(row(r), x0, x1);
+    }
+    return total;
+}
+
+cv::Mat EdgeBitmap::countTiles(int tileWidth, int tileHeight) const {
+    CV_Assert(tileWidth > 0 && tileHeight > 0);
+    int tilesX = (cols_ + tileWidth - 1) / tileWidth;
+    int tilesY = (rows_ + tileHeight - 1) / tileHeight;
+    cv::Mat counts = cv::Mat::zeros(tilesY, tilesX, CV_32SC1);
+
+    // Se recorre fila a fila para leer cada palabra de forma secuencial
+    for (int r = 0; r < rows_; r++) {
+        const uint64_t* words = row(r);
+        int* dst = counts.ptr<int>(r / tileHeight);
+        for (int t = 0; t < tilesX; t++) {
+            int begin = t * tileWidth;
+            dst[t] += countRange(words, begin, std::min(begin + tileWidth, cols_));
+        }
+    }
+    return counts;
+}
@@ -0,0 +1,132 @@
+// =============================================================
+//  EDGE_DETECTION_STRATEGY.CPP
+//  -----------------------------------------------------------
+//  Procesamiento por lotes común a todas las estrategias: elige
+//  entre repartir imágenes completas entre hilos (miniaturas) o
+//  procesarlas de una en una con el paralelismo del motor.
+//  También la salida de gradientes (Gx, Gy) por defecto.
+// =============================================================
+
+#include "edge_detection_strategy.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+BatchParallelism EdgeDetectionStrategy::chooseBatchParallelism(const std::vector<cv::Mat>& inputs) const {
+    if (inputs.size() < 2 || !supportsSerialBatch()) {
+        return BatchParallelism::WITHIN_IMAGE;
+    }
+
+    double totalPixels = 0.0;
+    for (const cv::Mat& input : inputs) {
+        totalPixels += static_cast<double>(input.total());
+    }
+    double meanPixels = totalPixels / static_cast<double>(inputs.size());
+    return meanPixels <= BATCH_SMALL_IMAGE_PIXELS ? BatchParallelism::ACROSS_IMAGES
+                                                  : BatchParallelism::WITHIN_IMAGE;
+}
+
+BatchStats EdgeDetectionStrategy::detectEdgesBatch(const std::vector<cv::Mat>& inputs,
+                                                   std::vector<cv::Mat>& outputs,
+                                                   std::optional<int> threshold) {
+    BatchStats stats;
+    stats.images = inputs.size();
+    stats.parallelism = chooseBatchParallelism(inputs);
+    outputs.resize(inputs.size());
+
+    const int numImages = static_cast<int>(inputs.size());
+    std::atomic<size_t> failed{0};
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (stats.parallelism == BatchParallelism::ACROSS_IMAGES) {
+        int numThreads = 1;
+#ifdef _OPENMP
+        numThreads = std::min(omp_get_max_threads(), numImages);
+#endif
+        // Una sola región paralela para todo el lote: cada hilo toma imágenes
+        // de su cola y roba a los demás al terminar
+        WorkStealingScheduler scheduler(numThreads);
+        scheduler.reset(numImages);
+
+        #pragma omp parallel num_threads(numThreads)
+        {
+            int worker = 0;
+#ifdef _OPENMP
+            worker = omp_get_thread_num();
+#endif
+            scheduler.run(worker, [&](int i) {
+                try {
+                    outputs[i] = detectEdgesSerial(inputs[i], threshold);
+                } catch (const std::exception&) {
+                    outputs[i].release();
+                    failed++;
+                }
+            });
+        }
+    } else {
+        for (int i = 0; i < numImages; i++) {
+            auto result = threshold ? detectEdgesWithThreshold(inputs[i], *threshold)
+                                    : detectEdges(inputs[i]);
+            if (result) {
+                outputs[i] = std::move(*result);
+            } else {
+                outputs[i].release();
+                failed++;
+            }
+        }
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    stats.failed = failed.load();
+    stats.elapsedMs = std::chrono::duration<double, std::milli>(end - start).count();
+    stats.imagesPerSecond = stats.elapsedMs > 0.0 ? stats.images * 1000.0 / stats.elapsedMs : 0.0;
+    return stats;
+}
+
+cv::Mat EdgeDetectionStrategy::detectEdgesSerial(const cv::Mat&, std::optional<int>) const {
+    throw std::logic_error(getName() + " no admite procesamiento por lotes entre imágenes");
+}
+
+// =============================================================
+//  Gradientes con signo
+// =============================================================
+
+void EdgeDetectionStrategy::computeGradients(const cv::Mat& gray, SobelGradients& output,
+                                             GradientLayout layout, MagnitudeMode mode) {
+    if (!output.magnitude.empty() && output.magnitude.datastart == gray.datastart) {
+        throw std::invalid_argument("La salida no puede compartir datos con la entrada");
+    }
+    prepareSobelGradients(gray.size(), layout, output);
+
+    for (int i = 1; i < gray.rows - 1; i++) {
+        GradientRow out = sobelGradientRow(output, layout, i);
+        sobelGradientRowScalar(gray.ptr<uchar>(i - 1), gray.ptr<uchar>(i), gray.ptr<uchar>(i + 1),
+                               output.magnitude.ptr<uchar>(i), out, 1, gray.cols, mode);
+    }
+}
+
+bool EdgeDetectionStrategy::detectGradientsInto(const cv::Mat& input, SobelGradients& output,
+                                                GradientLayout layout) {
+    try {
+        if (input.empty() || input.depth() != CV_8U || (input.channels() != 1 && input.channels() != 3)) {
+            throw std::invalid_argument("Los gradientes CV_16S requieren una entrada CV_8UC1 o CV_8UC3");
+        }
+
+        cv::Mat gray = input;
+        if (input.channels() == 3) {
+            cv::cvtColor(input, gray, cv::COLOR_BGR2GRAY);
+        }
+        computeGradients(gray, output, layout, getMagnitudeMode());
+        return true;
+    } catch (const std::exception& e) {
+        std::cerr << "Error en " << getName() << " (gradientes): " << e.what() << std::endl;
+        return false;
+    }
+}
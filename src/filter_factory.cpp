@@ -8,6 +8,7 @@
 
 #include "filter_factory.h"
 #include "sobel_strategies.cpp"
+#include "sobel_filter_simd.h"
 #include <algorithm>
 #include <stdexcept>
 
@@ -27,8 +28,20 @@ void FilterFactory::initializeDefaultFilters() {
                                        "Filtro Sobel OpenMP - Paralelización automática");
         registered_filters_.emplace_back(FilterType::SOBEL_PTHREAD, "sobel_pthread", 
                                        "Filtro Sobel pThreads - Control manual de hilos");
+        registered_filters_.emplace_back(FilterType::SOBEL_SIMD, "sobel_simd", 
+                                       "Filtro Sobel SIMD - Kernel vectorizado SSE4.1/AVX2/AVX-512");
+        registered_filters_.emplace_back(FilterType::SOBEL_SEPARABLE, "sobel_separable", 
+                                       "Filtro Sobel separable - Dos pasadas 1D con buffer de filas");
+        registered_filters_.emplace_back(FilterType::SOBEL_TILED, "sobel_tiled", 
+                                       "Filtro Sobel por bloques - OpenMP con bloques 2D ajustados a la L2");
+        registered_filters_.emplace_back(FilterType::SOBEL_TEMPLATE, "sobel_template", 
+                                       "Filtro Sobel con templates - Kernel 3x3 resuelto en compilación");
+        registered_filters_.emplace_back(FilterType::SOBEL_TEMPLATE_REPLICATE, "sobel_template_replicate", 
+                                       "Filtro Sobel con templates - 3x3 con borde replicado");
+        registered_filters_.emplace_back(FilterType::SOBEL_TEMPLATE_5X5, "sobel_template_5x5", 
+                                       "Filtro Sobel con templates - Kernel 5x5");
         registered_filters_.emplace_back(FilterType::CANNY, "canny", 
-                                       "Filtro Canny - Detección de bordes avanzada", false);
+                                       "Filtro Canny - Gradiente SIMD con NMS e histéresis por bandas");
     }
 }
 
@@ -51,10 +64,26 @@ std::unique_ptr<EdgeDetectionStrategy> FilterFactory::createFilter(FilterType ty
         case FilterType::SOBEL_PTHREAD:
             return std::make_unique<SobelPThreadStrategy>();
             
+        case FilterType::SOBEL_SIMD:
+            return std::make_unique<SobelSIMDStrategy>();
+            
+        case FilterType::SOBEL_SEPARABLE:
+            return std::make_unique<SobelSeparableStrategy>();
+            
+        case FilterType::SOBEL_TILED:
+            return std::make_unique<SobelTiledStrategy>();
+            
+        case FilterType::SOBEL_TEMPLATE:
+            return std::make_unique<SobelTemplateStrategy<3, BorderSkip>>();
+            
+        case FilterType::SOBEL_TEMPLATE_REPLICATE:
+            return std::make_unique<SobelTemplateStrategy<3, BorderReplicate>>();
+            
+        case FilterType::SOBEL_TEMPLATE_5X5:
+            return std::make_unique<SobelTemplateStrategy<5, BorderSkip>>();
+            
         case FilterType::CANNY:
-            // TODO: Implementar cuando se necesite
-            std::cerr << "Filtro Canny no implementado aún" << std::endl;
-            return nullptr;
+            return std::make_unique<CannyStrategy>();
             
         default:
             std::cerr << "Tipo de filtro desconocido" << std::endl;
@@ -66,6 +95,37 @@ std::unique_ptr<EdgeDetectionStrategy> FilterFactory::createFilter(FilterType ty
  * @brief Crea un filtro a partir de su nombre
  */
 std::unique_ptr<EdgeDetectionStrategy> FilterFactory::createFilter(const std::string& name) {
+    // Variante SIMD explícita: "sobel_simd_scalar", "sobel_simd_avx2", ...
+    const std::string simdPrefix = "sobel_simd_";
+    if (name.compare(0, simdPrefix.size(), simdPrefix) == 0) {
+        SimdLevel level;
+        if (!SobelFilterSIMD::stringToLevel(name.substr(simdPrefix.size()), level)) {
+            std::cerr << "Variante SIMD desconocida: " << name << std::endl;
+            return nullptr;
+        }
+        if (!SobelFilterSIMD::isLevelSupported(level)) {
+            std::cerr << "Variante SIMD no soportada por esta CPU: " << name << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<SobelSIMDStrategy>(level);
+    }
+    
+    // Número de hilos explícito: "sobel_pthread_8", ...
+    const std::string pthreadPrefix = "sobel_pthread_";
+    if (name.compare(0, pthreadPrefix.size(), pthreadPrefix) == 0) {
+        int numThreads = 0;
+        try {
+            numThreads = std::stoi(name.substr(pthreadPrefix.size()));
+        } catch (const std::exception&) {
+            numThreads = 0;
+        }
+        if (numThreads <= 0) {
+            std::cerr << "Número de hilos inválido: " << name << std::endl;
+            return nullptr;
+        }
+        return std::make_unique<SobelPThreadStrategy>(numThreads);
+    }
+    
     FilterType type = stringToFilterType(name);
     return createFilter(type);
 }
@@ -135,6 +195,15 @@ FilterFactory::FilterType FilterFactory::stringToFilterType(const std::string& n
         return FilterType::SOBEL_OMP;
     } else if (name == "pthread" || name == "pthreads") {
         return FilterType::SOBEL_PTHREAD;
+    } else if (name == "simd" || name == "auto") {
+        // "auto" usa la mejor variante SIMD detectada en la CPU
+        return FilterType::SOBEL_SIMD;
+    } else if (name == "separable") {
+        return FilterType::SOBEL_SEPARABLE;
+    } else if (name == "tiled" || name == "omp_tiled") {
+        return FilterType::SOBEL_TILED;
+    } else if (name == "template") {
+        return FilterType::SOBEL_TEMPLATE;
     }
     
     // Por defecto, retornar SOBEL_BASIC
@@ -0,0 +1,320 @@
+// =============================================================
+//  MAPPED_IMAGE.CPP
+//  -----------------------------------------------------------
+//  PGM binario y raw planar proyectados con mmap: las entradas
+//  se envuelven en un cv::Mat sin copia y las salidas se crean
+//  con su tamaño final para que el filtro escriba directamente
+//  en las páginas del fichero.
+// =============================================================
+
+#include "mapped_image.h"
+#include "sobel_filter.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr bool hostIsLittleEndian() {
+    return __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+}
+
+size_t planeBytes(int rows, int cols, int depth) {
+    return static_cast<size_t>(rows) * cols * (depth == CV_16U ? 2 : 1);
+}
+
+void checkGeometry(int rows, int cols, int depth, int planes, const std::string& path) {
+    if (rows <= 0 || cols <= 0 || planes <= 0) {
+        throw InvalidImageException(path + ": size and plane count must be positive");
+    }
+    if (depth != CV_8U && depth != CV_16U) {
+        throw InvalidImageException(path + ": only CV_8U and CV_16U pixels can be mapped");
+    }
+}
+
+// Invierte los bytes de count valores de 16 bits en el sitio
+void swapBytes16(uchar* data, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        std::swap(data[2 * i], data[2 * i + 1]);
+    }
+}
+
+// Siguiente número de la cabecera PGM a partir de pos, saltando espacios y comentarios
+int parseHeaderValue(const uchar* data, size_t size, size_t& pos, const std::string& path) {
+    while (pos < size && (std::isspace(data[pos]) || data[pos] == '#')) {
+        if (data[pos] == '#') {
+            while (pos < size && data[pos] != '\n') {
+                pos++;
+            }
+        } else {
+            pos++;
+        }
+    }
+    if (pos >= size || !std::isdigit(data[pos])) {
+        throw InvalidImageException("Malformed PGM header in " + path);
+    }
+    long value = 0;
+    while (pos < size && std::isdigit(data[pos])) {
+        value = value * 10 + (data[pos] - '0');
+        if (value > 1 << 30) {
+            throw InvalidImageException("PGM dimension too large in " + path);
+        }
+        pos++;
+    }
+    return static_cast<int>(value);
+}
+
+// Ficheros proyectados como entrada en este proceso, por (dispositivo, inodo):
+// con enlaces o rutas distintas el nombre no basta para reconocerlos
+std::mutex mappedInputsMutex;
+std::multiset<std::pair<dev_t, ino_t>> mappedInputs;
+
+} // namespace
+
+MappedImage::~MappedImage() {
+    close();   // Sin sync no lanza; deja en big-endian los PGM de 16 bits que no se cerraron
+}
+
+MappedImage::MappedImage(MappedImage&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedImage& MappedImage::operator=(MappedImage&& other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+        data_ = std::exchange(other.data_, nullptr);
+        mappedBytes_ = std::exchange(other.mappedBytes_, 0);
+        headerBytes_ = other.headerBytes_;
+        rows_ = other.rows_;
+        cols_ = other.cols_;
+        depth_ = other.depth_;
+        planes_ = other.planes_;
+        writable_ = other.writable_;
+        bigEndianPixels_ = other.bigEndianPixels_;
+        owned_ = std::move(other.owned_);
+        path_ = std::move(other.path_);
+        registered_ = std::exchange(other.registered_, false);
+        device_ = other.device_;
+        inode_ = other.inode_;
+    }
+    return *this;
+}
+
+void MappedImage::map(const std::string& path, size_t createBytes) {
+    path_ = path;
+    writable_ = createBytes > 0;
+    if (writable_) {
+        // O_TRUNC sobre una entrada aún proyectada la dejaría a ceros (p. ej. salida == entrada)
+        struct stat existing;
+        if (::stat(path.c_str(), &existing) == 0) {
+            std::lock_guard<std::mutex> lock(mappedInputsMutex);
+            if (mappedInputs.count({existing.st_dev, existing.st_ino}) > 0) {
+                throw SobelFilterException("Cannot create " + path + ": the file is mapped as an input");
+            }
+        }
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0 || ::ftruncate(fd_, static_cast<off_t>(createBytes)) != 0) {
+            release();
+            throw SobelFilterException("Cannot create " + path + ": " + std::strerror(errno));
+        }
+        mappedBytes_ = createBytes;
+    } else {
+        fd_ = ::open(path.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd_ < 0 || ::fstat(fd_, &info) != 0) {
+            release();
+            throw InvalidImageException("Cannot open " + path);
+        }
+        if (info.st_size <= 0) {
+            release();
+            throw InvalidImageException(path + " is empty");
+        }
+        mappedBytes_ = static_cast<size_t>(info.st_size);
+        device_ = info.st_dev;
+        inode_ = info.st_ino;
+        std::lock_guard<std::mutex> lock(mappedInputsMutex);
+        mappedInputs.insert({device_, inode_});
+        registered_ = true;
+    }
+
+    // Las entradas se proyectan en privado: si hay que invertir bytes, las
+    // páginas modificadas se copian y el fichero no cambia
+    const int protection = writable_ ? PROT_READ | PROT_WRITE : PROT_READ;
+    data_ = ::mmap(nullptr, mappedBytes_, protection, writable_ ? MAP_SHARED : MAP_PRIVATE, fd_, 0);
+    if (data_ == MAP_FAILED) {
+        data_ = nullptr;
+        release();
+        throw SobelFilterException("mmap failed for " + path + ": " + std::strerror(errno));
+    }
+    if (!writable_) {
+        // Los filtros recorren la imagen por filas de arriba abajo
+        ::madvise(data_, mappedBytes_, MADV_SEQUENTIAL);
+    }
+}
+
+void MappedImage::release() noexcept {
+    if (registered_) {
+        std::lock_guard<std::mutex> lock(mappedInputsMutex);
+        mappedInputs.erase(mappedInputs.find({device_, inode_}));
+        registered_ = false;
+    }
+    if (data_) {
+        ::munmap(data_, mappedBytes_);
+        data_ = nullptr;
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+    owned_.release();
+    mappedBytes_ = 0;
+}
+
+MappedImage MappedImage::openPgm(const std::string& path) {
+    MappedImage image;
+    image.map(path, 0);
+
+    const uchar* bytes = static_cast<const uchar*>(image.data_);
+    if (image.mappedBytes_ < 2 || bytes[0] != 'P' || bytes[1] != '5') {
+        throw InvalidImageException(path + " is not a binary PGM (P5)");
+    }
+    size_t pos = 2;
+    image.cols_ = parseHeaderValue(bytes, image.mappedBytes_, pos, path);
+    image.rows_ = parseHeaderValue(bytes, image.mappedBytes_, pos, path);
+    int maxValue = parseHeaderValue(bytes, image.mappedBytes_, pos, path);
+    // Tras maxval, un único espacio y empiezan los píxeles
+    if (pos >= image.mappedBytes_ || !std::isspace(bytes[pos])) {
+        throw InvalidImageException("Malformed PGM header in " + path);
+    }
+    if (maxValue <= 0 || maxValue > 65535) {
+        throw InvalidImageException(path + ": PGM maxval must be in 1..65535");
+    }
+    image.headerBytes_ = pos + 1;
+    image.depth_ = maxValue > 255 ? CV_16U : CV_8U;
+    checkGeometry(image.rows_, image.cols_, image.depth_, 1, path);
+
+    const size_t pixelBytes = planeBytes(image.rows_, image.cols_, image.depth_);
+    if (image.mappedBytes_ - image.headerBytes_ < pixelBytes) {
+        throw InvalidImageException(path + " is truncated");
+    }
+
+    if (image.depth_ == CV_16U && hostIsLittleEndian()) {
+        uchar* pixels = static_cast<uchar*>(image.data_) + image.headerBytes_;
+        const size_t count = pixelBytes / 2;
+        if (image.headerBytes_ % 2 == 0) {
+            if (::mprotect(image.data_, image.mappedBytes_, PROT_READ | PROT_WRITE) != 0) {
+                throw SobelFilterException("mprotect failed for " + path);
+            }
+            swapBytes16(pixels, count);
+        } else {
+            image.owned_.create(image.rows_, image.cols_, CV_16UC1);
+            std::memcpy(image.owned_.data, pixels, pixelBytes);
+            swapBytes16(image.owned_.data, count);
+        }
+    }
+    return image;
+}
+
+MappedImage MappedImage::openRaw(const std::string& path, int rows, int cols, int depth, int planes) {
+    checkGeometry(rows, cols, depth, planes, path);
+    MappedImage image;
+    image.map(path, 0);
+    image.rows_ = rows;
+    image.cols_ = cols;
+    image.depth_ = depth;
+    image.planes_ = planes;
+
+    const size_t expected = planeBytes(rows, cols, depth) * planes;
+    if (image.mappedBytes_ != expected) {
+        throw InvalidImageException(path + " has " + std::to_string(image.mappedBytes_) + " bytes, expected " +
+                                    std::to_string(expected) + " for " + std::to_string(planes) + " plane(s) of " +
+                                    std::to_string(cols) + "x" + std::to_string(rows));
+    }
+    return image;
+}
+
+MappedImage MappedImage::createPgm(const std::string& path, int rows, int cols, int depth) {
+    checkGeometry(rows, cols, depth, 1, path);
+    std::string header = "P5\n" + std::to_string(cols) + " " + std::to_string(rows) + "\n";
+    const std::string maxValue = depth == CV_16U ? "65535\n" : "255\n";
+    if (depth == CV_16U && (header.size() + maxValue.size()) % 2 != 0) {
+        // Un espacio más entre campos deja los píxeles de 16 bits alineados
+        header.insert(header.size() - 1, " ");
+    }
+    header += maxValue;
+
+    MappedImage image;
+    image.map(path, header.size() + planeBytes(rows, cols, depth));
+    std::memcpy(image.data_, header.data(), header.size());
+    image.headerBytes_ = header.size();
+    image.rows_ = rows;
+    image.cols_ = cols;
+    image.depth_ = depth;
+    image.bigEndianPixels_ = depth == CV_16U && hostIsLittleEndian();
+    return image;
+}
+
+MappedImage MappedImage::createRaw(const std::string& path, int rows, int cols, int depth, int planes) {
+    checkGeometry(rows, cols, depth, planes, path);
+    MappedImage image;
+    image.map(path, planeBytes(rows, cols, depth) * planes);
+    image.rows_ = rows;
+    image.cols_ = cols;
+    image.depth_ = depth;
+    image.planes_ = planes;
+    return image;
+}
+
+cv::Mat MappedImage::mat(int plane) const {
+    if (!data_) {
+        throw SobelFilterException("Image is not mapped");
+    }
+    if (plane < 0 || plane >= planes_) {
+        throw SobelFilterException("Plane " + std::to_string(plane) + " out of range in " + path_);
+    }
+    if (!owned_.empty()) {
+        return owned_;
+    }
+    uchar* pixels = static_cast<uchar*>(data_) + headerBytes_ + planeBytes(rows_, cols_, depth_) * plane;
+    return cv::Mat(rows_, cols_, CV_MAKETYPE(depth_, 1), pixels);
+}
+
+void MappedImage::close(bool sync) {
+    if (!data_) {
+        return;
+    }
+    if (writable_ && bigEndianPixels_) {
+        swapBytes16(static_cast<uchar*>(data_) + headerBytes_, planeBytes(rows_, cols_, depth_) / 2);
+    }
+    if (writable_ && sync && ::msync(data_, mappedBytes_, MS_SYNC) != 0) {
+        release();
+        throw SobelFilterException("msync failed for " + path_);
+    }
+    release();
+}
+
+bool MappedImage::isRawPath(const std::string& path) {
+    size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos || path.find('/', dot) != std::string::npos) {
+        return false;
+    }
+    std::string ext = path.substr(dot);
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+    return ext == ".raw";
+}
+
+bool MappedImage::sameFile(const std::string& first, const std::string& second) {
+    std::error_code error;
+    return std::filesystem::equivalent(first, second, error) && !error;
+}
@@ -0,0 +1,132 @@
+// =============================================================
+//  PNM_IO.CPP
+//  -----------------------------------------------------------
+//  Lectura y escritura por filas de PGM/PPM binarios, para
+//  procesar imágenes que no caben en memoria sin pasar por
+//  cv::imread / cv::imwrite de la imagen completa.
+// =============================================================
+
+#include "pnm_io.h"
+#include "sobel_filter.h"
+#include <cctype>
+
+namespace {
+
+// Siguiente número de la cabecera, saltando espacios y comentarios (#...)
+int readHeaderValue(std::ifstream& file, const std::string& path) {
+    int c = file.get();
+    while (file && (std::isspace(c) || c == '#')) {
+        if (c == '#') {
+            while (file && c != '\n') {
+                c = file.get();
+            }
+        }
+        c = file.get();
+    }
+    if (!file || !std::isdigit(c)) {
+        throw InvalidImageException("Malformed PNM header in " + path);
+    }
+    long value = 0;
+    while (file && std::isdigit(c)) {
+        value = value * 10 + (c - '0');
+        if (value > 1 << 30) {
+            throw InvalidImageException("PNM dimension too large in " + path);
+        }
+        c = file.get();
+    }
+    // Tras el último valor hay exactamente un espacio antes de los datos
+    if (!file || !std::isspace(c)) {
+        throw InvalidImageException("Malformed PNM header in " + path);
+    }
+    return static_cast<int>(value);
+}
+
+} // namespace
+
+PnmReader::PnmReader(const std::string& path) : file_(path, std::ios::binary), path_(path) {
+    if (!file_) {
+        throw InvalidImageException("Cannot open " + path);
+    }
+    char magic[2] = {0, 0};
+    file_.read(magic, 2);
+    if (!file_ || magic[0] != 'P' || (magic[1] != '5' && magic[1] != '6')) {
+        throw InvalidImageException(path + " is not a binary PGM/PPM (P5/P6)");
+    }
+    channels_ = magic[1] == '5' ? 1 : 3;
+    cols_ = readHeaderValue(file_, path);
+    rows_ = readHeaderValue(file_, path);
+    int maxValue = readHeaderValue(file_, path);
+    if (cols_ <= 0 || rows_ <= 0 || maxValue <= 0 || maxValue > 255) {
+        throw InvalidImageException(path + ": only 8-bit PGM/PPM with positive size is supported");
+    }
+}
+
+void PnmReader::readGrayRows(cv::Mat& rows) {
+    if (rows.type() != CV_8UC1 || rows.cols != cols_) {
+        throw InvalidImageException("Destination rows must be CV_8UC1 with the image width");
+    }
+    if (nextRow_ + rows.rows > rows_) {
+        throw InvalidImageException("Reading past the last row of " + path_);
+    }
+
+    const size_t rowBytes = static_cast<size_t>(cols_) * channels_;
+    if (channels_ == 1) {
+        for (int i = 0; i < rows.rows; i++) {
+            file_.read(reinterpret_cast<char*>(rows.ptr<uchar>(i)), static_cast<std::streamsize>(rowBytes));
+        }
+    } else {
+        rgbBuffer_.resize(rowBytes * rows.rows);
+        file_.read(reinterpret_cast<char*>(rgbBuffer_.data()), static_cast<std::streamsize>(rgbBuffer_.size()));
+    }
+    if (!file_) {
+        throw InvalidImageException("Unexpected end of file in " + path_);
+    }
+    if (channels_ == 3) {
+        cv::Mat rgb(rows.rows, cols_, CV_8UC3, rgbBuffer_.data());
+        cv::cvtColor(rgb, rows, cv::COLOR_RGB2GRAY);
+    }
+    nextRow_ += rows.rows;
+}
+
+bool PnmReader::isPnmFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    char magic[2] = {0, 0};
+    file.read(magic, 2);
+    return file && magic[0] == 'P' && (magic[1] == '5' || magic[1] == '6');
+}
+
+PnmWriter::PnmWriter(const std::string& path, int rows, int cols)
+    : file_(path, std::ios::binary | std::ios::trunc), path_(path), rows_(rows), cols_(cols) {
+    if (!file_) {
+        throw SobelFilterException("Cannot create " + path);
+    }
+    file_ << "P5\n" << cols << " " << rows << "\n255\n";
+}
+
+void PnmWriter::writeRows(const cv::Mat& rows) {
+    if (rows.type() != CV_8UC1 || rows.cols != cols_) {
+        throw SobelFilterException("Rows written to " + path_ + " must be CV_8UC1 with the image width");
+    }
+    if (writtenRows_ + rows.rows > rows_) {
+        throw SobelFilterException("Writing past the last row of " + path_);
+    }
+    for (int i = 0; i < rows.rows; i++) {
+        file_.write(reinterpret_cast<const char*>(rows.ptr<uchar>(i)), cols_);
+    }
+    if (!file_) {
+        throw SobelFilterException("Write error in " + path_);
+    }
+    writtenRows_ += rows.rows;
+}
+
+void PnmWriter::close() {
+    if (writtenRows_ != rows_) {
+        throw SobelFilterException(path_ + " is incomplete: " + std::to_string(writtenRows_) + " of " +
+                                   std::to_string(rows_) + " rows written");
+    }
+    file_.flush();
+    if (!file_) {
+        throw SobelFilterException("Write error in " + path_);
+    }
+    file_.close();
+}
@@ -0,0 +1,109 @@
+// =============================================================
+//  PTHREAD_POOL.CPP
+//  -----------------------------------------------------------
+//  Pool de hilos persistente con pThreads. Los hilos esperan en
+//  una variable de condición y procesan bandas de trabajo que se
+//  encolan en cada llamada, de modo que crear los hilos se paga
+//  una sola vez y no en cada frame.
+// =============================================================
+
+#include "pthread_pool.h"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+PThreadPool::PThreadPool(int numThreads) {
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::thread::hardware_concurrency());
+        if (numThreads == 0) numThreads = 4; // Valor por defecto
+    }
+
+    pthread_mutex_init(&mutex_, nullptr);
+    pthread_cond_init(&taskAvailable_, nullptr);
+    pthread_cond_init(&batchDone_, nullptr);
+
+    // Solo se guardan los handles de hilos creados: el destructor los une todos
+    threads_.reserve(numThreads);
+    int error = 0;
+    for (int t = 0; t < numThreads; t++) {
+        pthread_t thread;
+        error = pthread_create(&thread, nullptr, workerMain, this);
+        if (error != 0) {
+            break;   // Se sigue con los hilos que sí arrancaron
+        }
+        threads_.push_back(thread);
+    }
+
+    if (threads_.empty()) {
+        // Sin ningún hilo parallelFor esperaría para siempre
+        pthread_cond_destroy(&batchDone_);
+        pthread_cond_destroy(&taskAvailable_);
+        pthread_mutex_destroy(&mutex_);
+        throw std::runtime_error("PThreadPool: no se pudo crear ningún hilo: " + std::string(std::strerror(error)));
+    }
+}
+
+PThreadPool::~PThreadPool() {
+    pthread_mutex_lock(&mutex_);
+    stop_ = true;
+    pthread_cond_broadcast(&taskAvailable_);
+    pthread_mutex_unlock(&mutex_);
+
+    for (pthread_t& thread : threads_) {
+        pthread_join(thread, nullptr);
+    }
+
+    pthread_cond_destroy(&batchDone_);
+    pthread_cond_destroy(&taskAvailable_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void* PThreadPool::workerMain(void* arg) {
+    PThreadPool* pool = static_cast<PThreadPool*>(arg);
+
+    pthread_mutex_lock(&pool->mutex_);
+    while (true) {
+        while (pool->tasks_.empty() && !pool->stop_) {
+            pthread_cond_wait(&pool->taskAvailable_, &pool->mutex_);
+        }
+        if (pool->tasks_.empty()) {
+            break; // stop_ activo y sin trabajo pendiente
+        }
+
+        Task task = pool->tasks_.front();
+        pool->tasks_.pop_front();
+
+        // Ejecutar la banda sin mantener el mutex
+        pthread_mutex_unlock(&pool->mutex_);
+        (*task.batch->function)(task.band);
+        pthread_mutex_lock(&pool->mutex_);
+
+        if (--task.batch->pending == 0) {
+            pthread_cond_broadcast(&pool->batchDone_);
+        }
+    }
+    pthread_mutex_unlock(&pool->mutex_);
+
+    return nullptr;
+}
+
+void PThreadPool::parallelFor(int numBands, const std::function<void(int)>& function) {
+    if (numBands <= 0) {
+        return;
+    }
+
+    Batch batch{&function, numBands};
+
+    pthread_mutex_lock(&mutex_);
+    for (int band = 0; band < numBands; band++) {
+        tasks_.push_back(Task{&batch, band});
+    }
+    pthread_cond_broadcast(&taskAvailable_);
+
+    // Esperar a que terminen todas las bandas de esta llamada
+    while (batch.pending > 0) {
+        pthread_cond_wait(&batchDone_, &mutex_);
+    }
+    pthread_mutex_unlock(&mutex_);
+}
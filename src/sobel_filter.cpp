@@ -2,6 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include "image_decode.h"
 
 class SobelFilter {
 private:
@@ -26,7 +27,8 @@ public:
         if (inputImage.channels() == 3) {
             cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
         } else {
-            grayImage = inputImage.clone();
+            // Ya es gris: se lee la entrada directamente, sin copia
+            grayImage = inputImage;
         }
         
         // Crear imagen de salida
@@ -63,7 +65,11 @@ public:
     
     // Aplica el filtro Sobel con umbral para obtener bordes más definidos
     cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
-        cv::Mat sobelResult = applySobel(inputImage);
+        return applyThreshold(applySobel(inputImage), threshold);
+    }
+    
+    // Binariza una magnitud ya calculada con applySobel (sin repetir el filtro)
+    cv::Mat applyThreshold(const cv::Mat& sobelResult, int threshold = 50) {
         cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
         
         for (int i = 0; i < sobelResult.rows; i++) {
@@ -80,14 +86,22 @@ public:
 
 int main(int argc, char** argv) {
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida>" << std::endl;
+    bool compareDecode = takeDecodeReportFlag(argc, argv);
+    if (argc < 3 || argc > 4) {
+        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
         std::cout << "Ejemplo: " << argv[0] << " input.jpg output.jpg" << std::endl;
+        std::cout << "Modo de lectura (por defecto color): gray decodifica en gris, reducedN además a 1/N (JPEG)" << std::endl;
         return -1;
     }
     
     // Cargar imagen de entrada
-    cv::Mat inputImage = cv::imread(argv[1]);
+    DecodeMode decodeMode = DecodeMode::COLOR;
+    if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+        std::cerr << "Error: modo de lectura desconocido " << argv[3] << std::endl;
+        return -1;
+    }
+    double decodeMs = 0.0;
+    cv::Mat inputImage = decodeImage(argv[1], decodeMode, &decodeMs);
     if (inputImage.empty()) {
         std::cerr << "Error: No se pudo cargar la imagen " << argv[1] << std::endl;
         return -1;
@@ -95,6 +109,7 @@ int main(int argc, char** argv) {
     
     std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows 
               << " (" << inputImage.channels() << " canales)" << std::endl;
+    std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
     
     // Crear instancia del filtro Sobel
     SobelFilter sobelFilter;
@@ -102,8 +117,8 @@ int main(int argc, char** argv) {
     // Aplicar filtro Sobel
     cv::Mat outputImage = sobelFilter.applySobel(inputImage);
     
-    // Aplicar filtro con umbral para mejor visualización
-    cv::Mat thresholdedImage = sobelFilter.applySobelWithThreshold(inputImage, 50);
+    // Umbral sobre la magnitud ya calculada para mejor visualización
+    cv::Mat thresholdedImage = sobelFilter.applyThreshold(outputImage, 50);
     
     // Guardar resultados
     if (cv::imwrite(argv[2], outputImage)) {
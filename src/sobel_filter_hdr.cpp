@@ -0,0 +1,679 @@
+// =============================================================
+//  SOBEL_FILTER_HDR.CPP
+//  -----------------------------------------------------------
+//  Kernel Sobel para imágenes de 16 bits y float (sensores de
+//  12/16 bits, HDR). Lee la profundidad nativa sin convertir a
+//  8 bits y escribe la salida (16 bits, 8 bits normalizada o
+//  máscara binaria) en la misma pasada.
+//  -----------------------------------------------------------
+//  Como en sobel_filter_simd.cpp, cada variante se compila con
+//  atributos de target y se elige en tiempo de ejecución. Todas
+//  trabajan en carriles de 32 bits (int32 o float); la raíz de
+//  la entrada de 16 bits se hace en double para que sea exacta.
+// =============================================================
+
+#include "sobel_filter_hdr.h"
+#include "sobel_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SOBEL_SIMD_X86 1
+#define SOBEL_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Parámetros de salida comunes a todas las filas
+ */
+struct RowParams {
+    double scale = 1.0;     // Escala de la magnitud (entrada 16U)
+    float scaleF = 1.0f;    // La misma escala para la entrada float
+    int outMax = 255;       // Saturación de la salida (255 o 65535)
+    int limit = 0;          // Umbral en unidades de salida (solo BINARY)
+};
+
+/**
+ * @brief Valor de salida de un píxel de 16 bits
+ *
+ * gx² + gy² < 2^37 es exacto en double y sqrt está correctamente
+ * redondeada, así que truncar da floor(sqrt(n)). La saturación usa la
+ * misma comparación que min_pd para que SIMD y escalar coincidan.
+ */
+template <MagnitudeMode M, bool SCALED>
+inline int valueU16(int gx, int gy, const RowParams& p) {
+    const double cap = p.outMax;
+    if constexpr (M == MagnitudeMode::EXACT) {
+        double m = std::sqrt(static_cast<double>(gx) * gx + static_cast<double>(gy) * gy);
+        if constexpr (SCALED) {
+            m *= p.scale;
+        }
+        return static_cast<int>(m < cap ? m : cap);
+    } else {
+        int m = (M == MagnitudeMode::L1) ? std::abs(gx) + std::abs(gy) : std::max(std::abs(gx), std::abs(gy));
+        if constexpr (SCALED) {
+            double s = m * p.scale;
+            return static_cast<int>(s < cap ? s : cap);
+        }
+        return std::min(m, p.outMax);
+    }
+}
+
+/**
+ * @brief Valor de salida de un píxel float (la escala se aplica siempre)
+ */
+template <MagnitudeMode M>
+inline int valueF32(float gx, float gy, const RowParams& p) {
+    float m;
+    if constexpr (M == MagnitudeMode::EXACT) {
+        m = std::sqrt(gx * gx + gy * gy);
+    } else if constexpr (M == MagnitudeMode::L1) {
+        m = std::fabs(gx) + std::fabs(gy);
+    } else {
+        float ax = std::fabs(gx), ay = std::fabs(gy);
+        m = ax > ay ? ax : ay;
+    }
+    m *= p.scaleF;
+    const float cap = static_cast<float>(p.outMax);
+    return static_cast<int>(m < cap ? m : cap);
+}
+
+/**
+ * @brief Fila escalar desde la columna start (referencia y colas de las variantes SIMD)
+ */
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+void hdrRowScalar(const T* p0, const T* p1, const T* p2, OutT* dst, int start, int cols, const RowParams& p) {
+    using Acc = std::conditional_t<std::is_same_v<T, float>, float, int>;
+    for (int j = start; j < cols - 1; j++) {
+        // Mismo orden de operaciones que las variantes vectoriales
+        Acc d1 = Acc(p1[j + 1]) - Acc(p1[j - 1]);
+        Acc gx = (Acc(p0[j + 1]) - Acc(p0[j - 1])) + (Acc(p2[j + 1]) - Acc(p2[j - 1])) + (d1 + d1);
+        Acc b0 = Acc(p0[j]), b2 = Acc(p2[j]);
+        Acc gy = ((Acc(p2[j - 1]) + Acc(p2[j + 1])) + (b2 + b2)) - ((Acc(p0[j - 1]) + Acc(p0[j + 1])) + (b0 + b0));
+
+        int value;
+        if constexpr (std::is_same_v<T, float>) {
+            value = valueF32<M>(gx, gy, p);
+        } else {
+            value = valueU16<M, SCALED>(gx, gy, p);
+        }
+
+        if constexpr (BINARY) {
+            dst[j] = value > p.limit ? 255 : 0;
+        } else {
+            dst[j] = static_cast<OutT>(value);
+        }
+    }
+}
+
+#ifdef SOBEL_SIMD_X86
+
+// -------------------------------------------------------------
+//  SSE4.1: 4 píxeles por iteración
+// -------------------------------------------------------------
+
+SOBEL_TARGET("sse4.1")
+inline __m128i loadU16SSE41(const uint16_t* p) {
+    return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(p)));
+}
+
+/**
+ * @brief Gradientes de 4 píxeles a partir de la columna j (int32 o float)
+ */
+SOBEL_TARGET("sse4.1")
+inline void gradientsSSE41(const uint16_t* p0, const uint16_t* p1, const uint16_t* p2, int j,
+                           __m128i& gx, __m128i& gy) {
+    __m128i a0 = loadU16SSE41(p0 + j - 1), b0 = loadU16SSE41(p0 + j), c0 = loadU16SSE41(p0 + j + 1);
+    __m128i a1 = loadU16SSE41(p1 + j - 1),                            c1 = loadU16SSE41(p1 + j + 1);
+    __m128i a2 = loadU16SSE41(p2 + j - 1), b2 = loadU16SSE41(p2 + j), c2 = loadU16SSE41(p2 + j + 1);
+    __m128i d1 = _mm_sub_epi32(c1, a1);
+    gx = _mm_add_epi32(_mm_add_epi32(_mm_sub_epi32(c0, a0), _mm_sub_epi32(c2, a2)), _mm_add_epi32(d1, d1));
+    gy = _mm_sub_epi32(_mm_add_epi32(_mm_add_epi32(a2, c2), _mm_add_epi32(b2, b2)),
+                       _mm_add_epi32(_mm_add_epi32(a0, c0), _mm_add_epi32(b0, b0)));
+}
+
+SOBEL_TARGET("sse4.1")
+inline void gradientsSSE41(const float* p0, const float* p1, const float* p2, int j, __m128& gx, __m128& gy) {
+    __m128 a0 = _mm_loadu_ps(p0 + j - 1), b0 = _mm_loadu_ps(p0 + j), c0 = _mm_loadu_ps(p0 + j + 1);
+    __m128 a1 = _mm_loadu_ps(p1 + j - 1),                            c1 = _mm_loadu_ps(p1 + j + 1);
+    __m128 a2 = _mm_loadu_ps(p2 + j - 1), b2 = _mm_loadu_ps(p2 + j), c2 = _mm_loadu_ps(p2 + j + 1);
+    __m128 d1 = _mm_sub_ps(c1, a1);
+    gx = _mm_add_ps(_mm_add_ps(_mm_sub_ps(c0, a0), _mm_sub_ps(c2, a2)), _mm_add_ps(d1, d1));
+    gy = _mm_sub_ps(_mm_add_ps(_mm_add_ps(a2, c2), _mm_add_ps(b2, b2)),
+                    _mm_add_ps(_mm_add_ps(a0, c0), _mm_add_ps(b0, b0)));
+}
+
+template <MagnitudeMode M, bool SCALED>
+SOBEL_TARGET("sse4.1")
+inline __m128i valueU16SSE41(__m128i gx, __m128i gy, const RowParams& p) {
+    __m128i m = _mm_setzero_si128();
+    if constexpr (M == MagnitudeMode::L1) {
+        m = _mm_add_epi32(_mm_abs_epi32(gx), _mm_abs_epi32(gy));
+    } else if constexpr (M == MagnitudeMode::LINF) {
+        m = _mm_max_epi32(_mm_abs_epi32(gx), _mm_abs_epi32(gy));
+    }
+    if constexpr (M != MagnitudeMode::EXACT && !SCALED) {
+        return _mm_min_epi32(m, _mm_set1_epi32(p.outMax));
+    } else {
+        // Dos mitades de 2 doubles
+        __m128d lo, hi;
+        if constexpr (M == MagnitudeMode::EXACT) {
+            __m128d xl = _mm_cvtepi32_pd(gx), xh = _mm_cvtepi32_pd(_mm_unpackhi_epi64(gx, gx));
+            __m128d yl = _mm_cvtepi32_pd(gy), yh = _mm_cvtepi32_pd(_mm_unpackhi_epi64(gy, gy));
+            lo = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(xl, xl), _mm_mul_pd(yl, yl)));
+            hi = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(xh, xh), _mm_mul_pd(yh, yh)));
+        } else {
+            lo = _mm_cvtepi32_pd(m);
+            hi = _mm_cvtepi32_pd(_mm_unpackhi_epi64(m, m));
+        }
+        if constexpr (SCALED) {
+            lo = _mm_mul_pd(lo, _mm_set1_pd(p.scale));
+            hi = _mm_mul_pd(hi, _mm_set1_pd(p.scale));
+        }
+        __m128d cap = _mm_set1_pd(p.outMax);
+        return _mm_unpacklo_epi64(_mm_cvttpd_epi32(_mm_min_pd(lo, cap)), _mm_cvttpd_epi32(_mm_min_pd(hi, cap)));
+    }
+}
+
+template <MagnitudeMode M>
+SOBEL_TARGET("sse4.1")
+inline __m128i valueF32SSE41(__m128 gx, __m128 gy, const RowParams& p) {
+    __m128 m;
+    if constexpr (M == MagnitudeMode::EXACT) {
+        m = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(gx, gx), _mm_mul_ps(gy, gy)));
+    } else {
+        __m128 sign = _mm_set1_ps(-0.0f);
+        __m128 ax = _mm_andnot_ps(sign, gx), ay = _mm_andnot_ps(sign, gy);
+        m = (M == MagnitudeMode::L1) ? _mm_add_ps(ax, ay) : _mm_max_ps(ax, ay);
+    }
+    m = _mm_mul_ps(m, _mm_set1_ps(p.scaleF));
+    return _mm_cvttps_epi32(_mm_min_ps(m, _mm_set1_ps(static_cast<float>(p.outMax))));
+}
+
+/**
+ * @brief Escribe 4 valores int32 (ya saturados) como 16 bits, 8 bits o máscara
+ */
+template <typename OutT, bool BINARY>
+SOBEL_TARGET("sse4.1")
+inline void emitSSE41(__m128i v, OutT* dst, int limit) {
+    if constexpr (BINARY) {
+        v = _mm_and_si128(_mm_cmpgt_epi32(v, _mm_set1_epi32(limit)), _mm_set1_epi32(255));
+    }
+    __m128i v16 = _mm_packus_epi32(v, v);
+    if constexpr (sizeof(OutT) == 2) {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), v16);
+    } else {
+        int32_t bytes = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+        std::memcpy(dst, &bytes, sizeof(bytes));
+    }
+}
+
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+SOBEL_TARGET("sse4.1")
+void hdrRowSSE41(const T* p0, const T* p1, const T* p2, OutT* dst, int cols, const RowParams& p) {
+    int j = 1;
+    for (; j + 4 < cols; j += 4) {
+        if constexpr (std::is_same_v<T, float>) {
+            __m128 gx, gy;
+            gradientsSSE41(p0, p1, p2, j, gx, gy);
+            emitSSE41<OutT, BINARY>(valueF32SSE41<M>(gx, gy, p), dst + j, p.limit);
+        } else {
+            __m128i gx, gy;
+            gradientsSSE41(p0, p1, p2, j, gx, gy);
+            emitSSE41<OutT, BINARY>(valueU16SSE41<M, SCALED>(gx, gy, p), dst + j, p.limit);
+        }
+    }
+    hdrRowScalar<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, j, cols, p);
+}
+
+// -------------------------------------------------------------
+//  AVX2: 8 píxeles por iteración
+// -------------------------------------------------------------
+
+SOBEL_TARGET("avx2")
+inline __m256i loadU16AVX2(const uint16_t* p) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+}
+
+SOBEL_TARGET("avx2")
+inline void gradientsAVX2(const uint16_t* p0, const uint16_t* p1, const uint16_t* p2, int j,
+                          __m256i& gx, __m256i& gy) {
+    __m256i a0 = loadU16AVX2(p0 + j - 1), b0 = loadU16AVX2(p0 + j), c0 = loadU16AVX2(p0 + j + 1);
+    __m256i a1 = loadU16AVX2(p1 + j - 1),                           c1 = loadU16AVX2(p1 + j + 1);
+    __m256i a2 = loadU16AVX2(p2 + j - 1), b2 = loadU16AVX2(p2 + j), c2 = loadU16AVX2(p2 + j + 1);
+    __m256i d1 = _mm256_sub_epi32(c1, a1);
+    gx = _mm256_add_epi32(_mm256_add_epi32(_mm256_sub_epi32(c0, a0), _mm256_sub_epi32(c2, a2)),
+                          _mm256_add_epi32(d1, d1));
+    gy = _mm256_sub_epi32(_mm256_add_epi32(_mm256_add_epi32(a2, c2), _mm256_add_epi32(b2, b2)),
+                          _mm256_add_epi32(_mm256_add_epi32(a0, c0), _mm256_add_epi32(b0, b0)));
+}
+
+SOBEL_TARGET("avx2")
+inline void gradientsAVX2(const float* p0, const float* p1, const float* p2, int j, __m256& gx, __m256& gy) {
+    __m256 a0 = _mm256_loadu_ps(p0 + j - 1), b0 = _mm256_loadu_ps(p0 + j), c0 = _mm256_loadu_ps(p0 + j + 1);
+    __m256 a1 = _mm256_loadu_ps(p1 + j - 1),                               c1 = _mm256_loadu_ps(p1 + j + 1);
+    __m256 a2 = _mm256_loadu_ps(p2 + j - 1), b2 = _mm256_loadu_ps(p2 + j), c2 = _mm256_loadu_ps(p2 + j + 1);
+    __m256 d1 = _mm256_sub_ps(c1, a1);
+    gx = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(c0, a0), _mm256_sub_ps(c2, a2)), _mm256_add_ps(d1, d1));
+    gy = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(a2, c2), _mm256_add_ps(b2, b2)),
+                       _mm256_add_ps(_mm256_add_ps(a0, c0), _mm256_add_ps(b0, b0)));
+}
+
+template <MagnitudeMode M, bool SCALED>
+SOBEL_TARGET("avx2")
+inline __m256i valueU16AVX2(__m256i gx, __m256i gy, const RowParams& p) {
+    __m256i m = _mm256_setzero_si256();
+    if constexpr (M == MagnitudeMode::L1) {
+        m = _mm256_add_epi32(_mm256_abs_epi32(gx), _mm256_abs_epi32(gy));
+    } else if constexpr (M == MagnitudeMode::LINF) {
+        m = _mm256_max_epi32(_mm256_abs_epi32(gx), _mm256_abs_epi32(gy));
+    }
+    if constexpr (M != MagnitudeMode::EXACT && !SCALED) {
+        return _mm256_min_epi32(m, _mm256_set1_epi32(p.outMax));
+    } else {
+        __m256d lo, hi;
+        if constexpr (M == MagnitudeMode::EXACT) {
+            __m256d xl = _mm256_cvtepi32_pd(_mm256_castsi256_si128(gx));
+            __m256d xh = _mm256_cvtepi32_pd(_mm256_extracti128_si256(gx, 1));
+            __m256d yl = _mm256_cvtepi32_pd(_mm256_castsi256_si128(gy));
+            __m256d yh = _mm256_cvtepi32_pd(_mm256_extracti128_si256(gy, 1));
+            lo = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(xl, xl), _mm256_mul_pd(yl, yl)));
+            hi = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(xh, xh), _mm256_mul_pd(yh, yh)));
+        } else {
+            lo = _mm256_cvtepi32_pd(_mm256_castsi256_si128(m));
+            hi = _mm256_cvtepi32_pd(_mm256_extracti128_si256(m, 1));
+        }
+        if constexpr (SCALED) {
+            lo = _mm256_mul_pd(lo, _mm256_set1_pd(p.scale));
+            hi = _mm256_mul_pd(hi, _mm256_set1_pd(p.scale));
+        }
+        __m256d cap = _mm256_set1_pd(p.outMax);
+        __m128i vlo = _mm256_cvttpd_epi32(_mm256_min_pd(lo, cap));
+        __m128i vhi = _mm256_cvttpd_epi32(_mm256_min_pd(hi, cap));
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(vlo), vhi, 1);
+    }
+}
+
+template <MagnitudeMode M>
+SOBEL_TARGET("avx2")
+inline __m256i valueF32AVX2(__m256 gx, __m256 gy, const RowParams& p) {
+    __m256 m;
+    if constexpr (M == MagnitudeMode::EXACT) {
+        m = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(gx, gx), _mm256_mul_ps(gy, gy)));
+    } else {
+        __m256 sign = _mm256_set1_ps(-0.0f);
+        __m256 ax = _mm256_andnot_ps(sign, gx), ay = _mm256_andnot_ps(sign, gy);
+        m = (M == MagnitudeMode::L1) ? _mm256_add_ps(ax, ay) : _mm256_max_ps(ax, ay);
+    }
+    m = _mm256_mul_ps(m, _mm256_set1_ps(p.scaleF));
+    return _mm256_cvttps_epi32(_mm256_min_ps(m, _mm256_set1_ps(static_cast<float>(p.outMax))));
+}
+
+template <typename OutT, bool BINARY>
+SOBEL_TARGET("avx2")
+inline void emitAVX2(__m256i v, OutT* dst, int limit) {
+    if constexpr (BINARY) {
+        v = _mm256_and_si256(_mm256_cmpgt_epi32(v, _mm256_set1_epi32(limit)), _mm256_set1_epi32(255));
+    }
+    // packus de 128 bits sobre las dos mitades conserva el orden de los píxeles
+    __m128i v16 = _mm_packus_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+    if constexpr (sizeof(OutT) == 2) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), v16);
+    } else {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(v16, v16));
+    }
+}
+
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+SOBEL_TARGET("avx2")
+void hdrRowAVX2(const T* p0, const T* p1, const T* p2, OutT* dst, int cols, const RowParams& p) {
+    int j = 1;
+    for (; j + 8 < cols; j += 8) {
+        if constexpr (std::is_same_v<T, float>) {
+            __m256 gx, gy;
+            gradientsAVX2(p0, p1, p2, j, gx, gy);
+            emitAVX2<OutT, BINARY>(valueF32AVX2<M>(gx, gy, p), dst + j, p.limit);
+        } else {
+            __m256i gx, gy;
+            gradientsAVX2(p0, p1, p2, j, gx, gy);
+            emitAVX2<OutT, BINARY>(valueU16AVX2<M, SCALED>(gx, gy, p), dst + j, p.limit);
+        }
+    }
+    hdrRowScalar<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, j, cols, p);
+}
+
+// -------------------------------------------------------------
+//  AVX-512: 16 píxeles por iteración
+// -------------------------------------------------------------
+
+SOBEL_TARGET("avx512f,avx512bw")
+inline __m512i loadU16AVX512(const uint16_t* p) {
+    return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)));
+}
+
+SOBEL_TARGET("avx512f,avx512bw")
+inline void gradientsAVX512(const uint16_t* p0, const uint16_t* p1, const uint16_t* p2, int j,
+                            __m512i& gx, __m512i& gy) {
+    __m512i a0 = loadU16AVX512(p0 + j - 1), b0 = loadU16AVX512(p0 + j), c0 = loadU16AVX512(p0 + j + 1);
+    __m512i a1 = loadU16AVX512(p1 + j - 1),                             c1 = loadU16AVX512(p1 + j + 1);
+    __m512i a2 = loadU16AVX512(p2 + j - 1), b2 = loadU16AVX512(p2 + j), c2 = loadU16AVX512(p2 + j + 1);
+    __m512i d1 = _mm512_sub_epi32(c1, a1);
+    gx = _mm512_add_epi32(_mm512_add_epi32(_mm512_sub_epi32(c0, a0), _mm512_sub_epi32(c2, a2)),
+                          _mm512_add_epi32(d1, d1));
+    gy = _mm512_sub_epi32(_mm512_add_epi32(_mm512_add_epi32(a2, c2), _mm512_add_epi32(b2, b2)),
+                          _mm512_add_epi32(_mm512_add_epi32(a0, c0), _mm512_add_epi32(b0, b0)));
+}
+
+SOBEL_TARGET("avx512f,avx512bw")
+inline void gradientsAVX512(const float* p0, const float* p1, const float* p2, int j, __m512& gx, __m512& gy) {
+    __m512 a0 = _mm512_loadu_ps(p0 + j - 1), b0 = _mm512_loadu_ps(p0 + j), c0 = _mm512_loadu_ps(p0 + j + 1);
+    __m512 a1 = _mm512_loadu_ps(p1 + j - 1),                               c1 = _mm512_loadu_ps(p1 + j + 1);
+    __m512 a2 = _mm512_loadu_ps(p2 + j - 1), b2 = _mm512_loadu_ps(p2 + j), c2 = _mm512_loadu_ps(p2 + j + 1);
+    __m512 d1 = _mm512_sub_ps(c1, a1);
+    gx = _mm512_add_ps(_mm512_add_ps(_mm512_sub_ps(c0, a0), _mm512_sub_ps(c2, a2)), _mm512_add_ps(d1, d1));
+    gy = _mm512_sub_ps(_mm512_add_ps(_mm512_add_ps(a2, c2), _mm512_add_ps(b2, b2)),
+                       _mm512_add_ps(_mm512_add_ps(a0, c0), _mm512_add_ps(b0, b0)));
+}
+
+template <MagnitudeMode M, bool SCALED>
+SOBEL_TARGET("avx512f,avx512bw")
+inline __m512i valueU16AVX512(__m512i gx, __m512i gy, const RowParams& p) {
+    __m512i m = _mm512_setzero_si512();
+    if constexpr (M == MagnitudeMode::L1) {
+        m = _mm512_add_epi32(_mm512_abs_epi32(gx), _mm512_abs_epi32(gy));
+    } else if constexpr (M == MagnitudeMode::LINF) {
+        m = _mm512_max_epi32(_mm512_abs_epi32(gx), _mm512_abs_epi32(gy));
+    }
+    if constexpr (M != MagnitudeMode::EXACT && !SCALED) {
+        return _mm512_min_epi32(m, _mm512_set1_epi32(p.outMax));
+    } else {
+        __m512d lo, hi;
+        if constexpr (M == MagnitudeMode::EXACT) {
+            __m512d xl = _mm512_cvtepi32_pd(_mm512_castsi512_si256(gx));
+            __m512d xh = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(gx, 1));
+            __m512d yl = _mm512_cvtepi32_pd(_mm512_castsi512_si256(gy));
+            __m512d yh = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(gy, 1));
+            lo = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(xl, xl), _mm512_mul_pd(yl, yl)));
+            hi = _mm512_sqrt_pd(_mm512_add_pd(_mm512_mul_pd(xh, xh), _mm512_mul_pd(yh, yh)));
+        } else {
+            lo = _mm512_cvtepi32_pd(_mm512_castsi512_si256(m));
+            hi = _mm512_cvtepi32_pd(_mm512_extracti64x4_epi64(m, 1));
+        }
+        if constexpr (SCALED) {
+            lo = _mm512_mul_pd(lo, _mm512_set1_pd(p.scale));
+            hi = _mm512_mul_pd(hi, _mm512_set1_pd(p.scale));
+        }
+        __m512d cap = _mm512_set1_pd(p.outMax);
+        __m256i vlo = _mm512_cvttpd_epi32(_mm512_min_pd(lo, cap));
+        __m256i vhi = _mm512_cvttpd_epi32(_mm512_min_pd(hi, cap));
+        return _mm512_inserti64x4(_mm512_castsi256_si512(vlo), vhi, 1);
+    }
+}
+
+template <MagnitudeMode M>
+SOBEL_TARGET("avx512f,avx512bw")
+inline __m512i valueF32AVX512(__m512 gx, __m512 gy, const RowParams& p) {
+    __m512 m;
+    if constexpr (M == MagnitudeMode::EXACT) {
+        m = _mm512_sqrt_ps(_mm512_add_ps(_mm512_mul_ps(gx, gx), _mm512_mul_ps(gy, gy)));
+    } else {
+        __m512 ax = _mm512_abs_ps(gx), ay = _mm512_abs_ps(gy);
+        m = (M == MagnitudeMode::L1) ? _mm512_add_ps(ax, ay) : _mm512_max_ps(ax, ay);
+    }
+    m = _mm512_mul_ps(m, _mm512_set1_ps(p.scaleF));
+    return _mm512_cvttps_epi32(_mm512_min_ps(m, _mm512_set1_ps(static_cast<float>(p.outMax))));
+}
+
+template <typename OutT, bool BINARY>
+SOBEL_TARGET("avx512f,avx512bw")
+inline void emitAVX512(__m512i v, OutT* dst, int limit) {
+    if constexpr (BINARY) {
+        v = _mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(v, _mm512_set1_epi32(limit)), _mm512_set1_epi32(255));
+    }
+    // Los valores ya están saturados a outMax: basta con truncar los carriles
+    if constexpr (sizeof(OutT) == 2) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm512_cvtepi32_epi16(v));
+    } else {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm512_cvtepi32_epi8(v));
+    }
+}
+
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+SOBEL_TARGET("avx512f,avx512bw")
+void hdrRowAVX512(const T* p0, const T* p1, const T* p2, OutT* dst, int cols, const RowParams& p) {
+    int j = 1;
+    for (; j + 16 < cols; j += 16) {
+        if constexpr (std::is_same_v<T, float>) {
+            __m512 gx, gy;
+            gradientsAVX512(p0, p1, p2, j, gx, gy);
+            emitAVX512<OutT, BINARY>(valueF32AVX512<M>(gx, gy, p), dst + j, p.limit);
+        } else {
+            __m512i gx, gy;
+            gradientsAVX512(p0, p1, p2, j, gx, gy);
+            emitAVX512<OutT, BINARY>(valueU16AVX512<M, SCALED>(gx, gy, p), dst + j, p.limit);
+        }
+    }
+    // Cola de menos de 16 píxeles con AVX2
+    hdrRowAVX2<T, M, SCALED, OutT, BINARY>(p0 + j - 1, p1 + j - 1, p2 + j - 1, dst + j - 1, cols - (j - 1), p);
+}
+
+#endif // SOBEL_SIMD_X86
+
+/**
+ * @brief Procesa una fila con la variante indicada
+ */
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+void hdrRow(SimdLevel level, const T* p0, const T* p1, const T* p2, OutT* dst, int cols, const RowParams& p) {
+    switch (level) {
+#ifdef SOBEL_SIMD_X86
+        case SimdLevel::AVX512:
+            hdrRowAVX512<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, cols, p);
+            break;
+        case SimdLevel::AVX2:
+            hdrRowAVX2<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, cols, p);
+            break;
+        case SimdLevel::SSE41:
+            hdrRowSSE41<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, cols, p);
+            break;
+#endif
+        default:
+            hdrRowScalar<T, M, SCALED, OutT, BINARY>(p0, p1, p2, dst, 1, cols, p);
+            break;
+    }
+}
+
+template <typename T, MagnitudeMode M, bool SCALED, typename OutT, bool BINARY>
+void processRows(SimdLevel level, const cv::Mat& inputImage, cv::Mat& outputImage,
+                 int first, int last, const RowParams& p) {
+    for (int i = first; i < last; i++) {
+        hdrRow<T, M, SCALED, OutT, BINARY>(level, inputImage.ptr<T>(i - 1), inputImage.ptr<T>(i),
+                                           inputImage.ptr<T>(i + 1), outputImage.ptr<OutT>(i),
+                                           inputImage.cols, p);
+    }
+}
+
+/**
+ * @brief Elige en tiempo de ejecución el modo de magnitud y si hay escala
+ *
+ * La entrada float siempre se escala; la de 16 bits solo cuando la escala
+ * no es 1 (salida de 16 bits a rango completo), y entonces L1/L∞ no pasan
+ * por double.
+ */
+template <typename T, typename OutT, bool BINARY>
+void dispatchRows(SimdLevel level, MagnitudeMode mode, bool scaled, const cv::Mat& inputImage,
+                  cv::Mat& outputImage, int first, int last, const RowParams& p) {
+    if constexpr (!std::is_same_v<T, float>) {
+        if (!scaled) {
+            switch (mode) {
+                case MagnitudeMode::L1:
+                    processRows<T, MagnitudeMode::L1, false, OutT, BINARY>(level, inputImage, outputImage,
+                                                                           first, last, p);
+                    break;
+                case MagnitudeMode::LINF:
+                    processRows<T, MagnitudeMode::LINF, false, OutT, BINARY>(level, inputImage, outputImage,
+                                                                             first, last, p);
+                    break;
+                default:
+                    processRows<T, MagnitudeMode::EXACT, false, OutT, BINARY>(level, inputImage, outputImage,
+                                                                              first, last, p);
+                    break;
+            }
+            return;
+        }
+    }
+    switch (mode) {
+        case MagnitudeMode::L1:
+            processRows<T, MagnitudeMode::L1, true, OutT, BINARY>(level, inputImage, outputImage, first, last, p);
+            break;
+        case MagnitudeMode::LINF:
+            processRows<T, MagnitudeMode::LINF, true, OutT, BINARY>(level, inputImage, outputImage, first, last, p);
+            break;
+        default:
+            processRows<T, MagnitudeMode::EXACT, true, OutT, BINARY>(level, inputImage, outputImage, first, last, p);
+            break;
+    }
+}
+
+template <typename T>
+void dispatchOutput(SimdLevel level, MagnitudeMode mode, bool scaled, const cv::Mat& inputImage,
+                    cv::Mat& outputImage, int first, int last, bool binary, const RowParams& p) {
+    if (binary) {
+        dispatchRows<T, uchar, true>(level, mode, scaled, inputImage, outputImage, first, last, p);
+    } else if (outputImage.depth() == CV_16U) {
+        dispatchRows<T, uint16_t, false>(level, mode, scaled, inputImage, outputImage, first, last, p);
+    } else {
+        dispatchRows<T, uchar, false>(level, mode, scaled, inputImage, outputImage, first, last, p);
+    }
+}
+
+/**
+ * @brief Pone a 0 el marco de 1 píxel (la salida puede ser de 8 o 16 bits)
+ */
+template <typename OutT>
+void zeroBorder(cv::Mat& image) {
+    int last = image.cols - 1;
+    std::fill_n(image.ptr<OutT>(0), image.cols, OutT(0));
+    std::fill_n(image.ptr<OutT>(image.rows - 1), image.cols, OutT(0));
+    for (int i = 1; i < image.rows - 1; i++) {
+        image.ptr<OutT>(i)[0] = 0;
+        image.ptr<OutT>(i)[last] = 0;
+    }
+}
+
+void validateHdrInput(const cv::Mat& inputImage) {
+    if (inputImage.empty()) {
+        throw InvalidImageException("Input image is empty");
+    }
+    if (!SobelFilterHDR::isSupportedType(inputImage.type())) {
+        throw InvalidImageException("Input image must be 16-bit or float single-channel");
+    }
+}
+
+/**
+ * @brief Reserva la salida solo si hace falta y escribe el marco
+ */
+void prepareOutput(const cv::Mat& inputImage, cv::Mat& outputImage, int type) {
+    if (!outputImage.empty() && outputImage.datastart == inputImage.datastart) {
+        throw InvalidImageException("Output buffer must not alias the input");
+    }
+    outputImage.create(inputImage.size(), type);
+    if (type == CV_16UC1) {
+        zeroBorder<uint16_t>(outputImage);
+    } else {
+        zeroBorder<uchar>(outputImage);
+    }
+}
+
+} // namespace
+
+SobelFilterHDR::SobelFilterHDR(SimdLevel level, MagnitudeMode mode, HdrOutput output)
+    : level_(level), mode_(mode), output_(output) {
+    if (!SobelFilterSIMD::isLevelSupported(level_)) {
+        throw SobelFilterException("SIMD level " + SobelFilterSIMD::levelToString(level_) +
+                                   " not supported by this CPU");
+    }
+}
+
+void SobelFilterHDR::setInputRange(double range) {
+    if (!(range >= 0.0)) {
+        throw SobelFilterException("Input range must be non-negative");
+    }
+    inputRange_ = range;
+}
+
+int SobelFilterHDR::outputType() const {
+    return output_ == HdrOutput::MAGNITUDE_16U ? CV_16UC1 : CV_8UC1;
+}
+
+int SobelFilterHDR::outputMax() const {
+    return output_ == HdrOutput::MAGNITUDE_16U ? 65535 : 255;
+}
+
+double SobelFilterHDR::scaleFor(int depth) const {
+    const double range = inputRange_ > 0.0 ? inputRange_ : (depth == CV_32F ? 1.0 : 65535.0);
+    // 16 bits -> 16 bits conserva las unidades del sensor
+    if (depth == CV_16U && output_ == HdrOutput::MAGNITUDE_16U) {
+        return 1.0;
+    }
+    return outputMax() / range;
+}
+
+void SobelFilterHDR::process(const cv::Mat& inputImage, cv::Mat& outputImage, int rowBegin, int rowEnd,
+                             bool binary, int threshold) const {
+    if (inputImage.cols < 3) {
+        return;
+    }
+    const int first = std::max(rowBegin, 1);
+    const int last = std::min(rowEnd, inputImage.rows - 1);
+
+    const int depth = inputImage.depth();
+    RowParams params;
+    params.scale = scaleFor(depth);
+    params.scaleF = static_cast<float>(params.scale);
+    params.outMax = outputMax();
+    params.limit = threshold;
+    const bool scaled = params.scale != 1.0;
+
+    if (depth == CV_16U) {
+        dispatchOutput<uint16_t>(level_, mode_, scaled, inputImage, outputImage, first, last, binary, params);
+    } else {
+        dispatchOutput<float>(level_, mode_, scaled, inputImage, outputImage, first, last, binary, params);
+    }
+}
+
+void SobelFilterHDR::applyRows(const cv::Mat& inputImage, cv::Mat& outputImage, int rowBegin, int rowEnd) const {
+    process(inputImage, outputImage, rowBegin, rowEnd, false, 0);
+}
+
+void SobelFilterHDR::applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage) const {
+    validateHdrInput(inputImage);
+    prepareOutput(inputImage, outputImage, outputType());
+    process(inputImage, outputImage, 0, inputImage.rows, false, 0);
+}
+
+void SobelFilterHDR::applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                                 int threshold) const {
+    validateHdrInput(inputImage);
+    if (threshold < 0 || threshold > outputMax()) {
+        throw SobelFilterException("Threshold must be between 0 and " + std::to_string(outputMax()));
+    }
+    prepareOutput(inputImage, outputImage, CV_8UC1);
+    process(inputImage, outputImage, 0, inputImage.rows, true, threshold);
+}
+
+cv::Mat SobelFilterHDR::applySobel(const cv::Mat& inputImage) const {
+    cv::Mat outputImage;
+    applySobelInto(inputImage, outputImage);
+    return outputImage;
+}
+
+cv::Mat SobelFilterHDR::applySobelWithThreshold(const cv::Mat& inputImage, int threshold) const {
+    cv::Mat outputImage;
+    applySobelWithThresholdInto(inputImage, outputImage, threshold);
+    return outputImage;
+}
@@ -19,6 +19,7 @@
 #include <stdexcept>
 #include <optional>
 #include <array>
+#include "image_decode.h"
 
 /**
  * @brief Excepción personalizada para errores del filtro Sobel
@@ -128,7 +129,8 @@ private:
         if (input.channels() == 3) {
             cv::cvtColor(input, grayImage, cv::COLOR_BGR2GRAY);
         } else {
-            grayImage = input.clone();
+            // Sin copia: una vista gris (incluida una ROI) se lee tal cual
+            grayImage = input;
         }
         return grayImage;
     }
@@ -222,7 +224,10 @@ public:
             
             // Aplicar blur gaussiano si está configurado
             if (config_.useGaussianBlur) {
-                cv::GaussianBlur(grayImage, grayImage, cv::Size(3, 3), config_.gaussianSigma);
+                // No in situ: grayImage puede ser la entrada del llamador
+                cv::Mat blurredImage;
+                cv::GaussianBlur(grayImage, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+                grayImage = blurredImage;
             }
             
             // Crear imagen de salida
@@ -258,6 +263,25 @@ public:
      * @return Imagen procesada con umbral o std::nullopt si hay error
      */
     std::optional<cv::Mat> applyFilterWithThreshold(const cv::Mat& input, int threshold = -1) const {
+        // Aplicar filtro Sobel
+        auto sobelResult = applyFilter(input);
+        if (!sobelResult) {
+            return std::nullopt;
+        }
+        
+        return applyThreshold(*sobelResult, threshold);
+    }
+    
+    /**
+     * @brief Aplica el umbral a una magnitud ya calculada con applyFilter
+     * 
+     * Evita la segunda pasada del filtro cuando se guardan las dos salidas.
+     * 
+     * @param sobelResult Resultado de applyFilter
+     * @param threshold Umbral (usa el configurado si es -1)
+     * @return Imagen con umbral o std::nullopt si hay error
+     */
+    std::optional<cv::Mat> applyThreshold(const cv::Mat& sobelResult, int threshold = -1) const {
         try {
             // Usar umbral configurado si no se especifica uno
             int actualThreshold = (threshold >= 0) ? threshold : config_.threshold;
@@ -267,18 +291,12 @@ public:
                 throw SobelFilterException("Threshold must be between 0 and 255");
             }
             
-            // Aplicar filtro Sobel
-            auto sobelResult = applyFilter(input);
-            if (!sobelResult) {
-                return std::nullopt;
-            }
-            
             // Aplicar umbral
-            cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult->size(), CV_8UC1);
+            cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
             
-            for (int i = 0; i < sobelResult->rows; ++i) {
-                for (int j = 0; j < sobelResult->cols; ++j) {
-                    if (sobelResult->at<uchar>(i, j) > actualThreshold) {
+            for (int i = 0; i < sobelResult.rows; ++i) {
+                for (int j = 0; j < sobelResult.cols; ++j) {
+                    if (sobelResult.at<uchar>(i, j) > actualThreshold) {
                         thresholdedImage.at<uchar>(i, j) = 255;
                     }
                 }
@@ -330,20 +348,29 @@ public:
 int main(int argc, char** argv) {
     try {
         // Verificar argumentos de línea de comandos
-        if (argc != 3) {
-            std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida>" << std::endl;
+        bool compareDecode = takeDecodeReportFlag(argc, argv);
+        if (argc < 3 || argc > 4) {
+            std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
             std::cout << "Ejemplo: " << argv[0] << " input.jpg output.jpg" << std::endl;
+            std::cout << "Modo de lectura (por defecto color): gray decodifica en gris, reducedN además a 1/N (JPEG)" << std::endl;
             return -1;
         }
         
         // Cargar imagen de entrada
-        cv::Mat inputImage = cv::imread(argv[1]);
+        DecodeMode decodeMode = DecodeMode::COLOR;
+        if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+            std::cerr << "Error: modo de lectura desconocido " << argv[3] << std::endl;
+            return -1;
+        }
+        double decodeMs = 0.0;
+        cv::Mat inputImage = decodeImage(argv[1], decodeMode, &decodeMs);
         if (inputImage.empty()) {
             throw InvalidImageException("No se pudo cargar la imagen " + std::string(argv[1]));
         }
         
         std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows 
                   << " (" << inputImage.channels() << " canales)" << std::endl;
+        std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
         
         // Crear configuración del filtro
         FilterConfig config;
@@ -361,8 +388,8 @@ int main(int argc, char** argv) {
             throw SobelFilterException("Error al aplicar el filtro Sobel");
         }
         
-        // Aplicar filtro con umbral
-        auto thresholdedImage = sobelFilter.applyFilterWithThreshold(inputImage);
+        // Umbral sobre la magnitud anterior (una sola pasada del filtro)
+        auto thresholdedImage = sobelFilter.applyThreshold(*outputImage);
         if (!thresholdedImage) {
             throw SobelFilterException("Error al aplicar el filtro con umbral");
         }
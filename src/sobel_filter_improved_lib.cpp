@@ -7,6 +7,8 @@
 #include <stdexcept>
 #include <optional>
 #include <array>
+#include <algorithm>
+#include <cstdint>
 
 // Implementación de la validación de configuración
 void FilterConfig::validate() const {
@@ -16,6 +18,9 @@ void FilterConfig::validate() const {
     if (gaussianSigma <= 0) {
         throw SobelFilterException("Gaussian sigma must be positive");
     }
+    if (inputRange < 0) {
+        throw SobelFilterException("Input range must be non-negative");
+    }
 }
 
 // Implementación de los métodos de SobelFilter
@@ -30,8 +35,8 @@ void SobelFilter::validateInput(const cv::Mat& input) const {
     if (input.dims != 2) {
         throw InvalidImageException("Input image must be 2D");
     }
-    if (input.type() != CV_8UC1 && input.type() != CV_8UC3) {
-        throw InvalidImageException("Input image must be 8-bit grayscale or BGR");
+    if (input.type() != CV_8UC1 && input.type() != CV_8UC3 && !SobelFilterHDR::isSupportedType(input.type())) {
+        throw InvalidImageException("Input image must be 8-bit grayscale/BGR, 16-bit or float grayscale");
     }
 }
 
@@ -40,7 +45,8 @@ cv::Mat SobelFilter::convertToGrayscale(const cv::Mat& input) const {
     if (input.channels() == 3) {
         cv::cvtColor(input, grayImage, cv::COLOR_BGR2GRAY);
     } else {
-        grayImage = input.clone();
+        // Ya es gris: se usa la entrada sin copiar (vale también para ROIs con step arbitrario)
+        grayImage = input;
     }
     return grayImage;
 }
@@ -65,7 +71,7 @@ int SobelFilter::applyKernel(const cv::Mat& image, int row, int col,
 }
 
 double SobelFilter::calculateMagnitude(int gx, int gy) const {
-    return std::sqrt(static_cast<double>(gx * gx + gy * gy));
+    return static_cast<double>(sobelMagnitudeRaw(gx, gy, config_.magnitudeMode));
 }
 
 uchar SobelFilter::normalizeValue(double value) const {
@@ -76,16 +82,150 @@ uchar SobelFilter::normalizeValue(double value) const {
     }
 }
 
+void SobelFilter::applyFused(const cv::Mat& input, cv::Mat* magnitude, cv::Mat* binary, int threshold) const {
+    const int rows = input.rows;
+    const int cols = input.cols;
+    
+    if (magnitude) *magnitude = cv::Mat::zeros(rows, cols, CV_8UC1);
+    if (binary) *binary = cv::Mat::zeros(rows, cols, CV_8UC1);
+    if (rows < 3 || cols < 3) {
+        return;
+    }
+    
+    // Ventana de 4 filas grises (solo se copia si hay que convertir desde BGR).
+    // Sin blur la fila r + 1 se carga mientras r - 2 aún se usa para la salida.
+    const bool isColor = input.channels() == 3;
+    cv::Mat grayRing;
+    cv::Mat graySlots[4];
+    if (isColor) {
+        grayRing.create(4, cols, CV_8UC1);
+        for (int s = 0; s < 4; s++) graySlots[s] = grayRing.row(s);
+    }
+    const uchar* grayRows[4] = {nullptr, nullptr, nullptr, nullptr};
+    auto loadGray = [&](int r) {
+        int slot = r % 4;
+        if (isColor) {
+            cv::cvtColor(input.row(r), graySlots[slot], cv::COLOR_BGR2GRAY);
+            grayRows[slot] = graySlots[slot].ptr<uchar>(0);
+        } else {
+            grayRows[slot] = input.ptr<uchar>(r);
+        }
+    };
+    
+    // Blur gaussiano 3x3 separable en punto fijo Q8 con borde reflejado
+    // (BORDER_REFLECT_101, el mismo que usa cv::GaussianBlur por defecto)
+    const bool blur = config_.useGaussianBlur;
+    int w0 = 0, w1 = 256;
+    cv::Mat blurRing;
+    std::vector<int> vsum;
+    if (blur) {
+        cv::Mat kernel = cv::getGaussianKernel(3, config_.gaussianSigma, CV_64F);
+        w0 = static_cast<int>(std::lround(kernel.at<double>(0, 0) * 256.0));
+        w1 = 256 - 2 * w0;
+        blurRing.create(3, cols, CV_8UC1);
+        vsum.resize(cols);
+    }
+    const uchar* srcRows[3] = {nullptr, nullptr, nullptr};
+    auto produceRow = [&](int r) {
+        int slot = r % 3;
+        if (!blur) {
+            srcRows[slot] = grayRows[r % 4];
+            return;
+        }
+        const uchar* up = grayRows[(r == 0 ? 1 : r - 1) % 4];
+        const uchar* mid = grayRows[r % 4];
+        const uchar* down = grayRows[(r == rows - 1 ? rows - 2 : r + 1) % 4];
+        for (int j = 0; j < cols; j++) {
+            vsum[j] = w0 * (up[j] + down[j]) + w1 * mid[j];
+        }
+        uchar* dst = blurRing.ptr<uchar>(slot);
+        dst[0] = static_cast<uchar>((w0 * 2 * vsum[1] + w1 * vsum[0] + (1 << 15)) >> 16);
+        for (int j = 1; j < cols - 1; j++) {
+            dst[j] = static_cast<uchar>((w0 * (vsum[j - 1] + vsum[j + 1]) + w1 * vsum[j] + (1 << 15)) >> 16);
+        }
+        dst[cols - 1] = static_cast<uchar>((w0 * 2 * vsum[cols - 2] + w1 * vsum[cols - 1] + (1 << 15)) >> 16);
+        srcRows[slot] = dst;
+    };
+    
+    // Con normalize la binarización compara gx² + gy² sin calcular la raíz
+    const int limit = sobelEdgeLimit(threshold, config_.magnitudeMode);
+    
+    // Sobel separable sobre las filas ya suavizadas
+    std::vector<int16_t> smooth(cols);
+    std::vector<int16_t> diff(cols);
+    auto emitRow = [&](int i) {
+        const uchar* p0 = srcRows[(i - 1) % 3];
+        const uchar* p1 = srcRows[i % 3];
+        const uchar* p2 = srcRows[(i + 1) % 3];
+        for (int j = 0; j < cols; j++) {
+            smooth[j] = static_cast<int16_t>(p0[j] + 2 * p1[j] + p2[j]);
+            diff[j] = static_cast<int16_t>(p2[j] - p0[j]);
+        }
+        uchar* magRow = magnitude ? magnitude->ptr<uchar>(i) : nullptr;
+        uchar* binRow = binary ? binary->ptr<uchar>(i) : nullptr;
+        for (int j = 1; j < cols - 1; j++) {
+            int gx = smooth[j + 1] - smooth[j - 1];
+            int gy = diff[j - 1] + 2 * diff[j] + diff[j + 1];
+            if (config_.normalize) {
+                if (magRow) magRow[j] = sobelMagnitude(gx, gy, config_.magnitudeMode);
+                if (binRow) binRow[j] = (sobelEdgeMetric(gx, gy, config_.magnitudeMode) > limit) ? 255 : 0;
+            } else {
+                // Sin saturar: igual que calculateMagnitude + normalizeValue
+                uchar value = static_cast<uchar>(sobelMagnitudeRaw(gx, gy, config_.magnitudeMode));
+                if (magRow) magRow[j] = value;
+                if (binRow) binRow[j] = (value > threshold) ? 255 : 0;
+            }
+        }
+    };
+    
+    // Recorrido único: la fila r de entrada produce la fila r - 1 de salida
+    loadGray(0);
+    loadGray(1);
+    produceRow(0);
+    for (int r = 1; r < rows; r++) {
+        if (r + 1 < rows) loadGray(r + 1);
+        produceRow(r);
+        if (r >= 2) emitRow(r - 1);
+    }
+}
+
+cv::Mat SobelFilter::applyHighDynamicRange(const cv::Mat& input, bool binary, int threshold) const {
+    SobelFilterHDR engine(SobelFilterSIMD::detectBestLevel(), config_.magnitudeMode, config_.hdrOutput);
+    engine.setInputRange(config_.inputRange);
+    
+    cv::Mat source = input;
+    if (config_.useGaussianBlur) {
+        // Se suaviza en 16 bits/float: nada pasa por 8 bits antes del Sobel
+        cv::Mat blurredImage;
+        cv::GaussianBlur(input, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+        source = blurredImage;
+    }
+    return binary ? engine.applySobelWithThreshold(source, threshold) : engine.applySobel(source);
+}
+
 std::optional<cv::Mat> SobelFilter::applyFilter(const cv::Mat& input) const {
     try {
         validateInput(input);
         
+        if (input.depth() != CV_8U) {
+            return applyHighDynamicRange(input, false, 0);
+        }
+        
+        if (config_.fusedPipeline) {
+            cv::Mat outputImage;
+            applyFused(input, &outputImage, nullptr, 0);
+            return outputImage;
+        }
+        
         // Convertir a escala de grises
         cv::Mat grayImage = convertToGrayscale(input);
         
         // Aplicar blur gaussiano si está configurado
         if (config_.useGaussianBlur) {
-            cv::GaussianBlur(grayImage, grayImage, cv::Size(3, 3), config_.gaussianSigma);
+            // Nunca in situ: grayImage puede ser la propia entrada del llamador
+            cv::Mat blurredImage;
+            cv::GaussianBlur(grayImage, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+            grayImage = blurredImage;
         }
         
         // Crear imagen de salida
@@ -119,11 +259,56 @@ std::optional<cv::Mat> SobelFilter::applyFilterWithThreshold(const cv::Mat& inpu
         // Usar umbral configurado si no se especifica uno
         int actualThreshold = (threshold >= 0) ? threshold : config_.threshold;
         
+        // 16 bits/float: el rango válido del umbral depende de la salida elegida
+        if (!input.empty() && SobelFilterHDR::isSupportedType(input.type())) {
+            validateInput(input);
+            return applyHighDynamicRange(input, true, actualThreshold);
+        }
+        
         // Validar umbral
         if (actualThreshold < 0 || actualThreshold > 255) {
             throw SobelFilterException("Threshold must be between 0 and 255");
         }
         
+        // Pipeline fusionado: la binarización se hace en el mismo recorrido
+        if (config_.fusedPipeline) {
+            validateInput(input);
+            cv::Mat thresholdedImage;
+            applyFused(input, nullptr, &thresholdedImage, actualThreshold);
+            return thresholdedImage;
+        }
+        
+        // Umbral directo: gx² + gy² contra el umbral al cuadrado, sin raíz
+        // ni imagen de magnitud intermedia. Sin normalize la magnitud no
+        // se satura, así que se mantiene la ruta en dos pasadas.
+        if (config_.normalize) {
+            validateInput(input);
+            
+            cv::Mat grayImage = convertToGrayscale(input);
+            if (config_.useGaussianBlur) {
+                // Nunca in situ: grayImage puede ser la propia entrada del llamador
+                cv::Mat blurredImage;
+                cv::GaussianBlur(grayImage, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+                grayImage = blurredImage;
+            }
+            
+            const int limit = sobelEdgeLimit(actualThreshold, config_.magnitudeMode);
+            cv::Mat thresholdedImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+            
+            for (int i = KERNEL_OFFSET; i < grayImage.rows - KERNEL_OFFSET; ++i) {
+                for (int j = KERNEL_OFFSET; j < grayImage.cols - KERNEL_OFFSET; ++j) {
+                    int gx = applyKernel(grayImage, i, j, SOBEL_X);
+                    int gy = applyKernel(grayImage, i, j, SOBEL_Y);
+                    
+                    if (sobelEdgeMetric(gx, gy, config_.magnitudeMode) > limit) {
+                        thresholdedImage.at<uchar>(i, j) = 255;
+                    }
+                }
+            }
+            
+            return thresholdedImage;
+        }
+        
         // Aplicar filtro Sobel
         auto sobelResult = applyFilter(input);
         if (!sobelResult) {
@@ -149,6 +334,74 @@ std::optional<cv::Mat> SobelFilter::applyFilterWithThreshold(const cv::Mat& inpu
     }
 }
 
+std::optional<cv::Mat> SobelFilter::applyThreshold(const cv::Mat& magnitude, int threshold) const {
+    try {
+        int actualThreshold = (threshold >= 0) ? threshold : config_.threshold;
+        
+        // Las magnitudes HDR (16 bits/float) admiten umbrales por encima de 255
+        if (magnitude.empty() || magnitude.channels() != 1) {
+            throw InvalidImageException("Magnitude must be a non-empty single-channel image");
+        }
+        if (actualThreshold < 0 || (magnitude.depth() == CV_8U && actualThreshold > 255)) {
+            throw SobelFilterException("Threshold must be between 0 and 255");
+        }
+        
+        // Misma comparación "magnitud > umbral" que las rutas de una pasada
+        cv::Mat thresholdedImage;
+        sobelThresholdMagnitude(magnitude, thresholdedImage, actualThreshold);
+        return thresholdedImage;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error applying threshold: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
+std::optional<cv::Mat> SobelFilter::applyFilterWithDirection(const cv::Mat& input, cv::Mat& direction) const {
+    try {
+        validateInput(input);
+        if (config_.directionBins == DirectionBins::NONE) {
+            throw SobelFilterException("directionBins must be FOUR or EIGHT");
+        }
+        if (input.depth() != CV_8U) {
+            throw InvalidImageException("Direction output requires 8-bit input");
+        }
+        
+        cv::Mat grayImage = convertToGrayscale(input);
+        if (config_.useGaussianBlur) {
+            cv::Mat blurredImage;
+            cv::GaussianBlur(grayImage, blurredImage, cv::Size(3, 3), config_.gaussianSigma);
+            grayImage = blurredImage;
+        }
+        
+        cv::Mat magnitude;
+        if (config_.normalize) {
+            // Magnitud saturada: la misma que produce el kernel vectorizado
+            SobelFilterSIMD engine(SobelFilterSIMD::detectBestLevel(), config_.magnitudeMode);
+            cv::Mat grayScratch;
+            engine.applyDirectionInto(grayImage, magnitude, direction, config_.directionBins, grayScratch);
+            return magnitude;
+        }
+        
+        magnitude = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+        direction.create(grayImage.size(), CV_8UC1);
+        direction.setTo(cv::Scalar::all(0));
+        for (int i = KERNEL_OFFSET; i < grayImage.rows - KERNEL_OFFSET; ++i) {
+            for (int j = KERNEL_OFFSET; j < grayImage.cols - KERNEL_OFFSET; ++j) {
+                int gx = applyKernel(grayImage, i, j, SOBEL_X);
+                int gy = applyKernel(grayImage, i, j, SOBEL_Y);
+                magnitude.at<uchar>(i, j) = normalizeValue(calculateMagnitude(gx, gy));
+                direction.at<uchar>(i, j) = sobelDirectionBin(gx, gy, config_.directionBins);
+            }
+        }
+        return magnitude;
+        
+    } catch (const std::exception& e) {
+        std::cerr << "Error applying Sobel filter with direction: " << e.what() << std::endl;
+        return std::nullopt;
+    }
+}
+
 // Getters y setters
 void SobelFilter::setThreshold(int threshold) { 
     config_.threshold = threshold; 
@@ -172,9 +425,36 @@ void SobelFilter::setGaussianSigma(double sigma) {
 
 double SobelFilter::getGaussianSigma() const { return config_.gaussianSigma; }
 
+void SobelFilter::setDirectionBins(DirectionBins bins) { config_.directionBins = bins; }
+
+DirectionBins SobelFilter::getDirectionBins() const { return config_.directionBins; }
+
+void SobelFilter::setFusedPipeline(bool fused) { config_.fusedPipeline = fused; }
+
+bool SobelFilter::getFusedPipeline() const { return config_.fusedPipeline; }
+
+void SobelFilter::setMagnitudeMode(MagnitudeMode mode) { config_.magnitudeMode = mode; }
+
+MagnitudeMode SobelFilter::getMagnitudeMode() const { return config_.magnitudeMode; }
+
+void SobelFilter::setHdrOutput(HdrOutput output) { config_.hdrOutput = output; }
+
+HdrOutput SobelFilter::getHdrOutput() const { return config_.hdrOutput; }
+
+void SobelFilter::setInputRange(double range) { 
+    config_.inputRange = range; 
+    config_.validate();
+}
+
+double SobelFilter::getInputRange() const { return config_.inputRange; }
+
 std::string SobelFilter::getInfo() const {
     return "SobelFilter[threshold=" + std::to_string(config_.threshold) + 
            ", normalize=" + std::to_string(config_.normalize) + 
            ", gaussianBlur=" + std::to_string(config_.useGaussianBlur) + 
-           ", sigma=" + std::to_string(config_.gaussianSigma) + "]";
+           ", sigma=" + std::to_string(config_.gaussianSigma) + 
+           ", fused=" + std::to_string(config_.fusedPipeline) + 
+           ", magnitude=" + magnitudeModeToString(config_.magnitudeMode) + 
+           ", hdrOutput=" + hdrOutputToString(config_.hdrOutput) + 
+           ", directions=" + directionBinsToString(config_.directionBins) + "]";
 } 
\ No newline at end of file
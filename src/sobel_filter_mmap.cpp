@@ -0,0 +1,181 @@
+// =============================================================
+//  SOBEL_FILTER_MMAP.CPP
+//  -----------------------------------------------------------
+//  Filtro para el intercambio entre etapas propias sin
+//  codificar: entrada PGM o raw proyectada con mmap como un
+//  cv::Mat sin copia, y salidas creadas con su tamaño final en
+//  las que el filtro escribe directamente. Sin imencode ni
+//  imwrite, el tiempo es cálculo más fallos de página.
+// =============================================================
+
+#include "mapped_image.h"
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "sobel_filter_hdr.h"
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::cout << "Uso: " << program << " <entrada.pgm|raw> <salida.pgm|raw> [opciones]" << std::endl;
+    std::cout << "Opciones:" << std::endl;
+    std::cout << "  --size <ancho>x<alto>   Tamaño de una entrada raw (obligatorio para .raw)" << std::endl;
+    std::cout << "  --depth <8|16>          Bits por píxel de una entrada raw (por defecto: 8)" << std::endl;
+    std::cout << "  --plane <n>             Plano de una entrada raw planar (por defecto: 0)" << std::endl;
+    std::cout << "  --planes <n>            Planos de la entrada raw (por defecto: 1)" << std::endl;
+    std::cout << "  --filter <nombre>       Filtro de la Factory (por defecto: auto)" << std::endl;
+    std::cout << "  --out16                 Magnitud de 16 bits para entradas de 16 bits (SobelFilterHDR)" << std::endl;
+    std::cout << "  --threshold <t>         Umbral de <salida>_threshold (por defecto: 50)" << std::endl;
+    std::cout << "  --sync                  Esperar a que las salidas lleguen al disco (msync)" << std::endl;
+    std::cout << "Ejemplo: " << program << " sensor.raw bordes.raw --size 4096x3072 --depth 16" << std::endl;
+}
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+MappedImage createOutput(const std::string& path, int rows, int cols, int depth) {
+    return MappedImage::isRawPath(path) ? MappedImage::createRaw(path, rows, cols, depth)
+                                        : MappedImage::createPgm(path, rows, cols, depth);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        if (argc < 3) {
+            printUsage(argv[0]);
+            return -1;
+        }
+
+        const std::string inputPath = argv[1];
+        const std::string outputPath = argv[2];
+        std::string filterName = "auto";
+        int rawCols = 0, rawRows = 0, rawDepth = 8, plane = 0, planes = 1, threshold = 50;
+        bool out16 = false, sync = false;
+        for (int i = 3; i < argc; i++) {
+            std::string option = argv[i];
+            bool hasValue = i + 1 < argc;
+            if (option == "--out16") {
+                out16 = true;
+            } else if (option == "--sync") {
+                sync = true;
+            } else if (option == "--size" && hasValue) {
+                std::string size = argv[++i];
+                size_t x = size.find('x');
+                if (x == std::string::npos) {
+                    std::cerr << "Tamaño inválido (se espera <ancho>x<alto>): " << size << std::endl;
+                    return -1;
+                }
+                rawCols = std::stoi(size.substr(0, x));
+                rawRows = std::stoi(size.substr(x + 1));
+            } else if (option == "--depth" && hasValue) {
+                rawDepth = std::stoi(argv[++i]);
+            } else if (option == "--plane" && hasValue) {
+                plane = std::stoi(argv[++i]);
+            } else if (option == "--planes" && hasValue) {
+                planes = std::stoi(argv[++i]);
+            } else if (option == "--filter" && hasValue) {
+                filterName = argv[++i];
+            } else if (option == "--threshold" && hasValue) {
+                threshold = std::stoi(argv[++i]);
+            } else {
+                std::cerr << "Opción desconocida o sin valor: " << option << std::endl;
+                printUsage(argv[0]);
+                return -1;
+            }
+        }
+        if (rawDepth != 8 && rawDepth != 16) {
+            std::cerr << "Error: --depth debe ser 8 o 16" << std::endl;
+            return -1;
+        }
+
+        // Misma convención que sobel_filter_stream: <salida>_threshold.<ext>
+        std::string thresholdPath = outputPath;
+        size_t dotPos = thresholdPath.find_last_of('.');
+        if (dotPos != std::string::npos) {
+            thresholdPath = thresholdPath.substr(0, dotPos) + "_threshold" + thresholdPath.substr(dotPos);
+        } else {
+            thresholdPath += "_threshold";
+        }
+        // Las salidas se crean truncadas mientras la entrada sigue proyectada
+        if (MappedImage::sameFile(inputPath, outputPath) || MappedImage::sameFile(inputPath, thresholdPath)) {
+            std::cerr << "Error: la salida no puede ser el fichero de entrada " << inputPath << std::endl;
+            return -1;
+        }
+
+        auto start = std::chrono::high_resolution_clock::now();
+        MappedImage input;
+        if (MappedImage::isRawPath(inputPath)) {
+            if (rawCols <= 0 || rawRows <= 0) {
+                std::cerr << "Error: una entrada raw necesita --size <ancho>x<alto>" << std::endl;
+                return -1;
+            }
+            input = MappedImage::openRaw(inputPath, rawRows, rawCols, rawDepth == 16 ? CV_16U : CV_8U, planes);
+        } else {
+            input = MappedImage::openPgm(inputPath);
+        }
+        const cv::Mat image = input.mat(plane);
+        const bool wide = image.depth() == CV_16U;
+        if (out16 && !wide) {
+            std::cerr << "Error: --out16 requiere una entrada de 16 bits" << std::endl;
+            return -1;
+        }
+
+        MappedImage magnitude = createOutput(outputPath, image.rows, image.cols, out16 ? CV_16U : CV_8U);
+        MappedImage mask = createOutput(thresholdPath, image.rows, image.cols, CV_8U);
+        double mapMs = elapsedMs(start);
+
+        std::cout << "Imagen proyectada: " << image.cols << "x" << image.rows << " (" << (wide ? 16 : 8)
+                  << " bits, " << input.fileBytes() << " bytes)" << std::endl;
+
+        // El filtro escribe en las páginas de los ficheros de salida: los Mat
+        // ya tienen el tamaño y tipo de la salida y *Into no reserva
+        cv::Mat magnitudeView = magnitude.mat();
+        cv::Mat maskView = mask.mat();
+        start = std::chrono::high_resolution_clock::now();
+        if (out16) {
+            SobelFilterHDR hdr(SobelFilterSIMD::detectBestLevel(), MagnitudeMode::EXACT, HdrOutput::MAGNITUDE_16U);
+            hdr.applySobelInto(image, magnitudeView);
+            sobelThresholdMagnitude(magnitudeView, maskView, threshold);
+        } else {
+            auto strategy = FilterFactory::createFilter(filterName);
+            if (!strategy) {
+                std::cerr << "Error: filtro desconocido " << filterName << std::endl;
+                return -1;
+            }
+            if (!strategy->detectEdgesAndThresholdInto(image, magnitudeView, maskView, threshold)) {
+                std::cerr << "Error: no se pudo filtrar " << inputPath << std::endl;
+                return -1;
+            }
+        }
+        double filterMs = elapsedMs(start);
+
+        // Un *Into que haya reservado por su cuenta (tamaño o tipo distinto) no habrá escrito en el fichero
+        if (magnitudeView.data != magnitude.mat().data || maskView.data != mask.mat().data) {
+            std::cerr << "Error: el filtro no escribió en la salida proyectada" << std::endl;
+            return -1;
+        }
+
+        start = std::chrono::high_resolution_clock::now();
+        magnitude.close(sync);
+        mask.close(sync);
+        input.close();
+        double closeMs = elapsedMs(start);
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Proyección: " << mapMs << " ms, filtro: " << filterMs << " ms, cierre"
+                  << (sync ? " (msync)" : "") << ": " << closeMs << " ms" << std::endl;
+        std::cout << "Magnitud guardada como: " << outputPath << std::endl;
+        std::cout << "Imagen con umbral guardada como: " << thresholdPath << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
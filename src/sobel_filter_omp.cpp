@@ -16,6 +16,7 @@
 #include <cmath>
 #include <chrono>
 #include <omp.h>
+#include "image_decode.h"
 
 class SobelFilterOMP {
 private:
@@ -40,7 +41,8 @@ public:
         if (inputImage.channels() == 3) {
             cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
         } else {
-            grayImage = inputImage.clone();
+            // Ya es gris: sin copia, los hilos solo leen
+            grayImage = inputImage;
         }
         
         // Crear imagen de salida
@@ -78,7 +80,11 @@ public:
     
     // Aplica el filtro Sobel con umbral usando OpenMP
     cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
-        cv::Mat sobelResult = applySobel(inputImage);
+        return applyThreshold(applySobel(inputImage), threshold);
+    }
+    
+    // Umbral con OpenMP sobre una magnitud que ya devolvió applySobel
+    cv::Mat applyThreshold(const cv::Mat& sobelResult, int threshold = 50) {
         cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
         
         #pragma omp parallel for collapse(2) schedule(dynamic)
@@ -100,7 +106,8 @@ public:
         if (inputImage.channels() == 3) {
             cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
         } else {
-            grayImage = inputImage.clone();
+            // Ya es gris: sin copia
+            grayImage = inputImage;
         }
         
         // Crear imagen de salida
@@ -146,14 +153,22 @@ int main(int argc, char** argv) {
     std::cout << "Número de hilos configurados: " << omp_get_num_threads() << std::endl;
     
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida>" << std::endl;
+    bool compareDecode = takeDecodeReportFlag(argc, argv);
+    if (argc < 3 || argc > 4) {
+        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
         std::cout << "Ejemplo: " << argv[0] << " input.jpg output.jpg" << std::endl;
+        std::cout << "Modo de lectura (por defecto color): gray decodifica en gris, reducedN además a 1/N (JPEG)" << std::endl;
         return -1;
     }
     
     // Cargar imagen de entrada
-    cv::Mat inputImage = cv::imread(argv[1]);
+    DecodeMode decodeMode = DecodeMode::COLOR;
+    if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+        std::cerr << "Error: modo de lectura desconocido " << argv[3] << std::endl;
+        return -1;
+    }
+    double decodeMs = 0.0;
+    cv::Mat inputImage = decodeImage(argv[1], decodeMode, &decodeMs);
     if (inputImage.empty()) {
         std::cerr << "Error: No se pudo cargar la imagen " << argv[1] << std::endl;
         return -1;
@@ -161,6 +176,7 @@ int main(int argc, char** argv) {
     
     std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows 
               << " (" << inputImage.channels() << " canales)" << std::endl;
+    std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
     
     // Crear instancia del filtro Sobel con OpenMP
     SobelFilterOMP sobelFilter;
@@ -198,8 +214,8 @@ int main(int argc, char** argv) {
         std::cout << "❌ Diferencias encontradas: " << differentPixels << " píxeles" << std::endl;
     }
     
-    // Aplicar filtro con umbral para mejor visualización
-    cv::Mat thresholdedImage = sobelFilter.applySobelWithThreshold(inputImage, 50);
+    // Umbral sobre la salida paralela, sin volver a filtrar la imagen
+    cv::Mat thresholdedImage = sobelFilter.applyThreshold(outputImagePar, 50);
     
     // Guardar resultados
     if (cv::imwrite(argv[2], outputImagePar)) {
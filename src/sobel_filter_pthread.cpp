@@ -8,6 +8,11 @@
 //  Mantiene la lógica separada para facilitar la comparación
 //  y la extensibilidad. No incluye mejoras de C++ moderno
 //  para mantener el foco en el multihilo.
+//  -----------------------------------------------------------
+//  La clase SobelFilterPThread vive en sobel_filter_pthread_lib.cpp
+//  para poder reutilizarla desde el patrón Strategy. Los hilos viven
+//  en un PThreadPool propiedad del filtro y se reutilizan entre
+//  frames y entre las pasadas Sobel y umbral.
 // =============================================================
 
 #include <opencv2/opencv.hpp>
@@ -15,196 +20,9 @@
 #include <vector>
 #include <cmath>
 #include <chrono>
-#include <pthread.h>
 #include <thread>
-
-class SobelFilterPThread {
-private:
-    // Kernels del filtro Sobel
-    const std::vector<std::vector<int>> sobelX = {
-        {-1, 0, 1},
-        {-2, 0, 2},
-        {-1, 0, 1}
-    };
-    
-    const std::vector<std::vector<int>> sobelY = {
-        {-1, -2, -1},
-        { 0,  0,  0},
-        { 1,  2,  1}
-    };
-
-    // Estructura para pasar datos a los hilos
-    struct ThreadData {
-        const cv::Mat* inputImage;
-        cv::Mat* outputImage;
-        int startRow;
-        int endRow;
-        int startCol;
-        int endCol;
-        const std::vector<std::vector<int>>* sobelX;
-        const std::vector<std::vector<int>>* sobelY;
-    };
-
-    // Función que ejecuta cada hilo
-    static void* sobelThread(void* arg) {
-        ThreadData* data = static_cast<ThreadData*>(arg);
-        
-        // Convertir a escala de grises si es necesario
-        cv::Mat grayImage;
-        if (data->inputImage->channels() == 3) {
-            cv::cvtColor(*data->inputImage, grayImage, cv::COLOR_BGR2GRAY);
-        } else {
-            grayImage = data->inputImage->clone();
-        }
-        
-        // Aplicar filtro Sobel en la región asignada
-        for (int i = data->startRow; i < data->endRow; i++) {
-            for (int j = data->startCol; j < data->endCol; j++) {
-                if (i > 0 && i < grayImage.rows - 1 && j > 0 && j < grayImage.cols - 1) {
-                    int gx = 0, gy = 0;
-                    
-                    // Calcular gradientes usando los kernels
-                    for (int ki = -1; ki <= 1; ki++) {
-                        for (int kj = -1; kj <= 1; kj++) {
-                            int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
-                            gx += pixelValue * (*data->sobelX)[ki + 1][kj + 1];
-                            gy += pixelValue * (*data->sobelY)[ki + 1][kj + 1];
-                        }
-                    }
-                    
-                    // Calcular magnitud del gradiente
-                    double magnitude = std::sqrt(gx * gx + gy * gy);
-                    
-                    // Normalizar y asignar valor
-                    magnitude = std::min(255.0, magnitude);
-                    data->outputImage->at<uchar>(i, j) = static_cast<uchar>(magnitude);
-                }
-            }
-        }
-        
-        return nullptr;
-    }
-
-public:
-    // Aplica el filtro Sobel usando pThreads
-    cv::Mat applySobel(const cv::Mat& inputImage, int numThreads = 4) {
-        // Convertir a escala de grises si es necesario
-        cv::Mat grayImage;
-        if (inputImage.channels() == 3) {
-            cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
-        } else {
-            grayImage = inputImage.clone();
-        }
-        
-        // Crear imagen de salida
-        cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
-        
-        int rows = grayImage.rows;
-        int cols = grayImage.cols;
-        
-        // Crear hilos
-        std::vector<pthread_t> threads(numThreads);
-        std::vector<ThreadData> threadData(numThreads);
-        
-        // Dividir el trabajo entre hilos
-        int rowsPerThread = rows / numThreads;
-        
-        for (int t = 0; t < numThreads; t++) {
-            threadData[t].inputImage = &grayImage;
-            threadData[t].outputImage = &outputImage;
-            threadData[t].startRow = t * rowsPerThread;
-            threadData[t].endRow = (t == numThreads - 1) ? rows : (t + 1) * rowsPerThread;
-            threadData[t].startCol = 0;
-            threadData[t].endCol = cols;
-            threadData[t].sobelX = &sobelX;
-            threadData[t].sobelY = &sobelY;
-            
-            // Crear hilo
-            pthread_create(&threads[t], nullptr, sobelThread, &threadData[t]);
-        }
-        
-        // Esperar a que todos los hilos terminen
-        for (int t = 0; t < numThreads; t++) {
-            pthread_join(threads[t], nullptr);
-        }
-        
-        return outputImage;
-    }
-    
-    // Aplica el filtro Sobel con umbral usando pThreads
-    cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50, int numThreads = 4) {
-        cv::Mat sobelResult = applySobel(inputImage, numThreads);
-        cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
-        
-        // Aplicar umbral en paralelo usando std::thread (más simple para esta operación)
-        std::vector<std::thread> threads;
-        int rowsPerThread = sobelResult.rows / numThreads;
-        
-        for (int t = 0; t < numThreads; t++) {
-            int startRow = t * rowsPerThread;
-            int endRow = (t == numThreads - 1) ? sobelResult.rows : (t + 1) * rowsPerThread;
-            
-            threads.emplace_back([&sobelResult, &thresholdedImage, startRow, endRow, threshold]() {
-                for (int i = startRow; i < endRow; i++) {
-                    for (int j = 0; j < sobelResult.cols; j++) {
-                        if (sobelResult.at<uchar>(i, j) > threshold) {
-                            thresholdedImage.at<uchar>(i, j) = 255;
-                        }
-                    }
-                }
-            });
-        }
-        
-        // Esperar a que todos los hilos terminen
-        for (auto& thread : threads) {
-            thread.join();
-        }
-        
-        return thresholdedImage;
-    }
-    
-    // Versión secuencial para comparación
-    cv::Mat applySobelSequential(const cv::Mat& inputImage) {
-        // Convertir a escala de grises si es necesario
-        cv::Mat grayImage;
-        if (inputImage.channels() == 3) {
-            cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
-        } else {
-            grayImage = inputImage.clone();
-        }
-        
-        // Crear imagen de salida
-        cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
-        
-        int rows = grayImage.rows;
-        int cols = grayImage.cols;
-        
-        // Aplicar filtro Sobel secuencial
-        for (int i = 1; i < rows - 1; i++) {
-            for (int j = 1; j < cols - 1; j++) {
-                int gx = 0, gy = 0;
-                
-                // Calcular gradientes usando los kernels
-                for (int ki = -1; ki <= 1; ki++) {
-                    for (int kj = -1; kj <= 1; kj++) {
-                        int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
-                        gx += pixelValue * sobelX[ki + 1][kj + 1];
-                        gy += pixelValue * sobelY[ki + 1][kj + 1];
-                    }
-                }
-                
-                // Calcular magnitud del gradiente
-                double magnitude = std::sqrt(gx * gx + gy * gy);
-                
-                // Normalizar y asignar valor
-                magnitude = std::min(255.0, magnitude);
-                outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
-            }
-        }
-        
-        return outputImage;
-    }
-};
+#include "sobel_filter_pthread.h"
+#include "image_decode.h"
 
 int main(int argc, char** argv) {
     std::cout << "=== Filtro Sobel con pThreads ===" << std::endl;
@@ -216,14 +34,22 @@ int main(int argc, char** argv) {
     std::cout << "Número de hilos disponibles: " << numThreads << std::endl;
     
     // Verificar argumentos de línea de comandos
-    if (argc != 3) {
-        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida>" << std::endl;
+    bool compareDecode = takeDecodeReportFlag(argc, argv);
+    if (argc < 3 || argc > 4) {
+        std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
         std::cout << "Ejemplo: " << argv[0] << " input.jpg output.jpg" << std::endl;
+        std::cout << "Modo de lectura (por defecto color): gray decodifica en gris, reducedN además a 1/N (JPEG)" << std::endl;
         return -1;
     }
     
     // Cargar imagen de entrada
-    cv::Mat inputImage = cv::imread(argv[1]);
+    DecodeMode decodeMode = DecodeMode::COLOR;
+    if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+        std::cerr << "Error: modo de lectura desconocido " << argv[3] << std::endl;
+        return -1;
+    }
+    double decodeMs = 0.0;
+    cv::Mat inputImage = decodeImage(argv[1], decodeMode, &decodeMs);
     if (inputImage.empty()) {
         std::cerr << "Error: No se pudo cargar la imagen " << argv[1] << std::endl;
         return -1;
@@ -231,9 +57,10 @@ int main(int argc, char** argv) {
     
     std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows 
               << " (" << inputImage.channels() << " canales)" << std::endl;
+    std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
     
-    // Crear instancia del filtro Sobel con pThreads
-    SobelFilterPThread sobelFilter;
+    // Crear instancia del filtro Sobel con pThreads (crea el pool de hilos)
+    SobelFilterPThread sobelFilter(numThreads);
     
     // Medir tiempo de ejecución secuencial
     auto startSeq = std::chrono::high_resolution_clock::now();
@@ -243,7 +70,7 @@ int main(int argc, char** argv) {
     
     // Medir tiempo de ejecución paralela
     auto startPar = std::chrono::high_resolution_clock::now();
-    cv::Mat outputImagePar = sobelFilter.applySobel(inputImage, numThreads);
+    cv::Mat outputImagePar = sobelFilter.applySobel(inputImage);
     auto endPar = std::chrono::high_resolution_clock::now();
     auto durationPar = std::chrono::duration_cast<std::chrono::microseconds>(endPar - startPar);
     
@@ -257,6 +84,22 @@ int main(int argc, char** argv) {
     std::cout << "Speedup: " << speedup << "x" << std::endl;
     std::cout << "Eficiencia: " << (speedup / numThreads) * 100 << "%" << std::endl;
     
+    // Medir latencia por frame reutilizando el pool (simula un flujo de vídeo)
+    const int numFrames = 10;
+    auto startFrames = std::chrono::high_resolution_clock::now();
+    for (int f = 0; f < numFrames; f++) {
+        sobelFilter.applySobel(inputImage);
+    }
+    auto endFrames = std::chrono::high_resolution_clock::now();
+    auto durationFrames = std::chrono::duration_cast<std::chrono::microseconds>(endFrames - startFrames);
+    std::cout << "Latencia media por frame (" << numFrames << " frames, pool reutilizado): "
+              << durationFrames.count() / numFrames << " microsegundos" << std::endl;
+    
+    // Memoria ahorrada al convertir a gris una sola vez
+    size_t savedBytes = sobelFilter.getMemorySavedPerFrame(inputImage);
+    std::cout << "Memoria ahorrada por frame: " << savedBytes / 1024 << " KB ("
+              << sobelFilter.getNumThreads() << " copias de la imagen gris evitadas)" << std::endl;
+    
     // Verificar que los resultados son idénticos
     cv::Mat diff;
     cv::compare(outputImageSeq, outputImagePar, diff, cv::CMP_NE);
@@ -268,8 +111,8 @@ int main(int argc, char** argv) {
         std::cout << "❌ Diferencias encontradas: " << differentPixels << " píxeles" << std::endl;
     }
     
-    // Aplicar filtro con umbral para mejor visualización
-    cv::Mat thresholdedImage = sobelFilter.applySobelWithThreshold(inputImage, 50, numThreads);
+    // Umbral derivado de la salida paralela (los hilos no se lanzan otra vez)
+    cv::Mat thresholdedImage = sobelFilter.applyThreshold(outputImagePar, 50);
     
     // Guardar resultados
     if (cv::imwrite(argv[2], outputImagePar)) {
@@ -0,0 +1,155 @@
+#include "sobel_filter_pthread.h"
+#include "work_stealing_scheduler.h"
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+// Implementación de los métodos de SobelFilterPThread
+SobelFilterPThread::SobelFilterPThread(int numThreads) : pool_(numThreads) {}
+
+void* SobelFilterPThread::sobelThread(void* arg) {
+    ThreadData* data = static_cast<ThreadData*>(arg);
+    
+    // Todos los hilos leen la misma imagen gris: no se copia ni se
+    // convierte por hilo, así la memoria no crece con el número de hilos
+    const cv::Mat& grayImage = *data->grayImage;
+    
+    // Aplicar filtro Sobel en la región asignada
+    for (int i = data->startRow; i < data->endRow; i++) {
+        for (int j = data->startCol; j < data->endCol; j++) {
+            if (i > 0 && i < grayImage.rows - 1 && j > 0 && j < grayImage.cols - 1) {
+                int gx = 0, gy = 0;
+                
+                // Calcular gradientes usando los kernels
+                for (int ki = -1; ki <= 1; ki++) {
+                    for (int kj = -1; kj <= 1; kj++) {
+                        int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
+                        gx += pixelValue * (*data->sobelX)[ki + 1][kj + 1];
+                        gy += pixelValue * (*data->sobelY)[ki + 1][kj + 1];
+                    }
+                }
+                
+                if (data->binary) {
+                    // Umbral directo sin raíz: gx² + gy² contra el límite
+                    data->outputImage->at<uchar>(i, j) =
+                        (sobelEdgeMetric(gx, gy, data->mode) > data->limit) ? 255 : 0;
+                } else {
+                    // Calcular magnitud del gradiente (saturada a 255)
+                    data->outputImage->at<uchar>(i, j) = sobelMagnitude(gx, gy, data->mode);
+                }
+            }
+        }
+    }
+    
+    return nullptr;
+}
+
+size_t SobelFilterPThread::getMemorySavedPerFrame(const cv::Mat& inputImage) const {
+    size_t grayBytes = static_cast<size_t>(inputImage.rows) * inputImage.cols;
+    return grayBytes * pool_.size();
+}
+
+cv::Mat SobelFilterPThread::runBands(const cv::Mat& inputImage, bool binary, int threshold) {
+    // Convertir a escala de grises una sola vez en un buffer compartido
+    cv::Mat grayImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
+    } else {
+        // Ya es gris: los hilos leen directamente la entrada (también ROIs)
+        grayImage = inputImage;
+    }
+    
+    // Crear imagen de salida (con umbral negativo hasta los bordes son 255)
+    cv::Mat outputImage(grayImage.size(), CV_8UC1, cv::Scalar(binary && threshold < 0 ? 255 : 0));
+    int limit = sobelEdgeLimit(threshold, mode_);
+    
+    int rows = grayImage.rows;
+    int cols = grayImage.cols;
+    
+    // Bandas finas (varias por hilo) en lugar de una banda fija por hilo:
+    // si un núcleo va lento, los demás le roban las bandas pendientes
+    int numThreads = pool_.size();
+    int numBands = std::max(1, std::min(rows, numThreads * BANDS_PER_THREAD));
+    int bandRows = (rows + numBands - 1) / numBands;
+    std::vector<cv::Rect> bands = makeTileGrid(grayImage.size(), cv::Size(cols, bandRows));
+    
+    std::vector<ThreadData> threadData(bands.size());
+    for (size_t t = 0; t < bands.size(); t++) {
+        threadData[t].grayImage = &grayImage;
+        threadData[t].outputImage = &outputImage;
+        threadData[t].startRow = bands[t].y;
+        threadData[t].endRow = bands[t].y + bands[t].height;
+        threadData[t].startCol = bands[t].x;
+        threadData[t].endCol = bands[t].x + bands[t].width;
+        threadData[t].sobelX = &sobelX;
+        threadData[t].sobelY = &sobelY;
+        threadData[t].mode = mode_;
+        threadData[t].binary = binary;
+        threadData[t].limit = limit;
+    }
+    
+    // Un trabajador por hilo del pool; cada uno consume su cola y roba al acabar
+    WorkStealingScheduler scheduler(numThreads);
+    scheduler.reset(static_cast<int>(threadData.size()));
+    pool_.parallelFor(numThreads, [&scheduler, &threadData](int worker) {
+        scheduler.run(worker, [&threadData](int t) {
+            sobelThread(&threadData[t]);
+        });
+    });
+    lastSteals_ = scheduler.getSteals();
+    
+    return outputImage;
+}
+
+cv::Mat SobelFilterPThread::applySobel(const cv::Mat& inputImage) {
+    return runBands(inputImage, false, 0);
+}
+
+cv::Mat SobelFilterPThread::applySobelWithThreshold(const cv::Mat& inputImage, int threshold) {
+    // Cada hilo escribe directamente la máscara: sin raíz ni segunda pasada
+    return runBands(inputImage, true, threshold);
+}
+
+cv::Mat SobelFilterPThread::applyThreshold(const cv::Mat& magnitude, int threshold) const {
+    cv::Mat mask;
+    sobelThresholdMagnitude(magnitude, mask, threshold);
+    return mask;
+}
+
+cv::Mat SobelFilterPThread::applySobelSequential(const cv::Mat& inputImage) {
+    // Convertir a escala de grises si es necesario
+    cv::Mat grayImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
+    } else {
+        // Ya es gris: sin copia
+        grayImage = inputImage;
+    }
+    
+    // Crear imagen de salida
+    cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+    
+    int rows = grayImage.rows;
+    int cols = grayImage.cols;
+    
+    // Aplicar filtro Sobel secuencial
+    for (int i = 1; i < rows - 1; i++) {
+        for (int j = 1; j < cols - 1; j++) {
+            int gx = 0, gy = 0;
+            
+            // Calcular gradientes usando los kernels
+            for (int ki = -1; ki <= 1; ki++) {
+                for (int kj = -1; kj <= 1; kj++) {
+                    int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
+                    gx += pixelValue * sobelX[ki + 1][kj + 1];
+                    gy += pixelValue * sobelY[ki + 1][kj + 1];
+                }
+            }
+            
+            // Calcular magnitud del gradiente (saturada a 255)
+            outputImage.at<uchar>(i, j) = sobelMagnitude(gx, gy, mode_);
+        }
+    }
+    
+    return outputImage;
+}
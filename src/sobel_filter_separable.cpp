@@ -0,0 +1,175 @@
+// =============================================================
+//  SOBEL_FILTER_SEPARABLE.CPP
+//  -----------------------------------------------------------
+//  Sobel separable en dos pasadas (vertical + horizontal) con un
+//  buffer circular de tres filas en escala de grises. Los datos
+//  intermedios son de una sola fila y permanecen en caché.
+// =============================================================
+
+#include "sobel_filter_separable.h"
+#include "sobel_filter.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Buffer circular de tres filas en escala de grises
+ *
+ * Si la entrada ya es gris devuelve punteros a sus filas sin copiar.
+ * Si es BGR convierte cada fila una sola vez en uno de los tres huecos.
+ */
+class GrayRowRing {
+private:
+    const cv::Mat& input_;
+    bool convert_;
+    cv::Mat slots_[3];   // Cabeceras de fila sobre ring
+    const uchar* rows_[3] = {nullptr, nullptr, nullptr};
+
+public:
+    // ring es memoria del llamador: solo se reserva si cambia el ancho
+    GrayRowRing(const cv::Mat& input, cv::Mat& ring) : input_(input), convert_(input.channels() == 3) {
+        if (convert_) {
+            ring.create(3, input_.cols, CV_8UC1);
+            for (int s = 0; s < 3; s++) {
+                slots_[s] = ring.row(s);
+            }
+        }
+    }
+
+    // Carga la fila r en el hueco r % 3
+    void load(int r) {
+        int slot = r % 3;
+        if (!convert_) {
+            rows_[slot] = input_.ptr<uchar>(r);
+        } else {
+            // cvtColor reutiliza la memoria del hueco (mismo tamaño y tipo)
+            cv::cvtColor(input_.row(r), slots_[slot], cv::COLOR_BGR2GRAY);
+            rows_[slot] = slots_[slot].ptr<uchar>(0);
+        }
+    }
+
+    const uchar* get(int r) const { return rows_[r % 3]; }
+};
+
+/**
+ * @brief Pasada horizontal: [-1 0 1] sobre smooth y [1 2 1] sobre diff
+ *
+ * Si BINARY escribe 255/0 comparando la métrica sin raíz contra limit.
+ */
+template <MagnitudeMode M, bool BINARY>
+void horizontalPass(const int16_t* smooth, const int16_t* diff, uchar* dst, int cols, int limit) {
+    for (int j = 1; j < cols - 1; j++) {
+        int gx = smooth[j + 1] - smooth[j - 1];
+        int gy = diff[j - 1] + 2 * diff[j] + diff[j + 1];
+
+        if constexpr (BINARY) {
+            dst[j] = (sobelEdgeMetric(gx, gy, M) > limit) ? 255 : 0;
+        } else if constexpr (M == MagnitudeMode::EXACT) {
+            // gx² + gy² < 2^24: la raíz en float truncada es exacta y vectorizable
+            int magnitude = static_cast<int>(std::sqrt(static_cast<float>(gx * gx + gy * gy)));
+            dst[j] = static_cast<uchar>(std::min(255, magnitude));
+        } else {
+            dst[j] = sobelMagnitude(gx, gy, M);
+        }
+    }
+}
+
+/**
+ * @brief Aplica la pasada horizontal con el modo y tipo de salida indicados
+ */
+template <bool BINARY>
+void horizontalPassFor(MagnitudeMode mode, const int16_t* smooth, const int16_t* diff,
+                       uchar* dst, int cols, int limit) {
+    switch (mode) {
+        case MagnitudeMode::L1:
+            horizontalPass<MagnitudeMode::L1, BINARY>(smooth, diff, dst, cols, limit);
+            break;
+        case MagnitudeMode::LINF:
+            horizontalPass<MagnitudeMode::LINF, BINARY>(smooth, diff, dst, cols, limit);
+            break;
+        default:
+            horizontalPass<MagnitudeMode::EXACT, BINARY>(smooth, diff, dst, cols, limit);
+            break;
+    }
+}
+
+} // namespace
+
+void SobelFilterSeparable::process(const cv::Mat& inputImage, cv::Mat& outputImage, bool binary,
+                                   int threshold, Scratch& scratch) const {
+    if (inputImage.type() != CV_8UC1 && inputImage.type() != CV_8UC3) {
+        throw InvalidImageException("Input image must be 8-bit grayscale or BGR");
+    }
+    if (!outputImage.empty() && outputImage.datastart == inputImage.datastart) {
+        throw InvalidImageException("Output buffer must not alias the input");
+    }
+
+    int rows = inputImage.rows;
+    int cols = inputImage.cols;
+
+    // Salida reutilizada; solo el marco se rellena (con umbral negativo es 255)
+    outputImage.create(rows, cols, CV_8UC1);
+    fillSobelBorder(outputImage, sobelBorderValue(binary, threshold));
+    int limit = sobelEdgeLimit(threshold, mode_);
+    if (rows < 3 || cols < 3) {
+        return;
+    }
+
+    GrayRowRing ring(inputImage, scratch.ring);
+    ring.load(0);
+    ring.load(1);
+
+    // Filas intermedias de la pasada vertical (|valor| <= 4 * 255, cabe en int16)
+    scratch.smooth.resize(cols);   // p0 + 2 * p1 + p2   -> base de Gx
+    scratch.diff.resize(cols);     // p2 - p0            -> base de Gy
+    int16_t* smooth = scratch.smooth.data();
+    int16_t* diff = scratch.diff.data();
+
+    for (int i = 1; i < rows - 1; i++) {
+        ring.load(i + 1);
+        const uchar* p0 = ring.get(i - 1);
+        const uchar* p1 = ring.get(i);
+        const uchar* p2 = ring.get(i + 1);
+
+        // Pasada vertical: [1 2 1]^T y [-1 0 1]^T
+        for (int j = 0; j < cols; j++) {
+            smooth[j] = static_cast<int16_t>(p0[j] + 2 * p1[j] + p2[j]);
+            diff[j] = static_cast<int16_t>(p2[j] - p0[j]);
+        }
+
+        uchar* dst = outputImage.ptr<uchar>(i);
+        if (binary) {
+            horizontalPassFor<true>(mode_, smooth, diff, dst, cols, limit);
+        } else {
+            horizontalPassFor<false>(mode_, smooth, diff, dst, cols, limit);
+        }
+    }
+}
+
+void SobelFilterSeparable::applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                          Scratch& scratch) const {
+    process(inputImage, outputImage, false, 0, scratch);
+}
+
+void SobelFilterSeparable::applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                                       int threshold, Scratch& scratch) const {
+    // Máscara directa: gx² + gy² contra el umbral al cuadrado, sin raíz
+    process(inputImage, outputImage, true, threshold, scratch);
+}
+
+cv::Mat SobelFilterSeparable::applySobel(const cv::Mat& inputImage) const {
+    cv::Mat outputImage;
+    Scratch scratch;
+    process(inputImage, outputImage, false, 0, scratch);
+    return outputImage;
+}
+
+cv::Mat SobelFilterSeparable::applySobelWithThreshold(const cv::Mat& inputImage, int threshold) const {
+    cv::Mat outputImage;
+    Scratch scratch;
+    process(inputImage, outputImage, true, threshold, scratch);
+    return outputImage;
+}
@@ -0,0 +1,74 @@
+// =============================================================
+//  SOBEL_FILTER_STREAM.CPP
+//  -----------------------------------------------------------
+//  Versión en streaming para mosaicos que no caben en memoria
+//  (p. ej. ortofotos de 40k x 40k). Lee la imagen por franjas,
+//  filtra y escribe cada franja sin cargar nunca la imagen
+//  completa; la memoria depende solo del ancho y del alto de
+//  franja. Entrada y salida en PGM/PPM binario.
+// =============================================================
+
+#include "sobel_strip_stream.h"
+#include "pnm_io.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+
+int main(int argc, char** argv) {
+    try {
+        if (argc < 3 || argc > 5) {
+            std::cout << "Uso: " << argv[0] << " <entrada.pgm|ppm> <salida.pgm> [filas_por_franja] [umbral]"
+                      << std::endl;
+            std::cout << "Ejemplo: " << argv[0] << " mosaico.ppm bordes.pgm 256 50" << std::endl;
+            std::cout << "Otros formatos: convertir antes a PPM/PGM binario (p. ej. vips, ImageMagick)" << std::endl;
+            return -1;
+        }
+
+        const std::string inputPath = argv[1];
+        const std::string outputPath = argv[2];
+        const int stripRows = argc > 3 ? std::stoi(argv[3]) : SobelStripStreamer::DEFAULT_STRIP_ROWS;
+        const int threshold = argc > 4 ? std::stoi(argv[4]) : 50;
+
+        if (!PnmReader::isPnmFile(inputPath)) {
+            std::cerr << "Error: " << inputPath << " no es un PGM/PPM binario (P5/P6)" << std::endl;
+            return -1;
+        }
+
+        // Misma convención que sobel_filter_improved: <salida>_threshold.<ext>
+        std::string thresholdPath = outputPath;
+        size_t dotPos = thresholdPath.find_last_of('.');
+        if (dotPos != std::string::npos) {
+            thresholdPath = thresholdPath.substr(0, dotPos) + "_threshold" + thresholdPath.substr(dotPos);
+        } else {
+            thresholdPath += "_threshold";
+        }
+
+        PnmReader header(inputPath);
+        std::cout << "Imagen: " << header.cols() << "x" << header.rows() << " (" << header.channels()
+                  << " canales), franjas de " << stripRows << " filas" << std::endl;
+
+        SobelStripStreamer streamer(stripRows);
+        StripStreamStats stats = streamer.process(inputPath, outputPath, thresholdPath, threshold);
+
+        // Lo que ocuparía cargar todo: entrada, gris, magnitud y máscara
+        double fullImageMB = static_cast<double>(header.rows()) * header.cols() * (header.channels() + 3) /
+                             (1024.0 * 1024.0);
+        double busyMs = stats.decodeMs + stats.filterMs + stats.encodeMs;
+
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "Franjas: " << stats.strips << std::endl;
+        std::cout << "Memoria de franjas: " << stats.bufferBytes / (1024.0 * 1024.0) << " MB (imagen completa: "
+                  << fullImageMB << " MB)" << std::endl;
+        std::cout << "Lectura: " << stats.decodeMs << " ms, filtro: " << stats.filterMs
+                  << " ms, escritura: " << stats.encodeMs << " ms" << std::endl;
+        std::cout << "Total: " << stats.totalMs << " ms (solapamiento " << (busyMs / stats.totalMs) << "x)"
+                  << std::endl;
+        std::cout << "Magnitud guardada como: " << outputPath << std::endl;
+        std::cout << "Imagen con umbral guardada como: " << thresholdPath << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
@@ -0,0 +1,120 @@
+// =============================================================
+//  SOBEL_FILTER_TEMPLATE.CPP
+//  -----------------------------------------------------------
+//  Programa de ejemplo de SobelFilterTemplate: elige en tiempo de
+//  compilación la instancia según la profundidad de la imagen
+//  (8 bits, 16 bits o float) y la compara con SobelFilter, que
+//  recorre el kernel en tiempo de ejecución.
+// =============================================================
+
+#include "sobel_filter.h"
+#include "image_decode.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+namespace {
+
+// Nombre de la salida con umbral: "salida.png" -> "salida_threshold.png"
+std::string thresholdFilename(const std::string& output) {
+    size_t dotPos = output.find_last_of('.');
+    if (dotPos == std::string::npos) {
+        return output + "_threshold";
+    }
+    return output.substr(0, dotPos) + "_threshold" + output.substr(dotPos);
+}
+
+template<typename Filter>
+int run(const Filter& filter, const cv::Mat& inputImage, const std::string& output, int threshold) {
+    std::cout << "Filtro configurado: " << filter.getInfo() << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto outputImage = filter.applyFilter(inputImage);
+    auto end = std::chrono::high_resolution_clock::now();
+    if (!outputImage) {
+        throw SobelFilterException("Error al aplicar el filtro Sobel");
+    }
+    std::cout << "Tiempo " << Filter::getVariantName() << ": "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+
+    // La máscara sale de la magnitud ya calculada, sin segunda convolución
+    auto thresholdedImage = filter.applyThreshold(*outputImage, threshold);
+    if (!thresholdedImage) {
+        throw SobelFilterException("Error al aplicar el filtro con umbral");
+    }
+
+    if (!cv::imwrite(output, *outputImage)) {
+        throw SobelFilterException("No se pudo guardar la imagen de salida");
+    }
+    std::cout << "Imagen procesada guardada como: " << output << std::endl;
+
+    if (!cv::imwrite(thresholdFilename(output), *thresholdedImage)) {
+        throw SobelFilterException("No se pudo guardar la imagen con umbral");
+    }
+    std::cout << "Imagen con umbral guardada como: " << thresholdFilename(output) << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        // Verificar argumentos de línea de comandos
+        bool compareDecode = takeDecodeReportFlag(argc, argv);
+        if (argc < 3 || argc > 4) {
+            std::cout << "Uso: " << argv[0] << " <imagen_entrada> <imagen_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
+            std::cout << "Ejemplo: " << argv[0] << " input.jpg output.jpg" << std::endl;
+            std::cout << "Las imágenes de 16 bits (PNG/TIFF) se procesan con SobelFilterTemplate<uint16_t>" << std::endl;
+            std::cout << "Con modo de lectura explícito la imagen se decodifica a 8 bits" << std::endl;
+            return -1;
+        }
+
+        // Sin modo explícito no hay conversión a 8 bits: la profundidad decide la instancia
+        DecodeMode decodeMode = DecodeMode::COLOR;
+        if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+            throw InvalidImageException("Modo de lectura desconocido " + std::string(argv[3]));
+        }
+        double decodeMs = 0.0;
+        cv::Mat inputImage = argc == 4 ? decodeImage(argv[1], decodeMode, &decodeMs)
+                                       : cv::imread(argv[1], cv::IMREAD_UNCHANGED);
+        if (inputImage.empty()) {
+            throw InvalidImageException("No se pudo cargar la imagen " + std::string(argv[1]));
+        }
+        if (inputImage.channels() == 4) {
+            cv::cvtColor(inputImage, inputImage, cv::COLOR_BGRA2BGR);
+        }
+
+        std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows
+                  << " (" << inputImage.channels() << " canales)" << std::endl;
+        if (argc == 4) {
+            std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
+        }
+
+        FilterConfig config;
+        config.threshold = 50;
+
+        switch (inputImage.depth()) {
+            case CV_8U: {
+                // Referencia con el kernel recorrido en tiempo de ejecución
+                SobelFilter runtimeFilter(config);
+                auto start = std::chrono::high_resolution_clock::now();
+                runtimeFilter.applyFilter(inputImage);
+                auto end = std::chrono::high_resolution_clock::now();
+                std::cout << "Tiempo SobelFilter (kernel en ejecución): "
+                          << std::chrono::duration<double, std::milli>(end - start).count() << " ms" << std::endl;
+                return run(SobelFilterTemplate<uint8_t>(config), inputImage, argv[2], config.threshold);
+            }
+            case CV_16U:
+                // Umbral escalado al rango de 16 bits
+                return run(SobelFilterTemplate<uint16_t>(config), inputImage, argv[2], config.threshold * 257);
+            case CV_32F:
+                return run(SobelFilterTemplate<float>(config), inputImage, argv[2], config.threshold);
+            default:
+                throw InvalidImageException("Profundidad no soportada (8U, 16U o 32F)");
+        }
+
+    } catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+}
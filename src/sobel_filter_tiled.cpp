@@ -0,0 +1,190 @@
+// =============================================================
+//  SOBEL_FILTER_TILED.CPP
+//  -----------------------------------------------------------
+//  Sobel con OpenMP por bloques 2D. Cada hilo procesa bloques
+//  completos con el kernel vectorizado; el tamaño se ajusta a la
+//  L2 y el ancho es múltiplo de 64 bytes; con la salida alineada a
+//  64 bytes por fila dos hilos no comparten líneas de caché de la
+//  salida. Los bloques se reparten con el planificador de robo de
+//  trabajo.
+// =============================================================
+
+#include "sobel_filter_tiled.h"
+#include "sobel_filter.h"
+#include "cpu_features.h"
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace {
+
+// Cada fila empieza en una línea de caché propia: los bordes de bloque
+// (múltiplos de TILE_ALIGN) caen entonces en bordes de línea
+bool rowsAligned(const cv::Mat& image) {
+    return image.step % SobelFilterTiled::TILE_ALIGN == 0 &&
+           reinterpret_cast<uintptr_t>(image.data) % SobelFilterTiled::TILE_ALIGN == 0;
+}
+
+// Vista rows x cols con step múltiplo de TILE_ALIGN sobre un buffer propio
+// (se reserva solo si cambia el tamaño)
+cv::Mat& alignedOutput(SobelFilterTiled::Scratch& scratch, const cv::Size& size) {
+    if (scratch.alignedOutput.size() != size) {
+        const int align = SobelFilterTiled::TILE_ALIGN;
+        size_t step = (static_cast<size_t>(size.width) + align - 1) / align * align;
+        scratch.alignedBuffer.create(1, static_cast<int>(step * size.height + align), CV_8UC1);
+        uintptr_t base = reinterpret_cast<uintptr_t>(scratch.alignedBuffer.data);
+        uchar* data = scratch.alignedBuffer.data + (align - base % align) % align;
+        scratch.alignedOutput = cv::Mat(size, CV_8UC1, data, step);
+    }
+    return scratch.alignedOutput;
+}
+
+} // namespace
+
+SobelFilterTiled::SobelFilterTiled(int tileWidth, int tileHeight, MagnitudeMode mode)
+    : engine_(SobelFilterSIMD::detectBestLevel(), mode), tileWidth_(0), tileHeight_(0) {
+    setTileSize(tileWidth, tileHeight);
+}
+
+void SobelFilterTiled::setTileSize(int tileWidth, int tileHeight) {
+    if (tileWidth < 0 || tileHeight < 0) {
+        throw SobelFilterException("Tile size must be >= 0 (0 = auto)");
+    }
+    // Ancho redondeado a una línea de caché completa
+    tileWidth_ = (tileWidth + TILE_ALIGN - 1) / TILE_ALIGN * TILE_ALIGN;
+    tileHeight_ = tileHeight;
+}
+
+cv::Size SobelFilterTiled::getTileSize(const cv::Size& imageSize) const {
+    int alignedCols = (std::max(imageSize.width, 1) + TILE_ALIGN - 1) / TILE_ALIGN * TILE_ALIGN;
+    // Bloques anchos: el prefetcher sigue mejor filas largas que columnas estrechas
+    int width = tileWidth_ > 0 ? tileWidth_ : std::min(MAX_AUTO_TILE_WIDTH, alignedCols);
+    if (tileHeight_ > 0) {
+        return cv::Size(width, tileHeight_);
+    }
+
+    // Entrada (alto + 2 filas de halo) y salida de un bloque en media L2
+    size_t budget = CpuFeatures::get().l2CacheBytes / 2;
+    int height = static_cast<int>(budget / (2 * static_cast<size_t>(width))) - 2;
+    height = std::max(height, 8);
+
+    // Al menos 4 bloques por hilo para que el reparto dinámico equilibre
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    int tilesX = (imageSize.width + width - 1) / width;
+    int wantedRows = (4 * threads + tilesX - 1) / tilesX;
+    if (wantedRows > 1) {
+        height = std::min(height, std::max(8, (imageSize.height + wantedRows - 1) / wantedRows));
+    }
+
+    return cv::Size(width, std::min(height, std::max(imageSize.height, 1)));
+}
+
+std::vector<cv::Rect> SobelFilterTiled::makeTiles(const cv::Size& imageSize) const {
+    return makeTileGrid(imageSize, getTileSize(imageSize));
+}
+
+void SobelFilterTiled::process(const cv::Mat& inputImage, cv::Mat& outputImage, bool binary,
+                               int threshold, Scratch& scratch) const {
+    if (inputImage.type() != CV_8UC1 && inputImage.type() != CV_8UC3) {
+        throw InvalidImageException("Input image must be 8-bit grayscale or BGR");
+    }
+    if (!outputImage.empty() && outputImage.datastart == inputImage.datastart) {
+        throw InvalidImageException("Output buffer must not alias the input");
+    }
+
+    const cv::Mat* grayImage = &inputImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, scratch.gray, cv::COLOR_BGR2GRAY);
+        grayImage = &scratch.gray;
+    }
+
+    // Los hilos escriben en filas alineadas a 64 bytes: si la salida tiene
+    // un step que no es múltiplo de 64 (ancho no múltiplo de 64 en una Mat
+    // continua) se calcula en el buffer alineado y se copia al final
+    outputImage.create(inputImage.size(), CV_8UC1);
+    const bool direct = rowsAligned(outputImage);
+    cv::Mat& target = direct ? outputImage : alignedOutput(scratch, inputImage.size());
+
+    // Con umbral negativo hasta los bordes de la imagen son 255
+    fillSobelBorder(target, sobelBorderValue(binary, threshold));
+
+    cv::Size tileSize = getTileSize(inputImage.size());
+    if (scratch.imageSize != inputImage.size() || scratch.tileSize != tileSize) {
+        scratch.tiles = makeTileGrid(inputImage.size(), tileSize);
+        scratch.imageSize = inputImage.size();
+        scratch.tileSize = tileSize;
+    }
+    const std::vector<cv::Rect>& tiles = scratch.tiles;
+    const int numTiles = static_cast<int>(tiles.size());
+
+    int numThreads = 1;
+#ifdef _OPENMP
+    numThreads = std::min(omp_get_max_threads(), std::max(numTiles, 1));
+#endif
+
+    // Cada hilo empieza por un rango contiguo de bloques y roba a los demás
+    // al terminar: el planificador nunca toca píxeles sueltos
+    if (!scratch.scheduler || scratch.scheduler->getNumWorkers() != numThreads) {
+        scratch.scheduler = std::make_unique<WorkStealingScheduler>(numThreads);
+    }
+    WorkStealingScheduler& scheduler = *scratch.scheduler;
+    scheduler.reset(numTiles);
+
+    auto processTile = [&](int t) {
+        if (binary) {
+            engine_.applyThresholdRegion(*grayImage, target, tiles[t], threshold);
+        } else {
+            engine_.applyRegion(*grayImage, target, tiles[t]);
+        }
+    };
+
+    // Con un solo hilo no se abre región paralela: libgomp reserva un
+    // equipo nuevo en cada región de un hilo
+    if (numThreads == 1) {
+        scheduler.run(0, processTile);
+    } else {
+        #pragma omp parallel num_threads(numThreads)
+        {
+            int worker = 0;
+#ifdef _OPENMP
+            worker = omp_get_thread_num();
+#endif
+            scheduler.run(worker, processTile);
+        }
+    }
+
+    if (!direct) {
+        target.copyTo(outputImage);
+    }
+}
+
+void SobelFilterTiled::applySobelInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                      Scratch& scratch) const {
+    process(inputImage, outputImage, false, 0, scratch);
+}
+
+void SobelFilterTiled::applySobelWithThresholdInto(const cv::Mat& inputImage, cv::Mat& outputImage,
+                                                   int threshold, Scratch& scratch) const {
+    process(inputImage, outputImage, true, threshold, scratch);
+}
+
+cv::Mat SobelFilterTiled::applySobel(const cv::Mat& inputImage) const {
+    cv::Mat outputImage;
+    Scratch scratch;
+    process(inputImage, outputImage, false, 0, scratch);
+    return outputImage;
+}
+
+cv::Mat SobelFilterTiled::applySobelWithThreshold(const cv::Mat& inputImage, int threshold) const {
+    cv::Mat outputImage;
+    Scratch scratch;
+    process(inputImage, outputImage, true, threshold, scratch);
+    return outputImage;
+}
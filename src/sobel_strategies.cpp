@@ -7,6 +7,11 @@
 //    - Secuencial mejorada (C++ moderno)
 //    - OpenMP (multihilo)
 //    - pThreads (multihilo)
+//    - SIMD (vectorizada con SSE4.1/AVX2/AVX-512; 16 bits y float nativos)
+//    - Separable (dos pasadas 1D)
+//    - Por bloques (OpenMP con bloques 2D ajustados a la L2)
+//    - Templates (kernel y borde resueltos en compilación)
+//    - Canny (gradiente SIMD, NMS e histéresis por bandas)
 //  -----------------------------------------------------------
 //  Permite elegir el algoritmo en tiempo de ejecución y
 //  prepara la arquitectura para Android NDK/JNI.
@@ -15,13 +20,43 @@
 #include "edge_detection_strategy.h"
 #include "filter_factory.h"
 #include "sobel_filter.h"
+#include "sobel_filter_simd.h"
+#include "sobel_filter_hdr.h"
+#include "sobel_filter_pthread.h"
+#include "sobel_filter_separable.h"
+#include "sobel_filter_tiled.h"
+#include "canny_filter.h"
+#include "cpu_features.h"
 #include <chrono>
 #include <iostream>
 #include <algorithm>
+#include <type_traits>
 
 // Forward declarations para las clases existentes
 class SobelFilterOMP;
-class SobelFilterPThread;
+
+/**
+ * @brief detectGradientsInto para filtros con suavizado gaussiano opcional
+ *
+ * Sin blur se usa la pasada por defecto sobre la entrada; con blur se
+ * suaviza antes la imagen gris, igual que en applyFilter, para que los
+ * gradientes correspondan a la magnitud que devuelve detectEdges.
+ */
+template<typename Filter>
+bool detectGradientsBlurred(EdgeDetectionStrategy& strategy, const Filter& filter, const cv::Mat& input,
+                            SobelGradients& output, GradientLayout layout) {
+    if (!filter.getUseGaussianBlur() || input.depth() != CV_8U || input.channels() > 3) {
+        return strategy.EdgeDetectionStrategy::detectGradientsInto(input, output, layout);
+    }
+
+    cv::Mat gray = input;
+    if (input.channels() == 3) {
+        cv::cvtColor(input, gray, cv::COLOR_BGR2GRAY);
+    }
+    cv::Mat blurred;
+    cv::GaussianBlur(gray, blurred, cv::Size(3, 3), filter.getGaussianSigma());
+    return strategy.EdgeDetectionStrategy::detectGradientsInto(blurred, output, layout);
+}
 
 /**
  * @brief Estrategia para el filtro Sobel básico
@@ -45,17 +80,31 @@ private:
         };
 
     public:
-        cv::Mat applySobel(const cv::Mat& inputImage) {
+        MagnitudeMode mode = MagnitudeMode::EXACT;
+        
+        cv::Mat applySobel(const cv::Mat& inputImage) const {
+            return process(inputImage, false, 0);
+        }
+        
+        cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) const {
+            // Máscara directa: gx² + gy² contra el umbral al cuadrado, sin raíz
+            return process(inputImage, true, threshold);
+        }
+        
+    private:
+        cv::Mat process(const cv::Mat& inputImage, bool binary, int threshold) const {
             // Convertir a escala de grises si es necesario
             cv::Mat grayImage;
             if (inputImage.channels() == 3) {
                 cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
             } else {
-                grayImage = inputImage.clone();
+                // Ya es gris: se lee sin copiar
+                grayImage = inputImage;
             }
             
-            // Crear imagen de salida
-            cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+            // Crear imagen de salida (con umbral negativo hasta los bordes son 255)
+            cv::Mat outputImage(grayImage.size(), CV_8UC1, cv::Scalar(binary && threshold < 0 ? 255 : 0));
+            int limit = sobelEdgeLimit(threshold, mode);
             
             int rows = grayImage.rows;
             int cols = grayImage.cols;
@@ -74,31 +123,16 @@ private:
                         }
                     }
                     
-                    // Calcular magnitud del gradiente
-                    double magnitude = std::sqrt(gx * gx + gy * gy);
-                    
-                    // Normalizar y asignar valor
-                    magnitude = std::min(255.0, magnitude);
-                    outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
-                }
-            }
-            
-            return outputImage;
-        }
-        
-        cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
-            cv::Mat sobelResult = applySobel(inputImage);
-            cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
-            
-            for (int i = 0; i < sobelResult.rows; i++) {
-                for (int j = 0; j < sobelResult.cols; j++) {
-                    if (sobelResult.at<uchar>(i, j) > threshold) {
-                        thresholdedImage.at<uchar>(i, j) = 255;
+                    if (binary) {
+                        outputImage.at<uchar>(i, j) = (sobelEdgeMetric(gx, gy, mode) > limit) ? 255 : 0;
+                    } else {
+                        // Calcular magnitud del gradiente (saturada a 255)
+                        outputImage.at<uchar>(i, j) = sobelMagnitude(gx, gy, mode);
                     }
                 }
             }
             
-            return thresholdedImage;
+            return outputImage;
         }
     };
     
@@ -140,6 +174,14 @@ public:
         }
     }
     
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.mode = mode;
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.mode;
+    }
+    
     std::string getName() const override {
         return "Sobel Basic";
     }
@@ -159,6 +201,16 @@ public:
     void resetStats() override {
         last_execution_time_ = -1.0;
     }
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        return threshold ? filter_.applySobelWithThreshold(input, *threshold) : filter_.applySobel(input);
+    }
 };
 
 /**
@@ -170,7 +222,7 @@ private:
     double last_execution_time_ = -1.0;
     
 public:
-    SobelImprovedStrategy() : filter_(FilterConfig{}) {}
+    explicit SobelImprovedStrategy(const FilterConfig& config = FilterConfig{}) : filter_(config) {}
     
     std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
         try {
@@ -206,6 +258,33 @@ public:
         }
     }
     
+    // Un umbral negativo es el configurado en el filtro, no "todo borde":
+    // la máscara sale de applyThreshold para conservar ese convenio
+    bool detectEdgesAndThresholdInto(const cv::Mat& input, cv::Mat& magnitude, cv::Mat& mask,
+                                     int threshold = 128) override {
+        auto edges = detectEdges(input);
+        auto thresholded = edges ? filter_.applyThreshold(*edges, threshold) : std::nullopt;
+        if (!thresholded) {
+            return false;
+        }
+        edges->copyTo(magnitude);
+        thresholded->copyTo(mask);
+        return true;
+    }
+    
+    bool detectGradientsInto(const cv::Mat& input, SobelGradients& output,
+                             GradientLayout layout = GradientLayout::INTERLEAVED) override {
+        return detectGradientsBlurred(*this, filter_, input, output, layout);
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
     std::string getName() const override {
         return "Sobel Improved";
     }
@@ -225,6 +304,20 @@ public:
     void resetStats() override {
         last_execution_time_ = -1.0;
     }
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        auto result = threshold ? filter_.applyFilterWithThreshold(input, *threshold) : filter_.applyFilter(input);
+        if (!result) {
+            throw SobelFilterException("Sobel mejorado falló en el lote");
+        }
+        return *result;
+    }
 };
 
 /**
@@ -235,7 +328,19 @@ private:
     // Wrapper para la clase SobelFilterOMP existente
     class SobelOMPWrapper {
     public:
+        MagnitudeMode mode = MagnitudeMode::EXACT;
+        
         cv::Mat applySobel(const cv::Mat& inputImage) {
+            return process(inputImage, false, 0);
+        }
+        
+        cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
+            // Máscara directa en el mismo bucle paralelo, sin raíz ni segunda pasada
+            return process(inputImage, true, threshold);
+        }
+        
+    private:
+        cv::Mat process(const cv::Mat& inputImage, bool binary, int threshold) {
             // Implementación simplificada que usa OpenMP
             // En una implementación real, esto llamaría a la clase SobelFilterOMP
             
@@ -244,11 +349,13 @@ private:
             if (inputImage.channels() == 3) {
                 cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
             } else {
-                grayImage = inputImage.clone();
+                // Ya es gris: se lee sin copiar
+                grayImage = inputImage;
             }
             
-            // Crear imagen de salida
-            cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+            // Crear imagen de salida (con umbral negativo hasta los bordes son 255)
+            cv::Mat outputImage(grayImage.size(), CV_8UC1, cv::Scalar(binary && threshold < 0 ? 255 : 0));
+            int limit = sobelEdgeLimit(threshold, mode);
             
             int rows = grayImage.rows;
             int cols = grayImage.cols;
@@ -272,32 +379,16 @@ private:
                         }
                     }
                     
-                    // Calcular magnitud del gradiente
-                    double magnitude = std::sqrt(gx * gx + gy * gy);
-                    
-                    // Normalizar y asignar valor
-                    magnitude = std::min(255.0, magnitude);
-                    outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
-                }
-            }
-            
-            return outputImage;
-        }
-        
-        cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
-            cv::Mat sobelResult = applySobel(inputImage);
-            cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
-            
-            #pragma omp parallel for collapse(2)
-            for (int i = 0; i < sobelResult.rows; i++) {
-                for (int j = 0; j < sobelResult.cols; j++) {
-                    if (sobelResult.at<uchar>(i, j) > threshold) {
-                        thresholdedImage.at<uchar>(i, j) = 255;
+                    if (binary) {
+                        outputImage.at<uchar>(i, j) = (sobelEdgeMetric(gx, gy, mode) > limit) ? 255 : 0;
+                    } else {
+                        // Calcular magnitud del gradiente (saturada a 255)
+                        outputImage.at<uchar>(i, j) = sobelMagnitude(gx, gy, mode);
                     }
                 }
             }
             
-            return thresholdedImage;
+            return outputImage;
         }
     };
     
@@ -339,6 +430,14 @@ public:
         }
     }
     
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.mode = mode;
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.mode;
+    }
+    
     std::string getName() const override {
         return "Sobel OpenMP";
     }
@@ -365,82 +464,108 @@ public:
  */
 class SobelPThreadStrategy : public EdgeDetectionStrategy {
 private:
-    // Wrapper para la clase SobelFilterPThread existente
-    class SobelPThreadWrapper {
-    public:
-        cv::Mat applySobel(const cv::Mat& inputImage) {
-            // Implementación simplificada que simula pThreads
-            // En una implementación real, esto llamaría a la clase SobelFilterPThread
-            
-            // Convertir a escala de grises si es necesario
-            cv::Mat grayImage;
-            if (inputImage.channels() == 3) {
-                cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
-            } else {
-                grayImage = inputImage.clone();
-            }
-            
-            // Crear imagen de salida
-            cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+    // Motor multihilo real: el pool de hilos vive con la estrategia
+    SobelFilterPThread filter_;
+    double last_execution_time_ = -1.0;
+    
+public:
+    /**
+     * @brief Constructor
+     * @param numThreads Número de hilos del pool (si es <= 0 usa hardware_concurrency)
+     */
+    explicit SobelPThreadStrategy(int numThreads = 0) : filter_(numThreads) {}
+    
+    std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
             
-            int rows = grayImage.rows;
-            int cols = grayImage.cols;
+            cv::Mat result = filter_.applySobel(input);
             
-            // Aplicar filtro Sobel (simulación de pThreads)
-            for (int i = 1; i < rows - 1; i++) {
-                for (int j = 1; j < cols - 1; j++) {
-                    int gx = 0, gy = 0;
-                    
-                    // Kernels del filtro Sobel
-                    const int sobelX[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
-                    const int sobelY[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
-                    
-                    // Calcular gradientes usando los kernels
-                    for (int ki = -1; ki <= 1; ki++) {
-                        for (int kj = -1; kj <= 1; kj++) {
-                            int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
-                            gx += pixelValue * sobelX[ki + 1][kj + 1];
-                            gy += pixelValue * sobelY[ki + 1][kj + 1];
-                        }
-                    }
-                    
-                    // Calcular magnitud del gradiente
-                    double magnitude = std::sqrt(gx * gx + gy * gy);
-                    
-                    // Normalizar y asignar valor
-                    magnitude = std::min(255.0, magnitude);
-                    outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
-                }
-            }
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
             
-            return outputImage;
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel pThreads: " << e.what() << std::endl;
+            return std::nullopt;
         }
-        
-        cv::Mat applySobelWithThreshold(const cv::Mat& inputImage, int threshold = 50) {
-            cv::Mat sobelResult = applySobel(inputImage);
-            cv::Mat thresholdedImage = cv::Mat::zeros(sobelResult.size(), CV_8UC1);
+    }
+    
+    std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
             
-            for (int i = 0; i < sobelResult.rows; i++) {
-                for (int j = 0; j < sobelResult.cols; j++) {
-                    if (sobelResult.at<uchar>(i, j) > threshold) {
-                        thresholdedImage.at<uchar>(i, j) = 255;
-                    }
-                }
-            }
+            cv::Mat result = filter_.applySobelWithThreshold(input, threshold);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
             
-            return thresholdedImage;
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel pThreads con umbral: " << e.what() << std::endl;
+            return std::nullopt;
         }
-    };
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
+    std::string getName() const override {
+        return "Sobel pThreads";
+    }
+    
+    std::string getInfo() const override {
+        return "Sobel pThreads - Control manual de hilos con pThreads (" + 
+               std::to_string(filter_.getNumThreads()) + " hilos, pool persistente)";
+    }
+    
+    bool isAvailable() const override {
+        return true;
+    }
+    
+    double getLastExecutionTime() const override {
+        return last_execution_time_;
+    }
     
-    SobelPThreadWrapper filter_;
+    void resetStats() override {
+        last_execution_time_ = -1.0;
+    }
+}; 
+
+/**
+ * @brief Estrategia para el filtro Sobel vectorizado (SSE4.1/AVX2/AVX-512)
+ *
+ * Produce exactamente la misma salida que SobelBasicStrategy, por lo
+ * que puede usarse como reemplazo directo. Por defecto usa la mejor
+ * variante que soporta la CPU (detectada con cpuid).
+ */
+class SobelSIMDStrategy : public EdgeDetectionStrategy {
+private:
+    SobelFilterSIMD filter_;
+    SobelFilterHDR hdr_;    // Entradas CV_16UC1/CV_32FC1, salida normalizada a 8 bits
+    cv::Mat gray_;      // Conversión a gris reutilizada por detectEdgesInto
     double last_execution_time_ = -1.0;
     
+    static bool isHighDynamicRange(const cv::Mat& input) {
+        return SobelFilterHDR::isSupportedType(input.type());
+    }
+    
 public:
+    explicit SobelSIMDStrategy(SimdLevel level = SobelFilterSIMD::detectBestLevel())
+        : filter_(level), hdr_(level) {}
+    
     std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
         try {
             auto start = std::chrono::high_resolution_clock::now();
             
-            cv::Mat result = filter_.applySobel(input);
+            cv::Mat result = isHighDynamicRange(input) ? hdr_.applySobel(input) : filter_.applySobel(input);
             
             auto end = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -448,7 +573,7 @@ public:
             
             return result;
         } catch (const std::exception& e) {
-            std::cerr << "Error en Sobel pThreads: " << e.what() << std::endl;
+            std::cerr << "Error en Sobel SIMD: " << e.what() << std::endl;
             return std::nullopt;
         }
     }
@@ -457,7 +582,8 @@ public:
         try {
             auto start = std::chrono::high_resolution_clock::now();
             
-            cv::Mat result = filter_.applySobelWithThreshold(input, threshold);
+            cv::Mat result = isHighDynamicRange(input) ? hdr_.applySobelWithThreshold(input, threshold)
+                                                       : filter_.applySobelWithThreshold(input, threshold);
             
             auto end = std::chrono::high_resolution_clock::now();
             auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
@@ -465,17 +591,107 @@ public:
             
             return result;
         } catch (const std::exception& e) {
-            std::cerr << "Error en Sobel pThreads con umbral: " << e.what() << std::endl;
+            std::cerr << "Error en Sobel SIMD con umbral: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    bool detectEdgesInto(const cv::Mat& input, cv::Mat& output) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            if (isHighDynamicRange(input)) {
+                hdr_.applySobelInto(input, output);
+            } else {
+                filter_.applySobelInto(input, output, gray_);
+            }
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel SIMD: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    bool detectEdgesWithThresholdInto(const cv::Mat& input, cv::Mat& output, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            if (isHighDynamicRange(input)) {
+                hdr_.applySobelWithThresholdInto(input, output, threshold);
+            } else {
+                filter_.applySobelWithThresholdInto(input, output, threshold, gray_);
+            }
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel SIMD con umbral: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    bool detectGradientsInto(const cv::Mat& input, SobelGradients& output,
+                             GradientLayout layout = GradientLayout::INTERLEAVED) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            // Gx/Gy salen de los mismos registros que la magnitud
+            filter_.applyGradientsInto(input, output, layout, gray_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel SIMD (gradientes): " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    std::optional<EdgeBitmap> detectEdgesPacked(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            // Empaqueta fila a fila: no se escribe la máscara de bytes completa
+            EdgeBitmap result = filter_.applySobelPacked(input, threshold);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel SIMD empaquetado: " << e.what() << std::endl;
             return std::nullopt;
         }
     }
     
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+        hdr_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
     std::string getName() const override {
-        return "Sobel pThreads";
+        return "Sobel SIMD";
     }
     
     std::string getInfo() const override {
-        return "Sobel pThreads - Control manual de hilos con pThreads";
+        return "Sobel SIMD - Kernel vectorizado (variante: " + 
+               SobelFilterSIMD::levelToString(filter_.getLevel()) + 
+               ", CPU: " + CpuFeatures::get().toString() + ")";
     }
     
     bool isAvailable() const override {
@@ -489,4 +705,530 @@ public:
     void resetStats() override {
         last_execution_time_ = -1.0;
     }
-}; 
\ No newline at end of file
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        if (isHighDynamicRange(input)) {
+            return threshold ? hdr_.applySobelWithThreshold(input, *threshold) : hdr_.applySobel(input);
+        }
+        return threshold ? filter_.applySobelWithThreshold(input, *threshold) : filter_.applySobel(input);
+    }
+};
+
+/**
+ * @brief Estrategia para el filtro Sobel separable en dos pasadas
+ *
+ * Misma salida que SobelBasicStrategy; sirve para comparar la
+ * descomposición [1 2 1] x [-1 0 1] frente a los kernels 3x3 directos.
+ */
+class SobelSeparableStrategy : public EdgeDetectionStrategy {
+private:
+    SobelFilterSeparable filter_;
+    SobelFilterSeparable::Scratch scratch_;   // Reutilizado por detectEdgesInto
+    double last_execution_time_ = -1.0;
+    
+public:
+    std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = filter_.applySobel(input);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel separable: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = filter_.applySobelWithThreshold(input, threshold);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel separable con umbral: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    bool detectEdgesInto(const cv::Mat& input, cv::Mat& output) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            filter_.applySobelInto(input, output, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel separable: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    bool detectEdgesWithThresholdInto(const cv::Mat& input, cv::Mat& output, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            filter_.applySobelWithThresholdInto(input, output, threshold, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel separable con umbral: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
+    std::string getName() const override {
+        return "Sobel Separable";
+    }
+    
+    std::string getInfo() const override {
+        return "Sobel Separable - Dos pasadas 1D con buffer circular de 3 filas";
+    }
+    
+    bool isAvailable() const override {
+        return true;
+    }
+    
+    double getLastExecutionTime() const override {
+        return last_execution_time_;
+    }
+    
+    void resetStats() override {
+        last_execution_time_ = -1.0;
+    }
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        return threshold ? filter_.applySobelWithThreshold(input, *threshold) : filter_.applySobel(input);
+    }
+};
+
+/**
+ * @brief Estrategia OpenMP por bloques 2D ajustados a la caché
+ *
+ * Alternativa a SobelOMPStrategy (collapse(2) por píxel): cada hilo
+ * procesa bloques completos con el kernel SIMD y el ancho de bloque es
+ * múltiplo de 64 bytes. Misma salida que SobelSIMDStrategy.
+ */
+class SobelTiledStrategy : public EdgeDetectionStrategy {
+private:
+    SobelFilterTiled filter_;
+    SobelFilterTiled::Scratch scratch_;   // Reutilizado por detectEdgesInto
+    double last_execution_time_ = -1.0;
+    
+public:
+    explicit SobelTiledStrategy(int tileWidth = 0, int tileHeight = 0)
+        : filter_(tileWidth, tileHeight) {}
+    
+    std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = filter_.applySobel(input);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel por bloques: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = filter_.applySobelWithThreshold(input, threshold);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel por bloques con umbral: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    bool detectEdgesInto(const cv::Mat& input, cv::Mat& output) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            filter_.applySobelInto(input, output, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel por bloques: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    bool detectEdgesWithThresholdInto(const cv::Mat& input, cv::Mat& output, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            filter_.applySobelWithThresholdInto(input, output, threshold, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel por bloques con umbral: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
+    /**
+     * @brief Cambia el tamaño de bloque (0 = automático según la L2)
+     */
+    void setTileSize(int tileWidth, int tileHeight) {
+        filter_.setTileSize(tileWidth, tileHeight);
+    }
+    
+    std::string getName() const override {
+        return "Sobel Tiled";
+    }
+    
+    std::string getInfo() const override {
+        return "Sobel Tiled - OpenMP por bloques 2D (kernel: " +
+               SobelFilterSIMD::levelToString(filter_.getLevel()) +
+               ", L2: " + std::to_string(CpuFeatures::get().l2CacheBytes / 1024) + " KB)";
+    }
+    
+    bool isAvailable() const override {
+        return true;
+    }
+    
+    double getLastExecutionTime() const override {
+        return last_execution_time_;
+    }
+    
+    void resetStats() override {
+        last_execution_time_ = -1.0;
+    }
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        // Imagen completa en el hilo actual con el mismo kernel que usan los bloques
+        const SobelFilterSIMD& engine = filter_.getEngine();
+        return threshold ? engine.applySobelWithThreshold(input, *threshold) : engine.applySobel(input);
+    }
+};
+
+/**
+ * @brief Estrategia para SobelFilterTemplate sobre imágenes de 8 bits
+ *
+ * Una instancia por combinación de kernel y política de borde. Con 3x3 y
+ * BorderSkip la salida es idéntica a SobelImprovedStrategy, lo que
+ * permite medir qué aporta resolver el kernel en tiempo de compilación.
+ */
+template<int KernelSize, typename Border>
+class SobelTemplateStrategy : public EdgeDetectionStrategy {
+private:
+    SobelFilterTemplate<uint8_t, KernelSize, Border> filter_;
+    double last_execution_time_ = -1.0;
+    
+public:
+    explicit SobelTemplateStrategy(const FilterConfig& config = FilterConfig{}) : filter_(config) {}
+    
+    std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            auto result = filter_.applyFilter(input);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel con templates: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            auto result = filter_.applyFilterWithThreshold(input, threshold);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Sobel con templates con umbral: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    // Igual que en SobelImprovedStrategy: umbral negativo = el de la configuración
+    bool detectEdgesAndThresholdInto(const cv::Mat& input, cv::Mat& magnitude, cv::Mat& mask,
+                                     int threshold = 128) override {
+        auto edges = detectEdges(input);
+        auto thresholded = edges ? filter_.applyThreshold(*edges, threshold) : std::nullopt;
+        if (!thresholded) {
+            return false;
+        }
+        edges->copyTo(magnitude);
+        thresholded->copyTo(mask);
+        return true;
+    }
+    
+    // Gx/Gy en CV_16S solo tienen sentido para el kernel 3x3 sin borde calculado
+    bool detectGradientsInto(const cv::Mat& input, SobelGradients& output,
+                             GradientLayout layout = GradientLayout::INTERLEAVED) override {
+        if constexpr (KernelSize == 3 && std::is_same_v<Border, BorderSkip>) {
+            return detectGradientsBlurred(*this, filter_, input, output, layout);
+        } else {
+            std::cerr << "Error en " << getName() << ": gradientes solo con kernel 3x3 y borde skip" << std::endl;
+            return false;
+        }
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
+    std::string getName() const override {
+        return "Sobel Template " + std::to_string(KernelSize) + "x" + std::to_string(KernelSize) +
+               " " + Border::NAME;
+    }
+    
+    std::string getInfo() const override {
+        return "Sobel Template - " + filter_.getInfo();
+    }
+    
+    bool isAvailable() const override {
+        return true;
+    }
+    
+    double getLastExecutionTime() const override {
+        return last_execution_time_;
+    }
+    
+    void resetStats() override {
+        last_execution_time_ = -1.0;
+    }
+    
+protected:
+    // Sin estado mutable compartido: admite lotes repartidos por imágenes
+    bool supportsSerialBatch() const override {
+        return true;
+    }
+    
+    cv::Mat detectEdgesSerial(const cv::Mat& input, std::optional<int> threshold) const override {
+        auto result = threshold ? filter_.applyFilterWithThreshold(input, *threshold) : filter_.applyFilter(input);
+        if (!result) {
+            throw SobelFilterException("Sobel con templates falló en el lote");
+        }
+        return *result;
+    }
+};
+
+/**
+ * @brief Estrategia para el detector de Canny (CannyFilter)
+ *
+ * detectEdges usa los umbrales configurados (50/150 por defecto). Con
+ * detectEdgesWithThreshold el umbral pasa a ser el alto y el bajo se
+ * escala para mantener la misma proporción low/high.
+ */
+class CannyStrategy : public EdgeDetectionStrategy {
+private:
+    CannyFilter filter_;
+    CannyFilter::Scratch scratch_;   // Reutilizado por las variantes Into
+    double last_execution_time_ = -1.0;
+    
+    CannyFilter withHighThreshold(int threshold) const {
+        CannyFilter filter = filter_;
+        int high = std::max(threshold, 0);
+        int low = filter_.getHighThreshold() > 0
+                      ? high * filter_.getLowThreshold() / filter_.getHighThreshold()
+                      : 0;
+        filter.setThresholds(low, high);
+        return filter;
+    }
+    
+public:
+    explicit CannyStrategy(int lowThreshold = 50, int highThreshold = 150)
+        : filter_(lowThreshold, highThreshold) {}
+    
+    std::optional<cv::Mat> detectEdges(const cv::Mat& input) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = filter_.applyCanny(input);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Canny: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    std::optional<cv::Mat> detectEdgesWithThreshold(const cv::Mat& input, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            cv::Mat result = withHighThreshold(threshold).applyCanny(input);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return result;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Canny con umbral: " << e.what() << std::endl;
+            return std::nullopt;
+        }
+    }
+    
+    bool detectEdgesInto(const cv::Mat& input, cv::Mat& output) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            filter_.applyCannyInto(input, output, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Canny: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    bool detectEdgesWithThresholdInto(const cv::Mat& input, cv::Mat& output, int threshold = 128) override {
+        try {
+            auto start = std::chrono::high_resolution_clock::now();
+            
+            withHighThreshold(threshold).applyCannyInto(input, output, scratch_);
+            
+            auto end = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end - start);
+            last_execution_time_ = duration.count() / 1000.0;
+            
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Error en Canny con umbral: " << e.what() << std::endl;
+            return false;
+        }
+    }
+    
+    // La máscara es otra histéresis con umbral alto distinto, no un umbral
+    // de la salida: hacen falta las dos pasadas
+    bool detectEdgesAndThresholdInto(const cv::Mat& input, cv::Mat& magnitude, cv::Mat& mask,
+                                     int threshold = 128) override {
+        return detectEdgesInto(input, magnitude) && detectEdgesWithThresholdInto(input, mask, threshold);
+    }
+    
+    void setMagnitudeMode(MagnitudeMode mode) override {
+        filter_.setMagnitudeMode(mode);
+    }
+    
+    MagnitudeMode getMagnitudeMode() const override {
+        return filter_.getMagnitudeMode();
+    }
+    
+    /**
+     * @brief Cambia los umbrales de histéresis (0 <= low <= high)
+     */
+    void setThresholds(int lowThreshold, int highThreshold) {
+        filter_.setThresholds(lowThreshold, highThreshold);
+    }
+    
+    std::string getName() const override {
+        return "Canny";
+    }
+    
+    std::string getInfo() const override {
+        return "Canny - Gradiente SIMD, NMS por bandas e histéresis por pila (umbrales " +
+               std::to_string(filter_.getLowThreshold()) + "/" + std::to_string(filter_.getHighThreshold()) +
+               ", kernel: " + SobelFilterSIMD::levelToString(filter_.getLevel()) + ")";
+    }
+    
+    bool isAvailable() const override {
+        return true;
+    }
+    
+    double getLastExecutionTime() const override {
+        return last_execution_time_;
+    }
+    
+    void resetStats() override {
+        last_execution_time_ = -1.0;
+    }
+};
@@ -0,0 +1,219 @@
+// =============================================================
+//  SOBEL_STRIP_STREAM.CPP
+//  -----------------------------------------------------------
+//  Pipeline de tres etapas para imágenes gigantes: un hilo lee
+//  franjas con halo, el hilo llamante las filtra y otro hilo
+//  escribe las filas resultantes. Las franjas son un conjunto
+//  fijo de buffers que circula por colas acotadas.
+// =============================================================
+
+#include "sobel_strip_stream.h"
+#include "sobel_filter.h"
+#include "bounded_queue.h"
+#include "pnm_io.h"
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Buffer de una franja: entrada con halo y salidas del mismo alto
+ */
+struct Strip {
+    cv::Mat gray;           // (stripRows + 2) x cols; se usan inputRows filas
+    cv::Mat magnitude;
+    cv::Mat binary;
+    int inputRows = 0;      // Filas de entrada válidas (halo incluido)
+    int haloTop = 0;        // 1 si la primera fila es halo
+    int outputRows = 0;     // Filas de salida de la franja
+};
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+SobelStripStreamer::SobelStripStreamer(int stripRows, int queueDepth, MagnitudeMode mode)
+    : filter_(0, 0, mode), stripRows_(DEFAULT_STRIP_ROWS), queueDepth_(DEFAULT_QUEUE_DEPTH) {
+    setStripRows(stripRows);
+    setQueueDepth(queueDepth);
+}
+
+void SobelStripStreamer::setStripRows(int rows) {
+    if (rows < 1) {
+        throw SobelFilterException("Strip rows must be positive");
+    }
+    stripRows_ = rows;
+}
+
+void SobelStripStreamer::setQueueDepth(int depth) {
+    if (depth < 1) {
+        throw SobelFilterException("Queue depth must be positive");
+    }
+    queueDepth_ = depth;
+}
+
+StripStreamStats SobelStripStreamer::process(const std::string& inputPath, const std::string& outputPath,
+                                             const std::string& thresholdPath, int threshold) const {
+    if (outputPath.empty() && thresholdPath.empty()) {
+        throw SobelFilterException("Streaming needs at least one output file");
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+
+    // Apertura en el hilo llamante: los errores de formato salen antes de lanzar hilos
+    PnmReader reader(inputPath);
+    const int rows = reader.rows();
+    const int cols = reader.cols();
+    std::optional<PnmWriter> magnitudeWriter, thresholdWriter;
+    if (!outputPath.empty()) {
+        magnitudeWriter.emplace(outputPath, rows, cols);
+    }
+    if (!thresholdPath.empty()) {
+        thresholdWriter.emplace(thresholdPath, rows, cols);
+    }
+
+    StripStreamStats stats;
+    std::vector<Strip> strips(queueDepth_);
+    for (Strip& strip : strips) {
+        strip.gray.create(std::min(stripRows_ + 2, rows), cols, CV_8UC1);
+        stats.bufferBytes += strip.gray.total() * (1 + (magnitudeWriter ? 1 : 0) + (thresholdWriter ? 1 : 0));
+    }
+    // Conversión RGB del lector y las dos filas que se arrastran entre franjas
+    stats.bufferBytes += static_cast<size_t>(cols) * (reader.channels() == 3 ? 3 * stripRows_ + 2 : 2);
+
+    BoundedQueue<Strip*> freeStrips(strips.size());
+    BoundedQueue<Strip*> decoded(strips.size());
+    BoundedQueue<Strip*> filtered(strips.size());
+    for (Strip& strip : strips) {
+        freeStrips.push(&strip);
+    }
+
+    // El primer error cierra todas las colas para que ninguna etapa se quede esperando
+    std::mutex errorMutex;
+    std::exception_ptr error;
+    auto fail = [&](std::exception_ptr e) {
+        {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) {
+                error = e;
+            }
+        }
+        freeStrips.close();
+        decoded.close();
+        filtered.close();
+    };
+
+    std::thread decoder([&] {
+        try {
+            cv::Mat carry(2, cols, CV_8UC1);   // Filas r0 - 1 y r0 de la franja siguiente
+            for (int firstRow = 0; firstRow < rows; firstRow += stripRows_) {
+                Strip* strip;
+                if (!freeStrips.pop(strip)) {
+                    return;
+                }
+                auto stageStart = std::chrono::high_resolution_clock::now();
+                const int lastRow = std::min(firstRow + stripRows_, rows);
+                strip->haloTop = firstRow > 0 ? 1 : 0;
+                strip->outputRows = lastRow - firstRow;
+                strip->inputRows = strip->haloTop + strip->outputRows + (lastRow < rows ? 1 : 0);
+
+                // La franja anterior ya leyó hasta la fila firstRow (su halo inferior)
+                int filled = 0;
+                if (strip->haloTop) {
+                    cv::Mat halo = strip->gray.rowRange(0, 2);
+                    carry.copyTo(halo);
+                    filled = 2;
+                }
+                if (filled < strip->inputRows) {
+                    cv::Mat pending = strip->gray.rowRange(filled, strip->inputRows);
+                    reader.readGrayRows(pending);
+                }
+                if (lastRow < rows) {
+                    strip->gray.rowRange(strip->inputRows - 2, strip->inputRows).copyTo(carry);
+                }
+                stats.decodeMs += elapsedMs(stageStart);
+
+                if (!decoded.push(strip)) {
+                    return;
+                }
+            }
+            decoded.close();
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    });
+
+    std::thread encoder([&] {
+        try {
+            Strip* strip;
+            while (filtered.pop(strip)) {
+                auto stageStart = std::chrono::high_resolution_clock::now();
+                const int first = strip->haloTop;
+                const int last = strip->haloTop + strip->outputRows;
+                if (magnitudeWriter) {
+                    magnitudeWriter->writeRows(strip->magnitude.rowRange(first, last));
+                }
+                if (thresholdWriter) {
+                    thresholdWriter->writeRows(strip->binary.rowRange(first, last));
+                }
+                stats.encodeMs += elapsedMs(stageStart);
+                stats.strips++;
+
+                if (!freeStrips.push(strip)) {
+                    return;
+                }
+            }
+        } catch (...) {
+            fail(std::current_exception());
+        }
+    });
+
+    // Filtro en el hilo llamante (SobelFilterTiled reparte cada franja entre los hilos de OpenMP)
+    try {
+        SobelFilterTiled::Scratch scratch;
+        Strip* strip;
+        while (decoded.pop(strip)) {
+            auto stageStart = std::chrono::high_resolution_clock::now();
+            cv::Mat input = strip->gray.rowRange(0, strip->inputRows);
+            if (magnitudeWriter) {
+                filter_.applySobelInto(input, strip->magnitude, scratch);
+            }
+            if (thresholdWriter && magnitudeWriter) {
+                // Con las dos salidas la máscara se deriva de la magnitud: una sola convolución
+                sobelThresholdMagnitude(strip->magnitude, strip->binary, threshold);
+            } else if (thresholdWriter) {
+                filter_.applySobelWithThresholdInto(input, strip->binary, threshold, scratch);
+            }
+            stats.filterMs += elapsedMs(stageStart);
+
+            if (!filtered.push(strip)) {
+                break;
+            }
+        }
+        filtered.close();
+    } catch (...) {
+        fail(std::current_exception());
+    }
+
+    decoder.join();
+    encoder.join();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    if (magnitudeWriter) {
+        magnitudeWriter->close();
+    }
+    if (thresholdWriter) {
+        thresholdWriter->close();
+    }
+    stats.totalMs = elapsedMs(start);
+    return stats;
+}
@@ -4,6 +4,8 @@
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <sstream>
+#include "image_decode.h"
 
 /**
  * @brief Programa de prueba para demostrar Strategy y Factory patterns
@@ -19,14 +21,22 @@ int main(int argc, char** argv) {
         std::cout << std::endl;
         
         // Verificar argumentos
-        if (argc != 3) {
-            std::cout << "Uso: " << argv[0] << " <imagen_entrada> <directorio_salida>" << std::endl;
+        bool compareDecode = takeDecodeReportFlag(argc, argv);
+        if (argc < 3 || argc > 4) {
+            std::cout << "Uso: " << argv[0] << " <imagen_entrada> <directorio_salida> [color|gray|reduced2|reduced4|reduced8] [--decode-report]" << std::endl;
             std::cout << "Ejemplo: " << argv[0] << " test_image.jpg output/" << std::endl;
+            std::cout << "Modo de lectura (por defecto color): gray decodifica en gris, reducedN además a 1/N (JPEG)" << std::endl;
             return -1;
         }
         
         // Cargar imagen de entrada
-        cv::Mat inputImage = cv::imread(argv[1]);
+        DecodeMode decodeMode = DecodeMode::COLOR;
+        if (argc == 4 && !stringToDecodeMode(argv[3], decodeMode)) {
+            std::cerr << "Error: modo de lectura desconocido " << argv[3] << std::endl;
+            return -1;
+        }
+        double decodeMs = 0.0;
+        cv::Mat inputImage = decodeImage(argv[1], decodeMode, &decodeMs);
         if (inputImage.empty()) {
             std::cerr << "Error: No se pudo cargar la imagen " << argv[1] << std::endl;
             return -1;
@@ -34,6 +44,7 @@ int main(int argc, char** argv) {
         
         std::cout << "Imagen cargada: " << inputImage.cols << "x" << inputImage.rows 
                   << " (" << inputImage.channels() << " canales)" << std::endl;
+        std::cout << decodeReport(argv[1], decodeMode, decodeMs, compareDecode) << std::endl;
         std::cout << std::endl;
         
         // Mostrar información de filtros disponibles
@@ -64,12 +75,13 @@ int main(int argc, char** argv) {
             std::cout << "✅ Filtro creado exitosamente" << std::endl;
             std::cout << "Info: " << filter->getInfo() << std::endl;
             
-            // Probar detección de bordes
+            // Probar detección de bordes (solo la magnitud entra en el tiempo)
+            cv::Mat result, thresholdResult;
             auto start = std::chrono::high_resolution_clock::now();
-            auto result = filter->detectEdges(inputImage);
+            bool processed = filter->detectEdgesInto(inputImage, result);
             auto end = std::chrono::high_resolution_clock::now();
             
-            if (!result) {
+            if (!processed) {
                 std::cerr << "❌ Error: No se pudo procesar la imagen con " << filterName << std::endl;
                 continue;
             }
@@ -81,9 +93,10 @@ int main(int argc, char** argv) {
             std::cout << "Tiempo: " << std::fixed << std::setprecision(2) << time_ms << " ms" << std::endl;
             std::cout << "Tiempo interno: " << filter->getLastExecutionTime() << " ms" << std::endl;
             
-            // Probar detección con umbral
-            auto thresholdResult = filter->detectEdgesWithThreshold(inputImage, 50);
-            if (thresholdResult) {
+            // Probar detección con umbral, fuera de la medida para que los
+            // tiempos sigan siendo comparables entre estrategias
+            bool thresholded = filter->detectEdgesWithThresholdInto(inputImage, thresholdResult, 50);
+            if (thresholded) {
                 std::cout << "✅ Umbralización exitosa" << std::endl;
             } else {
                 std::cerr << "❌ Error en umbralización" << std::endl;
@@ -93,13 +106,13 @@ int main(int argc, char** argv) {
             std::string outputDir = argv[2];
             std::string baseFilename = outputDir + "/" + filterName;
             
-            if (cv::imwrite(baseFilename + "_result.jpg", *result)) {
+            if (cv::imwrite(baseFilename + "_result.jpg", result)) {
                 std::cout << "✅ Resultado guardado: " << baseFilename + "_result.jpg" << std::endl;
             } else {
                 std::cerr << "❌ Error al guardar resultado" << std::endl;
             }
             
-            if (thresholdResult && cv::imwrite(baseFilename + "_threshold.jpg", *thresholdResult)) {
+            if (thresholded && cv::imwrite(baseFilename + "_threshold.jpg", thresholdResult)) {
                 std::cout << "✅ Umbral guardado: " << baseFilename + "_threshold.jpg" << std::endl;
             } else {
                 std::cerr << "❌ Error al guardar umbral" << std::endl;
@@ -133,6 +146,18 @@ int main(int argc, char** argv) {
         
         std::cout << std::endl;
         
+        // Selección automática según la CPU
+        std::cout << "Creando filtro por nombre: auto" << std::endl;
+        auto autoFilter = FilterFactory::createFilter("auto");
+        if (autoFilter) {
+            std::cout << "✅ Filtro creado: " << autoFilter->getName() << std::endl;
+            std::cout << "Info: " << autoFilter->getInfo() << std::endl;
+        } else {
+            std::cerr << "❌ Error al crear filtro automático" << std::endl;
+        }
+        
+        std::cout << std::endl;
+        
         // Comparación de rendimiento
         std::cout << "=== COMPARACIÓN DE RENDIMIENTO ===" << std::endl;
         std::cout << std::endl;
@@ -157,6 +182,96 @@ int main(int argc, char** argv) {
             }
         }
         
+        std::cout << std::endl;
+        
+        // Comparación de modos de magnitud (con umbral, donde L1/L∞ bastan)
+        std::cout << "=== MODOS DE MAGNITUD (umbral 50) ===" << std::endl;
+        std::cout << std::endl;
+        
+        std::cout << std::left << std::setw(20) << "Filtro"
+                  << std::setw(15) << "exact (ms)"
+                  << std::setw(15) << "l1 (ms)"
+                  << std::setw(15) << "linf (ms)" << std::endl;
+        std::cout << std::string(65, '-') << std::endl;
+        
+        const MagnitudeMode modes[] = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+        for (const auto& filterType : availableTypes) {
+            auto filter = FilterFactory::createFilter(filterType);
+            if (!filter) {
+                continue;
+            }
+            std::cout << std::left << std::setw(20) << filter->getName();
+            for (MagnitudeMode mode : modes) {
+                filter->setMagnitudeMode(mode);
+                filter->resetStats();
+                filter->detectEdgesWithThreshold(inputImage, 50);
+                std::cout << std::setw(15) << std::fixed << std::setprecision(2)
+                          << filter->getLastExecutionTime();
+            }
+            std::cout << std::endl;
+        }
+        
+        std::cout << std::endl;
+        std::cout << "=== LOTES (detectEdgesBatch) ===" << std::endl;
+        std::cout << std::endl;
+        
+        // Miniaturas (reparto por imágenes) frente a imágenes grandes (reparto dentro de cada imagen)
+        cv::Mat thumbnail, large;
+        cv::resize(inputImage, thumbnail, cv::Size(256, 256));
+        cv::resize(inputImage, large, cv::Size(1920, 1080));
+        const std::vector<cv::Mat> thumbnails(1000, thumbnail);
+        const std::vector<cv::Mat> largeImages(8, large);
+        
+        std::cout << std::left << std::setw(20) << "Filtro"
+                  << std::setw(30) << "1000 x 256x256 (img/s)"
+                  << std::setw(30) << "8 x 1920x1080 (img/s)" << std::endl;
+        std::cout << std::string(80, '-') << std::endl;
+        
+        auto batchLabel = [](const BatchStats& stats) {
+            std::ostringstream label;
+            label << std::fixed << std::setprecision(0) << stats.imagesPerSecond
+                  << (stats.parallelism == BatchParallelism::ACROSS_IMAGES ? " (por imagen)" : " (dentro)");
+            return label.str();
+        };
+        
+        for (const auto& filterType : availableTypes) {
+            auto filter = FilterFactory::createFilter(filterType);
+            if (!filter) {
+                continue;
+            }
+            std::vector<cv::Mat> outputs;
+            BatchStats small = filter->detectEdgesBatch(thumbnails, outputs, 50);
+            
+            // El lote debe dar lo mismo que una llamada individual
+            auto single = filter->detectEdgesWithThreshold(thumbnail, 50);
+            bool matches = single && small.failed == 0 && cv::norm(outputs.back(), *single, cv::NORM_INF) == 0.0;
+            
+            BatchStats big = filter->detectEdgesBatch(largeImages, outputs, 50);
+            std::cout << std::left << std::setw(20) << filter->getName()
+                      << std::setw(30) << batchLabel(small)
+                      << std::setw(30) << batchLabel(big)
+                      << (matches ? "✅" : "❌ difiere") << std::endl;
+        }
+        
+        std::cout << std::endl;
+        std::cout << "=== MÁSCARA EMPAQUETADA (1 bit/píxel, umbral 50) ===" << std::endl;
+        std::cout << std::endl;
+        
+        auto packedFilter = FilterFactory::createFilter(FilterFactory::FilterType::SOBEL_SIMD);
+        auto packed = packedFilter ? packedFilter->detectEdgesPacked(inputImage, 50) : std::nullopt;
+        if (packed) {
+            size_t byteMaskBytes = static_cast<size_t>(packed->rows()) * packed->cols();
+            cv::Mat tileCounts = packed->countTiles(64, 64);
+            double maxTile = 0.0;
+            cv::minMaxLoc(tileCounts, nullptr, &maxTile);
+            std::cout << "Píxeles de borde: " << packed->count() << std::endl;
+            std::cout << "Memoria: " << packed->sizeBytes() << " bytes (máscara CV_8UC1: "
+                      << byteMaskBytes << " bytes, stride " << packed->strideBytes() << " bytes)" << std::endl;
+            std::cout << "Bloques 64x64: " << tileCounts.cols << "x" << tileCounts.rows
+                      << ", máximo " << static_cast<int>(maxTile) << " bordes por bloque" << std::endl;
+            std::cout << "Tiempo: " << packedFilter->getLastExecutionTime() << " ms" << std::endl;
+        }
+        
         std::cout << std::endl;
         std::cout << "=== DEMOSTRACIÓN COMPLETADA ===" << std::endl;
         std::cout << "Los patrones Strategy y Factory funcionan correctamente." << std::endl;
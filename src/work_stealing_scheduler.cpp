@@ -0,0 +1,84 @@
+// =============================================================
+//  WORK_STEALING_SCHEDULER.CPP
+//  -----------------------------------------------------------
+//  Planificador de bloques con una cola por hilo y robo de la
+//  mitad final de otras colas. Sin mutex: cada cola es un rango
+//  [begin, end) en un atómico de 64 bits.
+// =============================================================
+
+#include "work_stealing_scheduler.h"
+#include <algorithm>
+
+WorkStealingScheduler::WorkStealingScheduler(int numWorkers)
+    : numWorkers_(std::max(numWorkers, 1)),
+      queues_(new WorkerQueue[std::max(numWorkers, 1)]) {}
+
+void WorkStealingScheduler::reset(int numTasks) {
+    numTasks = std::max(numTasks, 0);
+    for (int w = 0; w < numWorkers_; w++) {
+        uint32_t begin = static_cast<uint32_t>(static_cast<int64_t>(numTasks) * w / numWorkers_);
+        uint32_t end = static_cast<uint32_t>(static_cast<int64_t>(numTasks) * (w + 1) / numWorkers_);
+        queues_[w].range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+    steals_.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+bool WorkStealingScheduler::next(int worker, int& task) {
+    // Propia cola: se consume por delante (orden de memoria de los bloques)
+    std::atomic<uint64_t>& own = queues_[worker].range;
+    uint64_t range = own.load(std::memory_order_acquire);
+    while (true) {
+        uint32_t begin = static_cast<uint32_t>(range >> 32);
+        uint32_t end = static_cast<uint32_t>(range);
+        if (begin >= end) {
+            break;
+        }
+        if (own.compare_exchange_weak(range, pack(begin + 1, end), std::memory_order_acq_rel)) {
+            task = static_cast<int>(begin);
+            return true;
+        }
+    }
+    return steal(worker, task);
+}
+
+bool WorkStealingScheduler::steal(int worker, int& task) {
+    for (int k = 1; k < numWorkers_; k++) {
+        std::atomic<uint64_t>& victim = queues_[(worker + k) % numWorkers_].range;
+        uint64_t range = victim.load(std::memory_order_acquire);
+
+        while (true) {
+            uint32_t begin = static_cast<uint32_t>(range >> 32);
+            uint32_t end = static_cast<uint32_t>(range);
+            if (begin >= end) {
+                break;
+            }
+
+            // Se roba la mitad final: el dueño sigue con los bloques cercanos a los suyos
+            uint32_t taken = (end - begin + 1) / 2;
+            uint32_t split = end - taken;
+            if (victim.compare_exchange_weak(range, pack(begin, split), std::memory_order_acq_rel)) {
+                // La propia cola está vacía: los demás la ven vacía y no la tocan,
+                // así que basta un store para quedarse con el resto del botín
+                queues_[worker].range.store(pack(split + 1, end), std::memory_order_release);
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                task = static_cast<int>(split);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<cv::Rect> makeTileGrid(const cv::Size& imageSize, const cv::Size& tileSize) {
+    std::vector<cv::Rect> tiles;
+    int tileWidth = std::max(tileSize.width, 1);
+    int tileHeight = std::max(tileSize.height, 1);
+    for (int y = 0; y < imageSize.height; y += tileHeight) {
+        for (int x = 0; x < imageSize.width; x += tileWidth) {
+            tiles.emplace_back(x, y, std::min(tileWidth, imageSize.width - x),
+                               std::min(tileHeight, imageSize.height - y));
+        }
+    }
+    return tiles;
+}
@@ -0,0 +1,135 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// =============================================================
+//  Contador de reservas de memoria para las pruebas
+//  -----------------------------------------------------------
+//  Se sustituyen operator new/delete y, con glibc, también
+//  malloc/calloc/realloc/memalign: así se cuentan también las
+//  reservas que OpenCV hace por su cuenta (cv::fastMalloc).
+//  Solo se cuenta dentro de countAllocations(). Incluir desde un
+//  único fichero por ejecutable.
+// =============================================================
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace alloc_counter {
+inline std::atomic<bool> counting{false};
+inline std::atomic<size_t> allocations{0};
+inline std::atomic<size_t> bytes{0};
+
+inline void note(size_t size) {
+    if (counting.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+}
+} // namespace alloc_counter
+
+/**
+ * @brief Reservas hechas durante una serie de llamadas
+ */
+struct AllocationCount {
+    size_t allocations = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Cuenta las reservas hechas durante frames llamadas a fn(frame)
+ */
+template <typename Fn>
+AllocationCount countAllocations(int frames, Fn&& fn) {
+    alloc_counter::allocations.store(0);
+    alloc_counter::bytes.store(0);
+    alloc_counter::counting.store(true);
+    for (int f = 0; f < frames; f++) {
+        fn(f);
+    }
+    alloc_counter::counting.store(false);
+    return {alloc_counter::allocations.load(), alloc_counter::bytes.load()};
+}
+
+#ifdef __GLIBC__
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) {
+    alloc_counter::note(size);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size) {
+    alloc_counter::note(count * size);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, size_t size) {
+    alloc_counter::note(size);
+    return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) {
+    alloc_counter::note(size);
+    return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) {
+    alloc_counter::note(size);
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, size_t alignment, size_t size) {
+    alloc_counter::note(size);
+    *ptr = __libc_memalign(alignment, size);
+    return *ptr ? 0 : 12;   // ENOMEM
+}
+
+void free(void* ptr) {
+    __libc_free(ptr);
+}
+}
+
+// operator new termina en malloc, que ya cuenta
+void* operator new(size_t size) {
+    if (void* ptr = malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+#else
+void* operator new(size_t size) {
+    alloc_counter::note(size);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+#endif
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+#endif // ALLOC_COUNTER_H
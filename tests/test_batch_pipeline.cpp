@@ -0,0 +1,215 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <chrono>
+#include "batch_pipeline.h"
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "test_utils.h"
+
+namespace fs = std::filesystem;
+
+cv::Mat createTestImage(int width, int height, int seed) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(40 + seed, 90, 160));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(255, 255, 255), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(64));
+    return image + noise;
+}
+
+int main() {
+    std::cout << "=== Prueba del Pipeline por Lotes (lectura/filtro/escritura) ===" << std::endl;
+
+    const fs::path dir = fs::temp_directory_path() / "sobel_batch_pipeline_test";
+    fs::remove_all(dir);
+    const fs::path inputDir = dir / "input";
+    const fs::path outputDir = dir / "output";
+    fs::create_directories(inputDir);
+
+    // Imágenes de tamaños distintos (PNG sin pérdidas), un fichero corrupto y uno que no es imagen
+    const int numImages = 12;
+    for (int i = 0; i < numImages; i++) {
+        std::string name = "img_" + std::to_string(100 + i) + ".png";
+        cv::imwrite((inputDir / name).string(), createTestImage(64 + 37 * i, 48 + 23 * i, i));
+    }
+    std::ofstream(inputDir / "corrupt.png") << "no es una imagen";
+    std::ofstream(inputDir / "notes.txt") << "ignorado";
+
+    bool allPassed = true;
+    auto reference = FilterFactory::createFilter("auto");
+
+    // Listado del directorio: solo imágenes, en orden
+    std::vector<std::string> inputs = BatchPipeline::listInputs(inputDir.string());
+    {
+        bool ok = inputs.size() == numImages + 1 && std::is_sorted(inputs.begin(), inputs.end());
+        std::ofstream list(dir / "list.txt");
+        list << "# lista de prueba\n\n" << inputs[0] << "\r\n" << inputs[1] << "\n";
+        list.close();
+        ok = ok && BatchPipeline::listInputs((dir / "list.txt").string()) ==
+                       std::vector<std::string>{inputs[0], inputs[1]};
+        std::cout << (ok ? "✅" : "❌") << " Listado de directorio y de fichero de lista" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Cualquier reparto de hilos y tamaño de cola da las mismas salidas
+    struct Layout { int decode, filter, encode, queue; };
+    for (Layout layout : {Layout{1, 1, 1, 1}, Layout{2, 1, 2, 4}, Layout{3, 2, 1, 2}, Layout{1, 3, 3, 1}}) {
+        fs::remove_all(outputDir);
+        BatchPipelineConfig config;
+        config.decodeThreads = layout.decode;
+        config.filterThreads = layout.filter;
+        config.encodeThreads = layout.encode;
+        config.queueCapacity = layout.queue;
+        BatchPipelineStats stats = BatchPipeline(config).run(inputs, outputDir.string());
+
+        bool ok = stats.images == numImages && stats.failed == 1;
+        for (const std::string& input : inputs) {
+            cv::Mat image = cv::imread(input);
+            if (image.empty()) {
+                continue;
+            }
+            auto edges = reference->detectEdges(image);
+            auto mask = reference->detectEdgesWithThreshold(image, config.threshold);
+            cv::Mat written = cv::imread(BatchPipeline::outputPathFor(input, outputDir.string()), cv::IMREAD_GRAYSCALE);
+            cv::Mat writtenMask = cv::imread(BatchPipeline::outputPathFor(input, outputDir.string(), "_threshold"),
+                                             cv::IMREAD_GRAYSCALE);
+            ok = ok && edges && mask && sameImage(written, *edges) && sameImage(writtenMask, *mask);
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << "Hilos " << layout.decode << "/" << layout.filter << "/"
+                  << layout.encode << ", cola " << layout.queue << ": " << stats.images << " escritas, "
+                  << stats.failed << " fallida(s)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Lectura reducida: las salidas salen a la mitad de tamaño
+    {
+        fs::remove_all(outputDir);
+        BatchPipelineConfig config;
+        config.decodeMode = DecodeMode::REDUCED_2;
+        BatchPipelineStats stats = BatchPipeline(config).run(inputs, outputDir.string());
+        bool ok = stats.images == numImages;
+        for (const std::string& input : inputs) {
+            cv::Mat image = cv::imread(input, cv::IMREAD_REDUCED_GRAYSCALE_2);
+            if (image.empty()) {
+                continue;
+            }
+            cv::Mat written = cv::imread(BatchPipeline::outputPathFor(input, outputDir.string()), cv::IMREAD_GRAYSCALE);
+            ok = ok && written.size() == image.size();
+        }
+        std::cout << (ok ? "✅" : "❌") << " Lectura reducida 1/2 en el lote" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // PGM proyectados con mmap: mismas salidas que pasando por imread/imwrite
+    {
+        const fs::path pgmDir = dir / "pgm";
+        fs::create_directories(pgmDir);
+        for (int i = 0; i < 4; i++) {
+            cv::Mat gray;
+            cv::cvtColor(createTestImage(96 + 31 * i, 64 + 17 * i, i), gray, cv::COLOR_BGR2GRAY);
+            cv::imwrite((pgmDir / ("gray_" + std::to_string(i) + ".pgm")).string(), gray);
+        }
+        std::vector<std::string> pgmInputs = BatchPipeline::listInputs(pgmDir.string());
+        BatchPipelineConfig mapped;
+        BatchPipelineConfig codec;
+        codec.mapPgm = false;
+        BatchPipelineStats mappedStats = BatchPipeline(mapped).run(pgmInputs, (dir / "out_mmap").string());
+        BatchPipelineStats codecStats = BatchPipeline(codec).run(pgmInputs, (dir / "out_codec").string());
+        bool ok = mappedStats.images == 4 && codecStats.images == 4;
+        for (const std::string& input : pgmInputs) {
+            for (const char* suffix : {"", "_threshold"}) {
+                ok = ok && sameImage(
+                    cv::imread(BatchPipeline::outputPathFor(input, (dir / "out_mmap").string(), suffix), cv::IMREAD_UNCHANGED),
+                    cv::imread(BatchPipeline::outputPathFor(input, (dir / "out_codec").string(), suffix), cv::IMREAD_UNCHANGED));
+            }
+        }
+        std::cout << (ok ? "✅" : "❌") << " PGM proyectados con mmap idénticos a imread/imwrite" << std::endl;
+        allPassed = allPassed && ok;
+
+        // Salida en el propio directorio de entrada: las entradas se sobrescriben con
+        // sus bordes (como con imread/imwrite), nunca a ceros
+        BatchPipelineStats inPlaceStats = BatchPipeline(mapped).run(pgmInputs, pgmDir.string());
+        ok = inPlaceStats.images == 4 && inPlaceStats.failed == 0;
+        for (const std::string& input : pgmInputs) {
+            for (const char* suffix : {"", "_threshold"}) {
+                ok = ok && sameImage(
+                    cv::imread(BatchPipeline::outputPathFor(input, pgmDir.string(), suffix), cv::IMREAD_UNCHANGED),
+                    cv::imread(BatchPipeline::outputPathFor(input, (dir / "out_codec").string(), suffix), cv::IMREAD_UNCHANGED));
+            }
+        }
+        std::cout << (ok ? "✅" : "❌") << " Lote con salida sobre las entradas (sin mmap, sin ceros)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Configuración y filtro inválidos
+    {
+        auto throws = [](auto&& fn) {
+            try {
+                fn();
+            } catch (const std::exception&) {
+                return true;
+            }
+            return false;
+        };
+        BatchPipelineConfig noThreads;
+        noThreads.encodeThreads = 0;
+        BatchPipelineConfig unknown;
+        unknown.filterName = "sobel_simd_neon";
+        bool ok = throws([&] { BatchPipeline pipeline(noThreads); }) &&
+                  throws([&] { BatchPipeline(unknown).run(inputs, outputDir.string()); });
+        std::cout << (ok ? "✅" : "❌") << " Configuración y filtro inválidos rechazados" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: bucle secuencial imread -> filtro -> imwrite frente al pipeline
+    const int benchImages = 24;
+    fs::remove_all(inputDir);
+    fs::create_directories(inputDir);
+    for (int i = 0; i < benchImages; i++) {
+        cv::imwrite((inputDir / ("frame_" + std::to_string(100 + i) + ".png")).string(),
+                    createTestImage(1920, 1080, i));
+    }
+    inputs = BatchPipeline::listInputs(inputDir.string());
+
+    fs::remove_all(outputDir);
+    fs::create_directories(outputDir);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (const std::string& input : inputs) {
+        cv::Mat image = cv::imread(input);
+        cv::Mat edges, mask;
+        reference->detectEdgesInto(image, edges);
+        reference->detectEdgesWithThresholdInto(image, mask, 50);
+        cv::imwrite(BatchPipeline::outputPathFor(input, outputDir.string()), edges);
+        cv::imwrite(BatchPipeline::outputPathFor(input, outputDir.string(), "_threshold"), mask);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double sequentialMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    BatchPipelineConfig config;
+    config.decodeThreads = 3;
+    config.encodeThreads = 3;
+    BatchPipelineStats stats = BatchPipeline(config).run(inputs, outputDir.string());
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << benchImages << " x 1920x1080 PNG, hilos " << config.decodeThreads << "/"
+              << config.filterThreads << "/" << config.encodeThreads << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Bucle secuencial:   " << sequentialMs << " ms ("
+              << benchImages * 1000.0 / sequentialMs << " img/s)" << std::endl;
+    std::cout << "Pipeline:           " << stats.totalMs << " ms (" << stats.imagesPerSecond << " img/s)" << std::endl;
+    std::cout << "Etapas (ocupado):   lectura " << stats.decodeMs << " ms, filtro " << stats.filterMs
+              << " ms, escritura " << stats.encodeMs << " ms; más lenta: " << stats.bottleneck << std::endl;
+
+    fs::remove_all(dir);
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
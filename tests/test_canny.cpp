@@ -0,0 +1,247 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include "canny_filter.h"
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+#include "sobel_direction.h"
+#include "filter_factory.h"
+#include "cpu_features.h"
+#include "test_utils.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Formas suavizadas con ruido: cadenas de bordes débiles y fuertes largas
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC1, cv::Scalar::all(100));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar::all(180), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 2), cv::Scalar::all(40), -1);
+    cv::line(image, cv::Point(0, height - 1), cv::Point(width - 1, 0), cv::Scalar::all(140), 3);
+    cv::GaussianBlur(image, image, cv::Size(5, 5), 1.5);
+
+    cv::Mat noise(image.size(), CV_8UC1);
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(24));
+    return image + noise;
+}
+
+// Canny escalar de referencia: NMS con las mismas reglas y relleno global en anchura
+cv::Mat referenceCanny(const cv::Mat& gray, int low, int high, MagnitudeMode mode) {
+    const int rows = gray.rows, cols = gray.cols;
+    cv::Mat edges = cv::Mat::zeros(gray.size(), CV_8UC1);
+    if (rows < 3 || cols < 3) {
+        return edges;
+    }
+
+    std::vector<int> magnitude(rows * cols, 0);
+    std::vector<uchar> sector(rows * cols, 0);
+    for (int i = 1; i < rows - 1; i++) {
+        for (int j = 1; j < cols - 1; j++) {
+            auto px = [&](int di, int dj) { return static_cast<int>(gray.at<uchar>(i + di, j + dj)); };
+            int gx = (px(-1, 1) - px(-1, -1)) + 2 * (px(0, 1) - px(0, -1)) + (px(1, 1) - px(1, -1));
+            int gy = (px(1, -1) + 2 * px(1, 0) + px(1, 1)) - (px(-1, -1) + 2 * px(-1, 0) + px(-1, 1));
+            magnitude[i * cols + j] = sobelMagnitudeRaw(gx, gy, mode);
+            sector[i * cols + j] = sobelDirectionBin(gx, gy, DirectionBins::FOUR);
+        }
+    }
+
+    auto mag = [&](int i, int j) { return magnitude[i * cols + j]; };
+    cv::Mat candidates = cv::Mat::zeros(gray.size(), CV_8UC1);   // 1 débil, 2 fuerte
+    std::vector<int> queue;
+    for (int i = 1; i < rows - 1; i++) {
+        for (int j = 1; j < cols - 1; j++) {
+            int m = mag(i, j);
+            if (m <= low) {
+                continue;
+            }
+            bool isMaximum;
+            switch (sector[i * cols + j]) {
+                case 0:  isMaximum = m > mag(i, j - 1) && m >= mag(i, j + 1); break;
+                case 2:  isMaximum = m > mag(i - 1, j) && m >= mag(i + 1, j); break;
+                case 1:  isMaximum = m > mag(i - 1, j - 1) && m > mag(i + 1, j + 1); break;
+                default: isMaximum = m > mag(i - 1, j + 1) && m > mag(i + 1, j - 1); break;
+            }
+            if (isMaximum) {
+                candidates.at<uchar>(i, j) = m > high ? 2 : 1;
+                if (m > high) {
+                    edges.at<uchar>(i, j) = 255;
+                    queue.push_back(i * cols + j);
+                }
+            }
+        }
+    }
+
+    for (size_t head = 0; head < queue.size(); head++) {
+        int i = queue[head] / cols, j = queue[head] % cols;
+        for (int di = -1; di <= 1; di++) {
+            for (int dj = -1; dj <= 1; dj++) {
+                int ni = i + di, nj = j + dj;
+                if (ni < 0 || nj < 0 || ni >= rows || nj >= cols) {
+                    continue;
+                }
+                if (candidates.at<uchar>(ni, nj) == 1 && edges.at<uchar>(ni, nj) == 0) {
+                    edges.at<uchar>(ni, nj) = 255;
+                    queue.push_back(ni * cols + nj);
+                }
+            }
+        }
+    }
+    return edges;
+}
+
+// Mediana de varias ejecuciones en milisegundos
+template <typename Fn>
+double medianMs(Fn&& fn, int runs = 7) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    std::cout << "=== Prueba del Detector de Canny ===" << std::endl;
+    std::cout << "CPU: " << CpuFeatures::get().toString() << std::endl;
+
+    bool allPassed = true;
+
+    // Cada variante SIMD, modo de magnitud y alto de banda frente a la referencia
+    const std::vector<cv::Size> sizes = {cv::Size(2, 2), cv::Size(3, 3), cv::Size(19, 7), cv::Size(130, 67),
+                                         cv::Size(641, 479)};
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (!SobelFilterSIMD::isLevelSupported(level)) {
+            continue;
+        }
+        int failures = 0;
+        for (const cv::Size& size : sizes) {
+            cv::Mat image = createTestImage(size.width, size.height);
+            for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+                cv::Mat expected = referenceCanny(image, 20, 60, mode);
+                CannyFilter canny(20, 60, mode, level);
+                for (int bandHeight : {1, 2, 5, CannyFilter::DEFAULT_BAND_HEIGHT}) {
+                    canny.setBandHeight(bandHeight);
+                    failures += !sameImage(canny.applyCanny(image), expected);
+                }
+            }
+        }
+        std::cout << (failures == 0 ? "✅ " : "❌ ") << std::left << std::setw(8)
+                  << SobelFilterSIMD::levelToString(level) << " "
+                  << (failures == 0 ? "idéntico a la referencia" : std::to_string(failures) + " diferencias")
+                  << std::endl;
+        allPassed = allPassed && failures == 0;
+    }
+
+    // La salida no depende del número de hilos; Into con BGR y buffers reutilizados
+    {
+        cv::Mat image = createTestImage(1031, 517);
+        cv::Mat expected = referenceCanny(image, 30, 90, MagnitudeMode::EXACT);
+        CannyFilter canny(30, 90);
+        canny.setBandHeight(16);
+        bool ok = true;
+        int maxThreads = 1;
+#ifdef _OPENMP
+        maxThreads = std::max(omp_get_num_procs(), 4);
+#endif
+        CannyFilter::Scratch scratch;
+        cv::Mat output;
+        for (int threads = 1; threads <= maxThreads; threads++) {
+#ifdef _OPENMP
+            omp_set_num_threads(threads);
+#endif
+            canny.applyCannyInto(image, output, scratch);
+            ok = ok && sameImage(output, expected);
+        }
+#ifdef _OPENMP
+        omp_set_num_threads(omp_get_num_procs());
+#endif
+        cv::Mat color;
+        cv::cvtColor(image, color, cv::COLOR_GRAY2BGR);
+        canny.applyCannyInto(color, output, scratch);
+        ok = ok && sameImage(output, expected);
+        std::cout << (ok ? "✅" : "❌") << " 1.." << maxThreads << " hilos, BGR y applyCannyInto" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Errores: umbrales inválidos, tipo no soportado y salida que comparte datos
+    {
+        bool ok = true;
+        auto throws = [](auto&& fn) {
+            try {
+                fn();
+            } catch (const std::exception&) {
+                return true;
+            }
+            return false;
+        };
+        CannyFilter canny;
+        cv::Mat image = createTestImage(32, 32);
+        cv::Mat alias = image;
+        CannyFilter::Scratch scratch;
+        ok = ok && throws([&] { canny.setThresholds(100, 50); });
+        ok = ok && throws([&] { canny.setThresholds(-1, 50); });
+        ok = ok && throws([&] { canny.applyCanny(cv::Mat(8, 8, CV_16UC1, cv::Scalar::all(0))); });
+        ok = ok && throws([&] { canny.applyCannyInto(image, alias, scratch); });
+        std::cout << (ok ? "✅" : "❌") << " Umbrales, tipo y aliasing rechazados" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Estrategia registrada en la Factory
+    {
+        auto strategy = FilterFactory::createFilter("canny");
+        cv::Mat image = createTestImage(200, 150);
+        auto edges = strategy ? strategy->detectEdges(image) : std::nullopt;
+        auto available = FilterFactory::getAvailableFilterTypes();
+        bool listed = std::find(available.begin(), available.end(), FilterFactory::FilterType::CANNY) != available.end();
+        bool ok = strategy && listed && edges &&
+                  sameImage(*edges, referenceCanny(image, 50, 150, MagnitudeMode::EXACT));
+        std::cout << (ok ? "✅" : "❌") << " FilterFactory: \"canny\" disponible y con la misma salida" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento a 4K frente a cv::Canny (L2gradient, mismos umbrales y sin suavizado)
+    const int width = 3840, height = 2160;
+    cv::Mat frame = createTestImage(width, height);
+    CannyFilter canny(50, 150);
+    CannyFilter::Scratch scratch;
+    cv::Mat edges, opencvEdges;
+
+    double cannyMs = medianMs([&] { canny.applyCannyInto(frame, edges, scratch); });
+    double opencvMs = medianMs([&] { cv::Canny(frame, opencvEdges, 50, 150, 3, true); });
+
+    // Coincidencia informativa: cv::Canny usa sqrt en float y también calcula el borde de 1 píxel
+    cv::Rect interior(1, 1, width - 2, height - 2);
+    cv::Mat both, either;
+    cv::bitwise_and(edges(interior), opencvEdges(interior), both);
+    cv::bitwise_or(edges(interior), opencvEdges(interior), either);
+    int unionCount = cv::countNonZero(either);
+    double agreement = unionCount > 0 ? 100.0 * cv::countNonZero(both) / unionCount : 100.0;
+
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << ", " << threads << " hilos, "
+              << SobelFilterSIMD::levelToString(canny.getLevel()) << ", mediana de 7) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "CannyFilter:              " << cannyMs << " ms" << std::endl;
+    std::cout << "cv::Canny (L2gradient):   " << opencvMs << " ms" << std::endl;
+    std::cout << "Speedup:                  " << (opencvMs / cannyMs) << "x" << std::endl;
+    std::cout << "Coincidencia con cv::Canny (IoU de bordes): " << agreement << " %" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,105 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "sobel_filter.h"
+#include "alloc_counter.h"
+#include "test_utils.h"
+
+// Cámara monocroma sintética: ruido con un par de formas
+cv::Mat createMonoFrame(int width, int height) {
+    cv::Mat frame(height, width, CV_8UC1);
+    cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::circle(frame, cv::Point(width / 2, height / 2), height / 3, cv::Scalar::all(255), -1);
+    cv::rectangle(frame, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar::all(0), -1);
+    return frame;
+}
+
+int main() {
+    std::cout << "=== Entrada Gris sin Copia (incluidas ROIs) ===" << std::endl;
+
+    const int frames = 20;
+    cv::Mat parent = createMonoFrame(1280, 720);
+    const cv::Mat pristine = parent.clone();
+
+    // Vista no contigua: empieza en columna impar y su step es el de la imagen padre
+    cv::Mat roi = parent(cv::Rect(13, 7, 1001, 601));
+    const cv::Mat roiCopy = roi.clone();
+    bool allPassed = true;
+
+    std::cout << "Fotograma: " << parent.cols << "x" << parent.rows
+              << " (" << parent.total() << " bytes), ROI: " << roi.cols << "x" << roi.rows
+              << " con step " << static_cast<size_t>(roi.step) << std::endl;
+    std::cout << std::endl;
+    std::cout << std::left << std::setw(28) << "Estrategia"
+              << std::right << std::setw(16) << "Reservado/fot."
+              << std::setw(14) << "Salida/fot."
+              << std::setw(16) << "Copia entrada"
+              << std::setw(12) << "ms/fot." << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+
+    for (FilterFactory::FilterType type : FilterFactory::getAvailableFilterTypes()) {
+        auto strategy = FilterFactory::createFilter(type);
+        if (!strategy) {
+            continue;
+        }
+
+        // Una ROI produce lo mismo que su copia contigua
+        auto fromView = strategy->detectEdges(roi);
+        auto fromCopy = strategy->detectEdges(roiCopy);
+        bool roiOk = fromView && fromCopy && sameImage(*fromView, *fromCopy);
+
+        // Calentamiento (tablas, pools de hilos)
+        strategy->detectEdges(parent);
+
+        auto start = std::chrono::high_resolution_clock::now();
+        AllocationCount count = countAllocations(frames, [&](int) {
+            strategy->detectEdges(parent);
+        });
+        auto end = std::chrono::high_resolution_clock::now();
+        double msPerFrame = std::chrono::duration<double, std::milli>(end - start).count() / frames;
+
+        // Todo lo reservado por encima de la salida son copias o intermedios del motor
+        size_t perFrame = count.bytes / frames;
+        size_t outputBytes = parent.total();
+        size_t inputCopy = perFrame > outputBytes ? perFrame - outputBytes : 0;
+
+        std::cout << std::left << std::setw(28) << strategy->getName()
+                  << std::right << std::setw(16) << perFrame
+                  << std::setw(14) << outputBytes
+                  << std::setw(16) << inputCopy
+                  << std::setw(12) << std::fixed << std::setprecision(2) << msPerFrame;
+        if (!roiOk) {
+            std::cout << "  ❌ la ROI no coincide con su copia";
+            allPassed = false;
+        }
+        std::cout << std::endl;
+    }
+
+    // Con blur el filtro mejorado no debe tocar la entrada prestada
+    FilterConfig config;
+    config.useGaussianBlur = true;
+    SobelFilter blurFilter(config);
+    blurFilter.applyFilter(roi);
+    blurFilter.applyFilterWithThreshold(parent, 60);
+
+    std::cout << std::endl;
+    if (sameImage(parent, pristine)) {
+        std::cout << "✅ La entrada del llamador no se modifica" << std::endl;
+    } else {
+        std::cout << "❌ Algún filtro ha escrito en la entrada" << std::endl;
+        allPassed = false;
+    }
+
+    std::cout << "Una entrada CV_8UC1 se lee en su sitio: la copia de entrada debería ser ~0" << std::endl;
+    std::cout << "(antes cada fotograma gris se clonaba completo, " << parent.total() << " bytes)" << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
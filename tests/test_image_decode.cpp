@@ -0,0 +1,125 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <string>
+#include "image_decode.h"
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+
+namespace fs = std::filesystem;
+
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(30, 110, 180));
+    cv::rectangle(image, cv::Point(width / 4, height / 4), cv::Point(3 * width / 4, 3 * height / 4),
+                  cv::Scalar(250, 250, 250), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(48));
+    return image + noise;
+}
+
+int main() {
+    std::cout << "=== Prueba de Decodificación (color/gris/reducida) ===" << std::endl;
+
+    const fs::path dir = fs::temp_directory_path() / "sobel_image_decode_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+
+    bool allPassed = true;
+
+    // Nombres y flags
+    {
+        bool ok = true;
+        for (DecodeMode mode : {DecodeMode::COLOR, DecodeMode::GRAY, DecodeMode::REDUCED_2,
+                                DecodeMode::REDUCED_4, DecodeMode::REDUCED_8}) {
+            DecodeMode parsed = DecodeMode::COLOR;
+            ok = ok && stringToDecodeMode(decodeModeToString(mode), parsed) && parsed == mode;
+        }
+        DecodeMode untouched = DecodeMode::GRAY;
+        ok = ok && !stringToDecodeMode("reduced3", untouched) && untouched == DecodeMode::GRAY;
+        ok = ok && decodeModeFlags(DecodeMode::COLOR) == cv::IMREAD_COLOR &&
+             decodeModeFlags(DecodeMode::GRAY) == cv::IMREAD_GRAYSCALE &&
+             decodeModeFlags(DecodeMode::REDUCED_4) == cv::IMREAD_REDUCED_GRAYSCALE_4;
+        std::cout << (ok ? "✅" : "❌") << " Conversión de nombres y flags" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Gris y reducidas: un canal y el tamaño esperado
+    const int width = 1920;
+    const int height = 1080;
+    cv::Mat color = createTestImage(width, height);
+    const std::string png = (dir / "frame.png").string();
+    const std::string jpg = (dir / "frame.jpg").string();
+    cv::imwrite(png, color);
+    cv::imwrite(jpg, color);
+
+    for (const std::string& path : {png, jpg}) {
+        bool ok = true;
+        for (int scale : {1, 2, 4, 8}) {
+            DecodeMode mode = scale == 1 ? DecodeMode::GRAY
+                            : scale == 2 ? DecodeMode::REDUCED_2
+                            : scale == 4 ? DecodeMode::REDUCED_4 : DecodeMode::REDUCED_8;
+            cv::Mat image = decodeImage(path, mode);
+            ok = ok && image.type() == CV_8UC1 && image.cols == (width + scale - 1) / scale &&
+                 image.rows == (height + scale - 1) / scale;
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << fs::path(path).extension().string()
+                  << ": gris y reducidas 1/2, 1/4, 1/8 con un canal y tamaño correcto" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Decodificar en gris equivale a la conversión que hacían los filtros (salvo redondeo del códec)
+    {
+        auto filter = FilterFactory::createFilter("auto");
+        auto fromColor = filter->detectEdges(decodeImage(png, DecodeMode::COLOR));
+        auto fromGray = filter->detectEdges(decodeImage(png, DecodeMode::GRAY));
+        cv::Mat diff;
+        bool ok = fromColor && fromGray && fromColor->size() == fromGray->size();
+        if (ok) {
+            cv::absdiff(*fromColor, *fromGray, diff);
+            ok = cv::mean(diff)[0] < 1.0;
+        }
+        std::cout << (ok ? "✅" : "❌") << " Bordes desde gris equivalentes a los de color + cvtColor" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    {
+        cv::Mat missing = decodeImage((dir / "no_existe.jpg").string(), DecodeMode::GRAY);
+        bool ok = missing.empty();
+        std::cout << (ok ? "✅" : "❌") << " Fichero inexistente devuelve imagen vacía" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Tiempo de decodificación de cada modo (mejor de varias repeticiones)
+    std::cout << std::endl;
+    std::cout << "=== Decodificación " << width << "x" << height << " JPEG ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    double colorMs = 0.0;
+    for (DecodeMode mode : {DecodeMode::COLOR, DecodeMode::GRAY, DecodeMode::REDUCED_2,
+                            DecodeMode::REDUCED_4, DecodeMode::REDUCED_8}) {
+        double best = 0.0;
+        for (int rep = 0; rep < 5; rep++) {
+            double ms = 0.0;
+            decodeImage(jpg, mode, &ms);
+            best = rep == 0 ? ms : std::min(best, ms);
+        }
+        if (mode == DecodeMode::COLOR) {
+            colorMs = best;
+        }
+        std::cout << std::setw(9) << decodeModeToString(mode) << ": " << best << " ms";
+        if (mode != DecodeMode::COLOR) {
+            std::cout << " (ahorro " << colorMs - best << " ms)";
+        }
+        std::cout << std::endl;
+    }
+
+    fs::remove_all(dir);
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include "mapped_image.h"
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "alloc_counter.h"
+#include "test_utils.h"
+
+namespace fs = std::filesystem;
+
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC1, cv::Scalar(70));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(230), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(40));
+    return image + noise;
+}
+
+template <typename Fn>
+bool throws(Fn&& fn) {
+    try {
+        fn();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Prueba de Imágenes Proyectadas en Memoria (PGM/raw con mmap) ===" << std::endl;
+
+    const fs::path dir = fs::temp_directory_path() / "sobel_mapped_image_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    const std::string pgm = (dir / "input.pgm").string();
+
+    bool allPassed = true;
+    cv::Mat gray = createTestImage(641, 479);
+    cv::imwrite(pgm, gray);
+
+    // PGM de 8 bits: vista sin copia con el mismo contenido que cv::imread
+    {
+        MappedImage input = MappedImage::openPgm(pgm);
+        cv::Mat view = input.mat();
+        bool ok = input.depth() == CV_8U && sameImage(view, cv::imread(pgm, cv::IMREAD_GRAYSCALE)) &&
+                  view.data == input.mat().data;
+        std::cout << (ok ? "✅" : "❌") << " PGM de 8 bits proyectado sin copia" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // PGM de 16 bits: escrito proyectado (big-endian al cerrar) y leído de vuelta
+    {
+        cv::Mat wide(gray.size(), CV_16UC1);
+        gray.convertTo(wide, CV_16U, 257.0);
+        const std::string path = (dir / "wide.pgm").string();
+        MappedImage output = MappedImage::createPgm(path, wide.rows, wide.cols, CV_16U);
+        cv::Mat view = output.mat();
+        wide.copyTo(view);
+        output.close();
+
+        MappedImage input = MappedImage::openPgm(path);
+        bool ok = input.depth() == CV_16U && sameImage(input.mat(), wide) &&
+                  sameImage(cv::imread(path, cv::IMREAD_UNCHANGED), wide);
+        std::cout << (ok ? "✅" : "❌") << " PGM de 16 bits: escritura y lectura con orden de bytes correcto"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Raw planar: dos planos de 16 bits, cada uno una vista del fichero
+    {
+        const std::string path = (dir / "planes.raw").string();
+        cv::Mat first(gray.size(), CV_16UC1), second(gray.size(), CV_16UC1);
+        gray.convertTo(first, CV_16U, 16.0);
+        gray.convertTo(second, CV_16U, 4.0, 100.0);
+        {
+            MappedImage output = MappedImage::createRaw(path, gray.rows, gray.cols, CV_16U, 2);
+            cv::Mat plane0 = output.mat(0), plane1 = output.mat(1);
+            first.copyTo(plane0);
+            second.copyTo(plane1);
+        }
+        MappedImage input = MappedImage::openRaw(path, gray.rows, gray.cols, CV_16U, 2);
+        bool ok = sameImage(input.mat(0), first) && sameImage(input.mat(1), second) &&
+                  fs::file_size(path) == gray.total() * 2 * 2 &&
+                  throws([&] { MappedImage::openRaw(path, gray.rows, gray.cols + 1, CV_16U, 2); }) &&
+                  throws([&] { input.mat(2); });
+        std::cout << (ok ? "✅" : "❌") << " Raw planar de 16 bits y tamaño incorrecto rechazado" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Entradas inválidas
+    {
+        const std::string ascii = (dir / "ascii.pgm").string();
+        const std::string truncated = (dir / "truncated.pgm").string();
+        std::ofstream(ascii) << "P2\n2 2\n255\n0 1 2 3\n";
+        std::ofstream(truncated, std::ios::binary) << "P5\n100 100\n255\n" << std::string(50, 'x');
+        bool ok = throws([&] { MappedImage::openPgm(ascii); }) &&
+                  throws([&] { MappedImage::openPgm(truncated); }) &&
+                  throws([&] { MappedImage::openPgm((dir / "no_existe.pgm").string()); });
+        std::cout << (ok ? "✅" : "❌") << " PGM ASCII, truncado e inexistente rechazados" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Salida sobre una entrada aún proyectada: se rechaza sin truncar la entrada
+    {
+        const std::string copy = (dir / "in_place.pgm").string();
+        const std::string link = (dir / "in_place_link.pgm").string();
+        fs::copy_file(pgm, copy);
+        fs::create_hard_link(copy, link);
+        bool ok = MappedImage::sameFile(copy, (dir / "." / "in_place.pgm").string()) &&
+                  MappedImage::sameFile(copy, link) && !MappedImage::sameFile(copy, pgm) &&
+                  !MappedImage::sameFile(copy, (dir / "no_existe.pgm").string());
+        {
+            MappedImage input = MappedImage::openPgm(copy);
+            ok = ok && throws([&] { MappedImage::createPgm(copy, input.rows(), input.cols()); }) &&
+                 throws([&] { MappedImage::createRaw(link, input.rows(), input.cols()); }) &&
+                 sameImage(input.mat(), gray);
+        }
+        ok = ok && sameImage(cv::imread(copy, cv::IMREAD_GRAYSCALE), gray);
+        // Con la entrada cerrada ya se puede sobrescribir
+        ok = ok && !throws([&] { MappedImage::createPgm(copy, 2, 2); });
+        std::cout << (ok ? "✅" : "❌") << " Salida sobre la entrada proyectada rechazada (también por enlace)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Filtro escribiendo en salidas proyectadas: mismo resultado que imread + imwrite
+    auto strategy = FilterFactory::createFilter("auto");
+    const std::string edgesPath = (dir / "edges.pgm").string();
+    const std::string maskPath = (dir / "edges_threshold.pgm").string();
+    auto filterMapped = [&](const std::string& inputPath) {
+        MappedImage input = MappedImage::openPgm(inputPath);
+        MappedImage edges = MappedImage::createPgm(edgesPath, input.rows(), input.cols());
+        MappedImage mask = MappedImage::createPgm(maskPath, input.rows(), input.cols());
+        cv::Mat edgesView = edges.mat();
+        cv::Mat maskView = mask.mat();
+        strategy->detectEdgesInto(input.mat(), edgesView);
+        strategy->detectEdgesWithThresholdInto(input.mat(), maskView, 50);
+        return edgesView.data == edges.mat().data && maskView.data == mask.mat().data;
+    };
+    {
+        bool inPlace = filterMapped(pgm);
+        auto expectedEdges = strategy->detectEdges(gray);
+        auto expectedMask = strategy->detectEdgesWithThreshold(gray, 50);
+        bool ok = inPlace && expectedEdges && expectedMask &&
+                  sameImage(cv::imread(edgesPath, cv::IMREAD_GRAYSCALE), *expectedEdges) &&
+                  sameImage(cv::imread(maskPath, cv::IMREAD_GRAYSCALE), *expectedMask);
+        std::cout << (ok ? "✅" : "❌") << " Filtro en salidas proyectadas idéntico a imread + imwrite" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: imread/imwrite (PNG y PGM) frente a la ruta proyectada
+    const int width = 3840;
+    const int height = 2160;
+    const int runs = 5;
+    cv::Mat frame = createTestImage(width, height);
+    const std::string framePgm = (dir / "frame.pgm").string();
+    const std::string framePng = (dir / "frame.png").string();
+    cv::imwrite(framePgm, frame);
+    cv::imwrite(framePng, frame);
+
+    auto codecRun = [&](const std::string& inputPath, const std::string& ext) {
+        cv::Mat image = cv::imread(inputPath, cv::IMREAD_GRAYSCALE);
+        cv::Mat edges, mask;
+        strategy->detectEdgesInto(image, edges);
+        strategy->detectEdgesWithThresholdInto(image, mask, 50);
+        cv::imwrite((dir / ("codec_edges" + ext)).string(), edges);
+        cv::imwrite((dir / ("codec_mask" + ext)).string(), mask);
+    };
+
+    filterMapped(framePgm);   // Memoria de trabajo de la estrategia ya reservada
+    AllocationCount mappedAllocs = countAllocations(1, [&](int) { filterMapped(framePgm); });
+    {
+        bool ok = mappedAllocs.bytes < frame.total() / 100;
+        std::cout << (ok ? "✅ " : "❌ ") << "Ruta proyectada sin buffers de imagen: " << mappedAllocs.bytes
+                  << " bytes reservados (imagen de " << frame.total() << ")" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    double pngMs = 0.0, pgmMs = 0.0, mappedMs = 0.0;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        codecRun(framePng, ".png");
+        pngMs += elapsedMs(start);
+        start = std::chrono::high_resolution_clock::now();
+        codecRun(framePgm, ".pgm");
+        pgmMs += elapsedMs(start);
+        start = std::chrono::high_resolution_clock::now();
+        filterMapped(framePgm);
+        mappedMs += elapsedMs(start);
+    }
+
+    std::cout << std::endl;
+    std::cout << "=== Lectura + filtro + escritura (" << width << "x" << height << ", media de " << runs
+              << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "imread/imwrite PNG: " << pngMs / runs << " ms" << std::endl;
+    std::cout << "imread/imwrite PGM: " << pgmMs / runs << " ms" << std::endl;
+    std::cout << "mmap PGM:           " << mappedMs / runs << " ms" << std::endl;
+
+    fs::remove_all(dir);
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include "sobel_filter.h"
+#include "sobel_filter_simd.h"
+#include "sobel_direction.h"
+#include "cpu_features.h"
+#include "test_utils.h"
+
+// Ruido con un círculo: aparecen gradientes en todas las direcciones
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar::all(255), -1);
+    return image;
+}
+
+// Sector con atan2 en double: el múltiplo de 45° más cercano (módulo 180° con 4 sectores)
+int referenceBin(int gx, int gy, DirectionBins bins) {
+    if (gx == 0 && gy == 0) {
+        return 0;
+    }
+    double degrees = std::atan2(static_cast<double>(gy), static_cast<double>(gx)) * 180.0 / CV_PI;
+    int sector = static_cast<int>(std::floor((degrees + 22.5) / 45.0));
+    sector = ((sector % 8) + 8) % 8;
+    return bins == DirectionBins::FOUR ? sector % 4 : sector;
+}
+
+cv::Mat referenceDirection(const cv::Mat& gray, DirectionBins bins) {
+    cv::Mat direction = cv::Mat::zeros(gray.size(), CV_8UC1);
+    for (int i = 1; i < gray.rows - 1; i++) {
+        for (int j = 1; j < gray.cols - 1; j++) {
+            auto px = [&](int di, int dj) { return static_cast<int>(gray.at<uchar>(i + di, j + dj)); };
+            int gx = (px(-1, 1) - px(-1, -1)) + 2 * (px(0, 1) - px(0, -1)) + (px(1, 1) - px(1, -1));
+            int gy = (px(1, -1) + 2 * px(1, 0) + px(1, 1)) - (px(-1, -1) + 2 * px(-1, 0) + px(-1, 1));
+            direction.at<uchar>(i, j) = static_cast<uchar>(referenceBin(gx, gy, bins));
+        }
+    }
+    return direction;
+}
+
+int main() {
+    std::cout << "=== Prueba de Direcciones Cuantizadas (4/8 sectores) ===" << std::endl;
+    std::cout << "CPU: " << CpuFeatures::get().toString() << std::endl;
+
+    bool allPassed = true;
+    const DirectionBins binModes[] = {DirectionBins::FOUR, DirectionBins::EIGHT};
+
+    // Todos los gradientes posibles con entrada de 8 bits: mismo sector que atan2
+    {
+        int mismatches = 0;
+        for (int gx = -1020; gx <= 1020; gx++) {
+            for (int gy = -1020; gy <= 1020; gy++) {
+                for (DirectionBins bins : binModes) {
+                    if (sobelDirectionBin(gx, gy, bins) != referenceBin(gx, gy, bins)) {
+                        mismatches++;
+                    }
+                }
+            }
+        }
+        std::cout << (mismatches == 0 ? "✅" : "❌") << " sobelDirectionBin frente a atan2 en [-1020, 1020]²: "
+                  << mismatches << " diferencias" << std::endl;
+        allPassed = allPassed && mismatches == 0;
+    }
+
+    // Cada variante SIMD: sectores iguales a la referencia y magnitud igual a applySobel
+    const std::vector<cv::Size> sizes = {cv::Size(3, 3), cv::Size(18, 5), cv::Size(67, 31), cv::Size(640, 480)};
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (!SobelFilterSIMD::isLevelSupported(level)) {
+            continue;
+        }
+        int failures = 0;
+        for (const cv::Size& size : sizes) {
+            cv::Mat image = createTestImage(size.width, size.height);
+            for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+                SobelFilterSIMD filter(level, mode);
+                for (DirectionBins bins : binModes) {
+                    cv::Mat magnitude, direction, scratch;
+                    filter.applyDirectionInto(image, magnitude, direction, bins, scratch);
+                    if (!sameImage(direction, referenceDirection(image, bins)) ||
+                        !sameImage(magnitude, filter.applySobel(image))) {
+                        failures++;
+                    }
+                }
+            }
+        }
+        std::cout << (failures == 0 ? "✅ " : "❌ ") << std::left << std::setw(8)
+                  << SobelFilterSIMD::levelToString(level) << " "
+                  << (failures == 0 ? "idéntico a la referencia" : std::to_string(failures) + " diferencias")
+                  << std::endl;
+        allPassed = allPassed && failures == 0;
+    }
+
+    // SobelFilter: la magnitud es la de applyFilter, con y sin normalize
+    {
+        cv::Mat color;
+        cv::cvtColor(createTestImage(161, 97), color, cv::COLOR_GRAY2BGR);
+        cv::Mat gray;
+        cv::cvtColor(color, gray, cv::COLOR_BGR2GRAY);
+        bool ok = true;
+        for (bool normalize : {true, false}) {
+            FilterConfig config;
+            config.normalize = normalize;
+            config.directionBins = DirectionBins::EIGHT;
+            SobelFilter filter(config);
+            cv::Mat direction;
+            auto magnitude = filter.applyFilterWithDirection(color, direction);
+            auto expected = filter.applyFilter(color);
+            ok = ok && magnitude && expected && sameImage(*magnitude, *expected) &&
+                 sameImage(direction, referenceDirection(gray, DirectionBins::EIGHT));
+        }
+        SobelFilter disabled;
+        cv::Mat direction;
+        ok = ok && !disabled.applyFilterWithDirection(color, direction);
+        std::cout << (ok ? "✅" : "❌") << " SobelFilter::applyFilterWithDirection (normalize on/off, NONE rechazado)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: comparaciones enteras en la misma pasada frente a Gx/Gy + atan2
+    const int width = 1920, height = 1080, runs = 10;
+    cv::Mat frame = createTestImage(width, height);
+    SobelFilterSIMD simd;
+    cv::Mat magnitude, direction, scratch, gx, gy, angle;
+
+    auto timeMs = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < runs; r++) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+    };
+
+    double magnitudeMs = timeMs([&] { simd.applySobelInto(frame, magnitude, scratch); });
+    double binsMs = timeMs([&] { simd.applyDirectionInto(frame, magnitude, direction, DirectionBins::EIGHT, scratch); });
+    double atan2Ms = timeMs([&] {
+        simd.applySobelInto(frame, magnitude, scratch);
+        cv::Sobel(frame, gx, CV_32F, 1, 0);
+        cv::Sobel(frame, gy, CV_32F, 0, 1);
+        angle.create(frame.size(), CV_8UC1);
+        for (int i = 0; i < frame.rows; i++) {
+            const float* x = gx.ptr<float>(i);
+            const float* y = gy.ptr<float>(i);
+            uchar* a = angle.ptr<uchar>(i);
+            for (int j = 0; j < frame.cols; j++) {
+                float degrees = std::atan2(y[j], x[j]) * 57.29578f + 22.5f;
+                a[j] = static_cast<uchar>(static_cast<int>(std::floor(degrees / 45.0f) + 8) % 8);
+            }
+        }
+    });
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << ", 8 sectores, "
+              << SobelFilterSIMD::levelToString(simd.getLevel()) << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Solo magnitud:                     " << magnitudeMs << " ms" << std::endl;
+    std::cout << "Magnitud + sectores (una pasada):  " << binsMs << " ms" << std::endl;
+    std::cout << "Magnitud + 2x cv::Sobel + atan2:   " << atan2Ms << " ms" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "sobel_filter.h"
+#include "test_utils.h"
+
+// Imagen BGR con ruido y formas: bordes en todas las direcciones
+cv::Mat createTestImage(int width, int height, int seed) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(30 + seed, 120, 200));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::max(1, std::min(width, height) / 3),
+               cv::Scalar(250, 240, 10), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(96));
+    return image + noise;
+}
+
+// Cota de la magnitud si el gris suavizado difiere ±1 de cv::GaussianBlur:
+// cada gradiente cambia como mucho 8 (suma de |coeficientes| del kernel 3x3)
+int blurBound(MagnitudeMode mode) {
+    switch (mode) {
+        case MagnitudeMode::L1:   return 16;
+        case MagnitudeMode::LINF: return 8;
+        default:                  return 12;   // ceil(sqrt(8² + 8²)) tras truncar
+    }
+}
+
+int maxDifference(const cv::Mat& a, const cv::Mat& b) {
+    return static_cast<int>(cv::norm(a, b, cv::NORM_INF));
+}
+
+// Impulsos de una columna cada 6 (incluidas la primera y la última) con filas
+// iguales: el blur no mezcla filas y, sin gradiente vertical, la magnitud LINF
+// junto a un impulso es 4 * (gris suavizado en el impulso o su vecino)
+cv::Mat createImpulseImage(int width, int height) {
+    cv::Mat row = cv::Mat::zeros(1, width, CV_8UC1);
+    for (int j = 0; j < width; j += 6) {
+        row.at<uchar>(0, j) = static_cast<uchar>(1 + (j * 7) % 63);   // 4 * 63 no satura
+    }
+    row.at<uchar>(0, width - 1) = 50;
+    return cv::repeat(row, height, 1);
+}
+
+struct Case {
+    std::string name;
+    cv::Mat input;
+};
+
+int main() {
+    std::cout << "=== Prueba del Pipeline Fusionado (gris + blur + Sobel + umbral) ===" << std::endl;
+
+    // BGR, gris, ROI (step mayor que el ancho) y tamaños límite de 3 filas o 3 columnas
+    cv::Mat large = createTestImage(173, 101, 0);
+    cv::Mat largeGray;
+    cv::cvtColor(large, largeGray, cv::COLOR_BGR2GRAY);
+    std::vector<Case> cases = {
+        {"BGR 173x101", large},
+        {"Gris 173x101", largeGray},
+        {"ROI BGR", large(cv::Rect(7, 5, 131, 67))},
+        {"ROI gris", largeGray(cv::Rect(13, 3, 97, 89))},
+        {"BGR 3xN", createTestImage(64, 3, 1)},
+        {"Gris Nx3", largeGray(cv::Rect(40, 0, 3, 101))},
+        {"BGR 3x3", createTestImage(3, 3, 2)},
+        {"Gris 2xN", largeGray.rowRange(0, 2)},
+    };
+    const std::vector<int> thresholds = {0, 50, 128, 254, 255};
+    const MagnitudeMode modes[] = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+
+    bool allPassed = true;
+
+    // Sin blur: idéntico al recorrido clásico (también sin normalizar)
+    for (const Case& test : cases) {
+        bool ok = true;
+        for (MagnitudeMode mode : modes) {
+            for (bool normalize : {true, false}) {
+                FilterConfig classicConfig;
+                classicConfig.magnitudeMode = mode;
+                classicConfig.normalize = normalize;
+                FilterConfig fusedConfig = classicConfig;
+                fusedConfig.fusedPipeline = true;
+                SobelFilter classic(classicConfig), fused(fusedConfig);
+
+                auto expected = classic.applyFilter(test.input);
+                auto actual = fused.applyFilter(test.input);
+                ok = ok && expected && actual && sameImage(*actual, *expected);
+                for (int threshold : thresholds) {
+                    auto expectedMask = classic.applyFilterWithThreshold(test.input, threshold);
+                    auto actualMask = fused.applyFilterWithThreshold(test.input, threshold);
+                    ok = ok && expectedMask && actualMask && sameImage(*actualMask, *expectedMask);
+                }
+            }
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << "Sin blur, " << test.name << ": idéntico (3 modos, con y sin normalize)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Con blur: kernel en punto fijo, el gris suavizado difiere ±1 de cv::GaussianBlur
+    for (const Case& test : cases) {
+        bool ok = true;
+        int worst = 0;
+        for (MagnitudeMode mode : modes) {
+            for (double sigma : {0.8, 1.0, 2.0}) {
+                FilterConfig classicConfig;
+                classicConfig.magnitudeMode = mode;
+                classicConfig.useGaussianBlur = true;
+                classicConfig.gaussianSigma = sigma;
+                FilterConfig fusedConfig = classicConfig;
+                fusedConfig.fusedPipeline = true;
+                SobelFilter classic(classicConfig), fused(fusedConfig);
+
+                auto expected = classic.applyFilter(test.input);
+                auto actual = fused.applyFilter(test.input);
+                if (!expected || !actual || expected->size() != actual->size()) {
+                    ok = false;
+                    continue;
+                }
+                int difference = maxDifference(*actual, *expected);
+                worst = std::max(worst, difference);
+                ok = ok && difference <= blurBound(mode);
+
+                // La máscara solo puede cambiar donde la magnitud clásica está a menos de la cota del umbral
+                for (int threshold : thresholds) {
+                    auto expectedMask = classic.applyFilterWithThreshold(test.input, threshold);
+                    auto actualMask = fused.applyFilterWithThreshold(test.input, threshold);
+                    if (!expectedMask || !actualMask || expectedMask->size() != actualMask->size()) {
+                        ok = false;
+                        continue;
+                    }
+                    cv::Mat changed, distance, far, farChanged;
+                    cv::compare(*actualMask, *expectedMask, changed, cv::CMP_NE);
+                    cv::absdiff(*expected, cv::Scalar::all(threshold), distance);
+                    cv::compare(distance, blurBound(mode), far, cv::CMP_GT);
+                    cv::bitwise_and(changed, far, farChanged);
+                    ok = ok && cv::countNonZero(farChanged) == 0;
+                }
+            }
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << "Con blur, " << test.name << ": diferencia máxima " << worst
+                  << " (cota por ±1 en el gris suavizado)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // El propio gris suavizado: ±1 frente a cv::GaussianBlur, bordes reflejados incluidos
+    {
+        bool ok = true;
+        for (double sigma : {0.8, 1.0, 2.0}) {
+            FilterConfig classicConfig;
+            classicConfig.magnitudeMode = MagnitudeMode::LINF;
+            classicConfig.useGaussianBlur = true;
+            classicConfig.gaussianSigma = sigma;
+            FilterConfig fusedConfig = classicConfig;
+            fusedConfig.fusedPipeline = true;
+            SobelFilter classic(classicConfig), fused(fusedConfig);
+
+            // Columnas (blur horizontal) y, traspuesta, filas (blur vertical)
+            cv::Mat columns = createImpulseImage(61, 5);
+            cv::Mat rows;
+            cv::transpose(createImpulseImage(61, 3), rows);
+            for (const cv::Mat& input : {columns, rows}) {
+                auto expected = classic.applyFilter(input);
+                auto actual = fused.applyFilter(input);
+                ok = ok && expected && actual && maxDifference(*actual, *expected) <= 4;
+            }
+        }
+        std::cout << (ok ? "✅" : "❌") << " Gris suavizado a ±1 de cv::GaussianBlur (impulsos, sigma 0.8/1/2)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: recorrido clásico frente al fusionado en un fotograma BGR 1920x1080
+    const int runs = 5;
+    cv::Mat frame = createTestImage(1920, 1080, 3);
+    std::cout << std::endl;
+    std::cout << "=== Umbral sobre 1920x1080 BGR (media de " << runs << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    for (bool blur : {false, true}) {
+        FilterConfig classicConfig;
+        classicConfig.useGaussianBlur = blur;
+        FilterConfig fusedConfig = classicConfig;
+        fusedConfig.fusedPipeline = true;
+        double times[2] = {0.0, 0.0};
+        const SobelFilter filters[2] = {SobelFilter(classicConfig), SobelFilter(fusedConfig)};
+        for (int f = 0; f < 2; f++) {
+            auto start = std::chrono::high_resolution_clock::now();
+            for (int r = 0; r < runs; r++) {
+                filters[f].applyFilterWithThreshold(frame, 50);
+            }
+            auto end = std::chrono::high_resolution_clock::now();
+            times[f] = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+        }
+        std::cout << (blur ? "Con blur: " : "Sin blur: ") << "clásico " << times[0] << " ms, fusionado "
+                  << times[1] << " ms (" << times[0] / times[1] << "x)" << std::endl;
+    }
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,206 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "sobel_filter_simd.h"
+#include "sobel_gradients.h"
+#include "cpu_features.h"
+#include "test_utils.h"
+
+// Imagen de prueba: ruido con bordes nítidos en las cuatro direcciones
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar::all(255), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar::all(0), -1);
+    return image;
+}
+
+// Gx/Gy de referencia con los kernels 3x3 escritos a mano; marco a 0
+void referenceGradients(const cv::Mat& gray, cv::Mat& gx, cv::Mat& gy) {
+    gx = cv::Mat::zeros(gray.size(), CV_16SC1);
+    gy = cv::Mat::zeros(gray.size(), CV_16SC1);
+    for (int i = 1; i < gray.rows - 1; i++) {
+        for (int j = 1; j < gray.cols - 1; j++) {
+            auto px = [&](int di, int dj) { return static_cast<int>(gray.at<uchar>(i + di, j + dj)); };
+            gx.at<int16_t>(i, j) = static_cast<int16_t>((px(-1, 1) - px(-1, -1)) + 2 * (px(0, 1) - px(0, -1)) +
+                                                        (px(1, 1) - px(1, -1)));
+            gy.at<int16_t>(i, j) = static_cast<int16_t>((px(1, -1) + 2 * px(1, 0) + px(1, 1)) -
+                                                        (px(-1, -1) + 2 * px(-1, 0) + px(-1, 1)));
+        }
+    }
+}
+
+// Separa una salida CV_16SC2 en sus dos planos
+void splitInterleaved(const cv::Mat& gxy, cv::Mat& gx, cv::Mat& gy) {
+    std::vector<cv::Mat> planes;
+    cv::split(gxy, planes);
+    gx = planes[0];
+    gy = planes[1];
+}
+
+bool matchesReference(const SobelGradients& gradients, GradientLayout layout, const cv::Mat& gray) {
+    cv::Mat expectedGx, expectedGy, gx, gy;
+    referenceGradients(gray, expectedGx, expectedGy);
+    if (layout == GradientLayout::INTERLEAVED) {
+        if (gradients.gxy.type() != CV_16SC2) {
+            return false;
+        }
+        splitInterleaved(gradients.gxy, gx, gy);
+    } else {
+        gx = gradients.gx;
+        gy = gradients.gy;
+    }
+    return sameImage(gx, expectedGx) && sameImage(gy, expectedGy);
+}
+
+int main() {
+    std::cout << "=== Prueba de Gradientes con Signo (Gx, Gy) ===" << std::endl;
+    std::cout << "CPU: " << CpuFeatures::get().toString() << std::endl;
+
+    bool allPassed = true;
+    const std::vector<cv::Size> sizes = {cv::Size(3, 3), cv::Size(18, 5), cv::Size(67, 31), cv::Size(640, 480)};
+    const GradientLayout layouts[] = {GradientLayout::INTERLEAVED, GradientLayout::PLANAR};
+
+    // Cada variante SIMD: Gx/Gy iguales a la referencia, magnitud igual a applySobel
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (!SobelFilterSIMD::isLevelSupported(level)) {
+            continue;
+        }
+        int failures = 0;
+        for (const cv::Size& size : sizes) {
+            cv::Mat image = createTestImage(size.width, size.height);
+            for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+                SobelFilterSIMD filter(level, mode);
+                for (GradientLayout layout : layouts) {
+                    SobelGradients gradients;
+                    cv::Mat scratch;
+                    filter.applyGradientsInto(image, gradients, layout, scratch);
+                    if (!matchesReference(gradients, layout, image) ||
+                        !sameImage(gradients.magnitude, filter.applySobel(image))) {
+                        failures++;
+                    }
+                }
+            }
+        }
+        std::cout << (failures == 0 ? "✅ " : "❌ ") << std::left << std::setw(8)
+                  << SobelFilterSIMD::levelToString(level) << " "
+                  << (failures == 0 ? "idéntico a la referencia" : std::to_string(failures) + " diferencias")
+                  << std::endl;
+        allPassed = allPassed && failures == 0;
+    }
+
+    // Todas las estrategias: la magnitud coincide con detectEdges (Sobel para Canny) y Gx/Gy con la referencia
+    cv::Mat color;
+    cv::cvtColor(createTestImage(161, 97), color, cv::COLOR_GRAY2BGR);
+    cv::Mat gray;
+    cv::cvtColor(color, gray, cv::COLOR_BGR2GRAY);
+    for (FilterFactory::FilterType type : FilterFactory::getAvailableFilterTypes()) {
+        auto strategy = FilterFactory::createFilter(type);
+        if (!strategy) {
+            continue;
+        }
+        // Canny devuelve bordes binarios: su magnitud es la del Sobel vectorizado
+        auto edges = type == FilterFactory::FilterType::CANNY
+                         ? std::optional<cv::Mat>(SobelFilterSIMD(SobelFilterSIMD::detectBestLevel(),
+                                                                  strategy->getMagnitudeMode()).applySobel(gray))
+                         : strategy->detectEdges(color);
+        bool ok = true, supported = true;
+        for (GradientLayout layout : layouts) {
+            auto gradients = strategy->detectGradients(color, layout);
+            if (!gradients) {
+                supported = false;
+                break;
+            }
+            ok = ok && edges && sameImage(gradients->magnitude, *edges) && matchesReference(*gradients, layout, gray);
+        }
+        if (!supported) {
+            std::cout << "➖ " << strategy->getName() << ": sin salida de gradientes" << std::endl;
+            continue;
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << strategy->getName() << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Convenio de signo: rampa horizontal creciente -> Gx > 0, Gy = 0
+    {
+        cv::Mat ramp(8, 64, CV_8UC1);
+        for (int j = 0; j < ramp.cols; j++) {
+            ramp.col(j).setTo(cv::Scalar::all(j * 4));
+        }
+        cv::Mat vertical;
+        cv::transpose(ramp, vertical);
+        auto strategy = FilterFactory::createFilter(FilterFactory::FilterType::SOBEL_SIMD);
+        auto gradients = strategy->detectGradients(vertical, GradientLayout::PLANAR);
+        auto horizontal = strategy->detectGradients(ramp, GradientLayout::PLANAR);
+        bool ok = gradients && horizontal &&
+                  horizontal->gx.at<int16_t>(4, 10) == 32 && horizontal->gy.at<int16_t>(4, 10) == 0 &&
+                  gradients->gy.at<int16_t>(10, 4) == 32 && gradients->gx.at<int16_t>(10, 4) == 0;
+        std::cout << (ok ? "✅" : "❌") << " Signo: Gx crece hacia la derecha, Gy hacia abajo" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Entradas no admitidas y buffers reutilizados
+    {
+        auto strategy = FilterFactory::createFilter(FilterFactory::FilterType::SOBEL_SIMD);
+        cv::Mat deep(32, 32, CV_16UC1, cv::Scalar::all(1000));
+        SobelGradients gradients;
+        bool rejected = !strategy->detectGradientsInto(deep, gradients);
+
+        cv::Mat image = createTestImage(320, 240);
+        strategy->detectGradientsInto(image, gradients, GradientLayout::INTERLEAVED);
+        const uchar* magnitudeData = gradients.magnitude.data;
+        const uchar* gxyData = gradients.gxy.data;
+        strategy->detectGradientsInto(image, gradients, GradientLayout::INTERLEAVED);
+        bool reused = gradients.magnitude.data == magnitudeData && gradients.gxy.data == gxyData;
+        std::cout << (rejected && reused ? "✅" : "❌")
+                  << " 16 bits rechazado; buffers reutilizados entre llamadas" << std::endl;
+        allPassed = allPassed && rejected && reused;
+    }
+
+    // Rendimiento: una pasada frente a magnitud + dos cv::Sobel para recuperar Gx/Gy
+    const int width = 1920, height = 1080, runs = 20;
+    cv::Mat frame = createTestImage(width, height);
+    SobelFilterSIMD simd;
+    SobelGradients gradients;
+    cv::Mat scratch, magnitude, gx, gy;
+
+    auto timeMs = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < runs; r++) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+    };
+
+    double magnitudeMs = timeMs([&] { simd.applySobelInto(frame, magnitude, scratch); });
+    double interleavedMs = timeMs([&] { simd.applyGradientsInto(frame, gradients, GradientLayout::INTERLEAVED, scratch); });
+    double planarMs = timeMs([&] { simd.applyGradientsInto(frame, gradients, GradientLayout::PLANAR, scratch); });
+    double separateMs = timeMs([&] {
+        simd.applySobelInto(frame, magnitude, scratch);
+        cv::Sobel(frame, gx, CV_16S, 1, 0);
+        cv::Sobel(frame, gy, CV_16S, 0, 1);
+    });
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << ", "
+              << SobelFilterSIMD::levelToString(simd.getLevel()) << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Solo magnitud:                   " << magnitudeMs << " ms" << std::endl;
+    std::cout << "Magnitud + Gx/Gy intercalados:   " << interleavedMs << " ms" << std::endl;
+    std::cout << "Magnitud + Gx/Gy en planos:      " << planarMs << " ms" << std::endl;
+    std::cout << "Magnitud + 2x cv::Sobel CV_16S:  " << separateMs << " ms" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
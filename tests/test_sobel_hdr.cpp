@@ -0,0 +1,201 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include "sobel_filter.h"
+#include "sobel_filter_hdr.h"
+#include "sobel_filter_simd.h"
+#include "cpu_features.h"
+
+// Fotograma de 16 bits: ruido en todo el rango más un par de formas
+cv::Mat createDeepImage(int width, int height, int maxValue) {
+    cv::Mat image(height, width, CV_16UC1);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(maxValue + 1));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar::all(maxValue), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar::all(0), -1);
+    return image;
+}
+
+// Sobel 3x3 de referencia en double; salida = min(magnitud * escala, máximo) truncada
+template <typename T>
+cv::Mat referenceHdr(const cv::Mat& input, MagnitudeMode mode, double scale, int outMax, int outType) {
+    cv::Mat output = cv::Mat::zeros(input.size(), outType);
+    for (int i = 1; i < input.rows - 1; i++) {
+        for (int j = 1; j < input.cols - 1; j++) {
+            auto px = [&](int di, int dj) { return static_cast<double>(input.at<T>(i + di, j + dj)); };
+            double gx = (px(-1, 1) - px(-1, -1)) + 2 * (px(0, 1) - px(0, -1)) + (px(1, 1) - px(1, -1));
+            double gy = (px(1, -1) + 2 * px(1, 0) + px(1, 1)) - (px(-1, -1) + 2 * px(-1, 0) + px(-1, 1));
+            double magnitude = mode == MagnitudeMode::L1   ? std::abs(gx) + std::abs(gy)
+                             : mode == MagnitudeMode::LINF ? std::max(std::abs(gx), std::abs(gy))
+                                                           : std::sqrt(gx * gx + gy * gy);
+            int value = static_cast<int>(std::min(magnitude * scale, static_cast<double>(outMax)));
+            if (outType == CV_16UC1) {
+                output.at<uint16_t>(i, j) = static_cast<uint16_t>(value);
+            } else {
+                output.at<uchar>(i, j) = static_cast<uchar>(value);
+            }
+        }
+    }
+    return output;
+}
+
+double maxDifference(const cv::Mat& a, const cv::Mat& b) {
+    if (a.size() != b.size() || a.type() != b.type()) {
+        return 1e9;
+    }
+    return cv::norm(a, b, cv::NORM_INF);
+}
+
+int main() {
+    std::cout << "=== Prueba de SobelFilterHDR (CV_16UC1 / CV_32FC1) ===" << std::endl;
+    std::cout << "CPU: " << CpuFeatures::get().toString() << std::endl;
+
+    std::vector<SimdLevel> levels;
+    for (SimdLevel level : {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512}) {
+        if (SobelFilterSIMD::isLevelSupported(level)) {
+            levels.push_back(level);
+        }
+    }
+
+    bool allPassed = true;
+    const std::vector<cv::Size> sizes = {cv::Size(3, 3), cv::Size(21, 5), cv::Size(67, 31), cv::Size(640, 480)};
+    const MagnitudeMode modes[] = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+
+    // 16 bits: idéntico a la referencia en double en todas las variantes
+    for (SimdLevel level : levels) {
+        int failures = 0;
+        for (const cv::Size& size : sizes) {
+            for (int range : {65535, 4095}) {
+                cv::Mat image = createDeepImage(size.width, size.height, range);
+                for (MagnitudeMode mode : modes) {
+                    for (HdrOutput output : {HdrOutput::MAGNITUDE_16U, HdrOutput::NORMALIZED_8U}) {
+                        SobelFilterHDR filter(level, mode, output);
+                        filter.setInputRange(range == 65535 ? 0 : range);
+                        int outMax = filter.outputMax();
+                        cv::Mat expected = referenceHdr<uint16_t>(image, mode, filter.scaleFor(CV_16U), outMax,
+                                                                  filter.outputType());
+                        if (maxDifference(filter.applySobel(image), expected) != 0) {
+                            failures++;
+                        }
+
+                        // Umbral en unidades de salida: igual que umbralizar la magnitud
+                        int threshold = outMax / 5;
+                        cv::Mat expectedMask;
+                        cv::compare(expected, cv::Scalar::all(threshold), expectedMask, cv::CMP_GT);
+                        if (maxDifference(filter.applySobelWithThreshold(image, threshold), expectedMask) != 0) {
+                            failures++;
+                        }
+                    }
+                }
+            }
+        }
+        std::cout << (failures == 0 ? "✅ " : "❌ ") << std::left << std::setw(8)
+                  << SobelFilterSIMD::levelToString(level) << " 16 bits: "
+                  << (failures == 0 ? "idéntico a la referencia" : std::to_string(failures) + " diferencias")
+                  << std::endl;
+        allPassed = allPassed && failures == 0;
+    }
+
+    // float: el orden de las operaciones puede mover el último bit, se admite ±1 en la salida
+    for (SimdLevel level : levels) {
+        double worst = 0;
+        for (const cv::Size& size : sizes) {
+            cv::Mat image;
+            createDeepImage(size.width, size.height, 65535).convertTo(image, CV_32F, 1.0 / 65535.0);
+            for (MagnitudeMode mode : modes) {
+                for (HdrOutput output : {HdrOutput::MAGNITUDE_16U, HdrOutput::NORMALIZED_8U}) {
+                    SobelFilterHDR filter(level, mode, output);
+                    cv::Mat expected = referenceHdr<float>(image, mode, filter.scaleFor(CV_32F), filter.outputMax(),
+                                                           filter.outputType());
+                    worst = std::max(worst, maxDifference(filter.applySobel(image), expected));
+                }
+            }
+        }
+        std::cout << (worst <= 1 ? "✅ " : "❌ ") << std::left << std::setw(8)
+                  << SobelFilterSIMD::levelToString(level) << " float: diferencia máxima " << worst << std::endl;
+        allPassed = allPassed && worst <= 1;
+    }
+
+    // Valores de 8 bits en un contenedor de 16 bits con rango 255: mismo resultado que la ruta de 8 bits
+    {
+        cv::Mat image8(97, 131, CV_8UC1);
+        cv::randu(image8, cv::Scalar::all(0), cv::Scalar::all(256));
+        cv::Mat image16;
+        image8.convertTo(image16, CV_16U);
+
+        FilterConfig config;
+        config.inputRange = 255;
+        SobelFilter filter(config);
+        auto from8 = filter.applyFilter(image8);
+        auto from16 = filter.applyFilter(image16);
+        bool same = from8 && from16 && maxDifference(*from8, *from16) == 0;
+        std::cout << (same ? "✅" : "❌") << " SobelFilter con CV_16UC1 (rango 255) coincide con CV_8UC1" << std::endl;
+        allPassed = allPassed && same;
+    }
+
+    // SobelFilter: tipo de salida y rango del umbral según hdrOutput; ROIs leídas en su sitio
+    {
+        cv::Mat parent = createDeepImage(200, 120, 65535);
+        cv::Mat roi = parent(cv::Rect(7, 5, 151, 101));
+
+        FilterConfig config;
+        config.hdrOutput = HdrOutput::MAGNITUDE_16U;
+        SobelFilter filter16(config);
+        auto magnitude = filter16.applyFilter(roi);
+        auto mask = filter16.applyFilterWithThreshold(roi, 20000);
+        SobelFilterHDR engine(SobelFilterSIMD::detectBestLevel(), MagnitudeMode::EXACT, HdrOutput::MAGNITUDE_16U);
+        bool ok = magnitude && magnitude->type() == CV_16UC1 &&
+                  maxDifference(*magnitude, engine.applySobel(roi.clone())) == 0 &&
+                  mask && mask->type() == CV_8UC1;
+
+        SobelFilter filter8;
+        ok = ok && !filter8.applyFilterWithThreshold(roi, 20000) && filter8.applyFilterWithThreshold(roi, 200);
+        std::cout << (ok ? "✅" : "❌") << " SobelFilter: salida de 16 bits, umbral en unidades de salida y ROIs" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: ruta nativa frente a convertir primero a 8 bits
+    const int width = 1280, height = 720, runs = 20;
+    cv::Mat frame = createDeepImage(width, height, 4095);
+    SobelFilterHDR hdr;
+    hdr.setInputRange(4095);
+    SobelFilterSIMD simd;
+
+    auto timeMs = [&](auto&& fn) {
+        fn();
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int r = 0; r < runs; r++) {
+            fn();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double, std::milli>(end - start).count() / runs;
+    };
+
+    cv::Mat output, converted;
+    double nativeMs = timeMs([&] { hdr.applySobelInto(frame, output); });
+    double convertMs = timeMs([&] {
+        frame.convertTo(converted, CV_8U, 255.0 / 4095.0);
+        output = simd.applySobel(converted);
+    });
+    hdr.setOutput(HdrOutput::MAGNITUDE_16U);
+    double native16Ms = timeMs([&] { hdr.applySobelInto(frame, output); });
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << ", 12 bits, "
+              << SobelFilterSIMD::levelToString(hdr.getLevel()) << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Nativo -> 8 bits normalizado:    " << nativeMs << " ms" << std::endl;
+    std::cout << "Nativo -> 16 bits:               " << native16Ms << " ms" << std::endl;
+    std::cout << "convertTo 8 bits + Sobel SIMD:   " << convertMs << " ms (pierde 4 bits antes del gradiente)" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
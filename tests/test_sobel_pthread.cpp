@@ -0,0 +1,196 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include "sobel_filter.h"
+#include "sobel_filter_pthread.h"
+#include "pthread_pool.h"
+#include "test_utils.h"
+
+// Imagen BGR con ruido y formas: bordes en todas las direcciones
+cv::Mat createTestImage(int width, int height, int seed) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(30 + seed, 120, 200));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::max(1, std::min(width, height) / 3),
+               cv::Scalar(250, 240, 10), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(96));
+    return image + noise;
+}
+
+// Hilos vivos del proceso según /proc (-1 si no está disponible)
+int processThreads() {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return std::stoi(line.substr(8));
+        }
+    }
+    return -1;
+}
+
+// Ejecuta numBands bandas y comprueba que cada una corre exactamente una vez
+bool runsEveryBandOnce(PThreadPool& pool, int numBands) {
+    std::vector<std::atomic<int>> runs(std::max(1, numBands));
+    for (auto& count : runs) {
+        count = 0;
+    }
+    pool.parallelFor(numBands, [&runs](int band) {
+        runs[band]++;
+    });
+    for (int band = 0; band < numBands; band++) {
+        if (runs[band] != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct Case {
+    std::string name;
+    cv::Mat input;
+};
+
+int main() {
+    std::cout << "=== Prueba del Filtro Sobel con pThreads y del Pool de Hilos ===" << std::endl;
+
+    bool allPassed = true;
+    const int manyThreads = static_cast<int>(std::max(8u, std::thread::hardware_concurrency()));
+
+    // Alturas que no dividen el número de hilos ni de bandas, ROIs y menos filas que bandas
+    cv::Mat large = createTestImage(173, 101, 0);
+    cv::Mat largeGray;
+    cv::cvtColor(large, largeGray, cv::COLOR_BGR2GRAY);
+    std::vector<Case> cases = {
+        {"BGR 173x101", large},
+        {"Gris 173x101", largeGray},
+        {"ROI BGR 131x67", large(cv::Rect(7, 5, 131, 67))},
+        {"ROI gris 97x89", largeGray(cv::Rect(13, 3, 97, 89))},
+        {"BGR 64x3", createTestImage(64, 3, 1)},
+        {"Gris 3x101", largeGray(cv::Rect(40, 0, 3, 101))},
+        {"BGR 50x7", createTestImage(50, 7, 2)},
+    };
+    const std::vector<int> thresholds = {0, 1, 50, 128, 254, 255};
+    const MagnitudeMode modes[] = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+
+    // pThreads frente al SobelFilter básico con 1, 2, 3 y N hilos (N >= 8 aunque haya menos núcleos)
+    for (int numThreads : {1, 2, 3, manyThreads}) {
+        SobelFilterPThread filter(numThreads);
+        bool ok = filter.getNumThreads() == numThreads;
+        for (const Case& test : cases) {
+            for (MagnitudeMode mode : modes) {
+                FilterConfig config;
+                config.magnitudeMode = mode;
+                SobelFilter basic(config);
+                filter.setMagnitudeMode(mode);
+
+                auto expected = basic.applyFilter(test.input);
+                cv::Mat actual = filter.applySobel(test.input);
+                ok = ok && expected && sameImage(actual, *expected) &&
+                     sameImage(filter.applySobelSequential(test.input), *expected);
+                for (int threshold : thresholds) {
+                    auto expectedMask = basic.applyFilterWithThreshold(test.input, threshold);
+                    ok = ok && expectedMask &&
+                         sameImage(filter.applySobelWithThreshold(test.input, threshold), *expectedMask) &&
+                         sameImage(filter.applyThreshold(actual, threshold), *expectedMask);
+                }
+            }
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << numThreads << " hilo(s): idéntico a SobelFilter ("
+                  << cases.size() << " imágenes, 3 modos, " << thresholds.size() << " umbrales)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // El mismo pool sirve muchas llamadas seguidas con cualquier número de bandas
+    {
+        PThreadPool pool(4);
+        bool ok = pool.size() == 4;
+        for (int call = 0; call < 200; call++) {
+            ok = ok && runsEveryBandOnce(pool, call % 37);
+        }
+        std::cout << (ok ? "✅" : "❌") << " Pool reutilizado en 200 llamadas a parallelFor (0 a 36 bandas)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Varias llamadas a la vez desde hilos distintos: cada una espera solo a sus bandas
+    {
+        PThreadPool pool(3);
+        std::atomic<bool> ok{true};
+        std::vector<std::thread> callers;
+        for (int c = 0; c < 4; c++) {
+            callers.emplace_back([&pool, &ok, c]() {
+                for (int call = 0; call < 50; call++) {
+                    if (!runsEveryBandOnce(pool, 5 + c * 7)) {
+                        ok = false;
+                    }
+                }
+            });
+        }
+        for (std::thread& caller : callers) {
+            caller.join();
+        }
+        std::cout << (ok ? "✅" : "❌") << " parallelFor concurrente desde 4 hilos" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // El destructor despierta y une todos los hilos, usados o no
+    {
+        int before = processThreads();
+        for (int round = 0; round < 20; round++) {
+            PThreadPool idle(3);
+            PThreadPool used(manyThreads);
+            runsEveryBandOnce(used, 64);
+        }
+        {
+            SobelFilterPThread filter(4);
+            filter.applySobel(large);
+        }
+        int after = processThreads();
+        bool ok = before == after;
+        std::cout << (ok ? "✅" : "❌") << " Destructor: hilos del proceso antes " << before << ", después "
+                  << after << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: secuencial frente al pool en un fotograma BGR 1920x1080
+    const int runs = 5;
+    cv::Mat frame = createTestImage(1920, 1080, 3);
+    SobelFilterPThread filter(manyThreads);
+    filter.applySobel(frame);   // Primer frame fuera de la medida
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        filter.applySobelSequential(frame);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double sequentialMs = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        filter.applySobel(frame);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double parallelMs = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+
+    std::cout << std::endl;
+    std::cout << "=== Sobel sobre 1920x1080 BGR (media de " << runs << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Secuencial: " << sequentialMs << " ms" << std::endl;
+    std::cout << "pThreads (" << filter.getNumThreads() << " hilos): " << parallelMs << " ms ("
+              << sequentialMs / parallelMs << "x)" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
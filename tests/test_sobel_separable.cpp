@@ -0,0 +1,208 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include "sobel_filter_separable.h"
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+#include "test_utils.h"
+
+// Implementación de referencia (copiada de sobel_filter.cpp)
+// Para L1/L∞ se sustituye la raíz por la fórmula directa
+cv::Mat applySobelReference(const cv::Mat& inputImage, MagnitudeMode mode) {
+    const int sobelX[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    const int sobelY[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+
+    cv::Mat grayImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
+    } else {
+        grayImage = inputImage.clone();
+    }
+
+    cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+
+    for (int i = 1; i < grayImage.rows - 1; i++) {
+        for (int j = 1; j < grayImage.cols - 1; j++) {
+            int gx = 0, gy = 0;
+            for (int ki = -1; ki <= 1; ki++) {
+                for (int kj = -1; kj <= 1; kj++) {
+                    int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
+                    gx += pixelValue * sobelX[ki + 1][kj + 1];
+                    gy += pixelValue * sobelY[ki + 1][kj + 1];
+                }
+            }
+            double magnitude = std::sqrt(gx * gx + gy * gy);
+            if (mode == MagnitudeMode::L1) {
+                magnitude = std::abs(gx) + std::abs(gy);
+            } else if (mode == MagnitudeMode::LINF) {
+                magnitude = std::max(std::abs(gx), std::abs(gy));
+            }
+            magnitude = std::min(255.0, magnitude);
+            outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
+        }
+    }
+
+    return outputImage;
+}
+
+// Máscara de referencia: magnitud saturada > T; el marco solo es 255 con T < 0
+cv::Mat applyThresholdReference(const cv::Mat& inputImage, MagnitudeMode mode, int threshold) {
+    cv::Mat magnitude = applySobelReference(inputImage, mode);
+    cv::Mat mask(magnitude.size(), CV_8UC1, cv::Scalar(sobelBorderValue(true, threshold)));
+    for (int i = 1; i < magnitude.rows - 1; i++) {
+        for (int j = 1; j < magnitude.cols - 1; j++) {
+            mask.at<uchar>(i, j) = magnitude.at<uchar>(i, j) > threshold ? 255 : 0;
+        }
+    }
+    return mask;
+}
+
+// Imagen BGR con ruido y formas: bordes en todas las direcciones
+cv::Mat createTestImage(int width, int height, int seed) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(30 + seed, 120, 200));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::max(1, std::min(width, height) / 3),
+               cv::Scalar(250, 240, 10), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(96));
+    return image + noise;
+}
+
+// Ruido 0/255 en gris: gradientes extremos (gx² + gy² hasta 2 * 1020²)
+cv::Mat createContrastImage(int width, int height) {
+    cv::Mat noise(height, width, CV_8UC1), image;
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(256));
+    cv::compare(noise, 127, image, cv::CMP_GT);
+    return image;
+}
+
+struct Case {
+    std::string name;
+    cv::Mat input;
+};
+
+int main() {
+    std::cout << "=== Prueba del Filtro Sobel Separable (vs referencia y vs SIMD) ===" << std::endl;
+
+    bool allPassed = true;
+
+    // La raíz en float truncada coincide con la tabla en todo su rango y satura por encima
+    {
+        bool ok = true;
+        for (int n = 0; n <= 2 * 1020 * 1020; n++) {
+            int root = static_cast<int>(std::sqrt(static_cast<float>(n)));
+            ok = ok && (n < 65536 ? root == SOBEL_SQRT_LUT[n] : root >= 255);
+        }
+        std::cout << (ok ? "✅" : "❌") << " Raíz en float truncada == SOBEL_SQRT_LUT (gx² + gy² alcanzables)"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Gris, BGR, ROIs (step mayor que el ancho), contraste máximo y tamaños límite
+    cv::Mat large = createTestImage(173, 101, 0);
+    cv::Mat largeGray;
+    cv::cvtColor(large, largeGray, cv::COLOR_BGR2GRAY);
+    std::vector<Case> cases = {
+        {"BGR 173x101", large},
+        {"Gris 173x101", largeGray},
+        {"ROI BGR", large(cv::Rect(7, 5, 131, 67))},
+        {"ROI gris", largeGray(cv::Rect(13, 3, 97, 89))},
+        {"Gris 0/255", createContrastImage(129, 77)},
+        {"BGR 3x3", createTestImage(3, 3, 1)},
+        {"BGR 3xN", createTestImage(64, 3, 2)},
+        {"Gris Nx3", largeGray(cv::Rect(40, 0, 3, 101))},
+        {"Gris 4x4", largeGray(cv::Rect(0, 0, 4, 4))},
+        {"Gris 2xN", largeGray.rowRange(0, 2)},
+        {"BGR Nx1", large.colRange(0, 1)},
+        {"Gris 1x1", largeGray(cv::Rect(0, 0, 1, 1))},
+    };
+    const std::vector<int> thresholds = {-1, 0, 1, 50, 128, 254, 255};
+    const MagnitudeMode modes[] = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+    const SimdLevel level = SobelFilterSIMD::detectBestLevel();
+
+    for (const Case& test : cases) {
+        bool ok = true;
+        for (MagnitudeMode mode : modes) {
+            SobelFilterSeparable separable(mode);
+            SobelFilterSIMD simd(level, mode);
+
+            cv::Mat expected = applySobelReference(test.input, mode);
+            cv::Mat actual = separable.applySobel(test.input);
+            ok = ok && sameImage(actual, expected) && sameImage(actual, simd.applySobel(test.input));
+
+            for (int threshold : thresholds) {
+                cv::Mat expectedMask = applyThresholdReference(test.input, mode, threshold);
+                cv::Mat actualMask = separable.applySobelWithThreshold(test.input, threshold);
+                ok = ok && sameImage(actualMask, expectedMask) &&
+                     sameImage(actualMask, simd.applySobelWithThreshold(test.input, threshold));
+            }
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << test.name << ": idéntico (3 modos, magnitud y "
+                  << thresholds.size() << " umbrales)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Memoria de trabajo y salida reutilizadas entre tamaños, tipos, modos y umbrales
+    {
+        bool ok = true;
+        SobelFilterSeparable::Scratch scratch;
+        cv::Mat output;
+        SobelFilterSeparable separable;
+        for (int round = 0; round < 2; round++) {
+            for (const Case& test : cases) {
+                for (MagnitudeMode mode : modes) {
+                    separable.setMagnitudeMode(mode);
+                    separable.applySobelInto(test.input, output, scratch);
+                    ok = ok && sameImage(output, applySobelReference(test.input, mode));
+                    separable.applySobelWithThresholdInto(test.input, output, 50, scratch);
+                    ok = ok && sameImage(output, applyThresholdReference(test.input, mode, 50));
+                }
+            }
+        }
+        std::cout << (ok ? "✅" : "❌") << " applySobelInto/applySobelWithThresholdInto con Scratch reutilizado"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: separable frente a SIMD en un fotograma gris 1920x1080
+    const int runs = 10;
+    cv::Mat frame;
+    cv::cvtColor(createTestImage(1920, 1080, 3), frame, cv::COLOR_BGR2GRAY);
+    SobelFilterSeparable separable;
+    SobelFilterSIMD simd(level);
+    SobelFilterSeparable::Scratch scratch;
+    cv::Mat output, grayScratch;
+    separable.applySobelInto(frame, output, scratch);   // Memoria de trabajo reservada
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        separable.applySobelInto(frame, output, scratch);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double separableMs = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        simd.applySobelInto(frame, output, grayScratch);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    double simdMs = std::chrono::duration<double, std::milli>(end - start).count() / runs;
+
+    std::cout << std::endl;
+    std::cout << "=== Magnitud EXACT sobre 1920x1080 gris (media de " << runs << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Separable: " << separableMs << " ms" << std::endl;
+    std::cout << "SIMD (" << SobelFilterSIMD::levelToString(level) << "): " << simdMs << " ms" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
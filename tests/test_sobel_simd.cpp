@@ -0,0 +1,174 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <chrono>
+#include "sobel_filter_simd.h"
+#include "cpu_features.h"
+
+// Implementación de referencia (copiada de sobel_filter.cpp)
+// Para L1/L∞ se sustituye la raíz por la fórmula directa
+cv::Mat applySobelReference(const cv::Mat& inputImage, MagnitudeMode mode = MagnitudeMode::EXACT) {
+    const int sobelX[3][3] = {{-1, 0, 1}, {-2, 0, 2}, {-1, 0, 1}};
+    const int sobelY[3][3] = {{-1, -2, -1}, {0, 0, 0}, {1, 2, 1}};
+
+    cv::Mat grayImage;
+    if (inputImage.channels() == 3) {
+        cv::cvtColor(inputImage, grayImage, cv::COLOR_BGR2GRAY);
+    } else {
+        grayImage = inputImage.clone();
+    }
+
+    cv::Mat outputImage = cv::Mat::zeros(grayImage.size(), CV_8UC1);
+
+    for (int i = 1; i < grayImage.rows - 1; i++) {
+        for (int j = 1; j < grayImage.cols - 1; j++) {
+            int gx = 0, gy = 0;
+            for (int ki = -1; ki <= 1; ki++) {
+                for (int kj = -1; kj <= 1; kj++) {
+                    int pixelValue = static_cast<int>(grayImage.at<uchar>(i + ki, j + kj));
+                    gx += pixelValue * sobelX[ki + 1][kj + 1];
+                    gy += pixelValue * sobelY[ki + 1][kj + 1];
+                }
+            }
+            double magnitude = std::sqrt(gx * gx + gy * gy);
+            if (mode == MagnitudeMode::L1) {
+                magnitude = std::abs(gx) + std::abs(gy);
+            } else if (mode == MagnitudeMode::LINF) {
+                magnitude = std::max(std::abs(gx), std::abs(gy));
+            }
+            magnitude = std::min(255.0, magnitude);
+            outputImage.at<uchar>(i, j) = static_cast<uchar>(magnitude);
+        }
+    }
+
+    return outputImage;
+}
+
+// Función para crear una imagen de prueba con ruido (bordes fuertes y débiles)
+cv::Mat createTestImage(int width, int height, int type) {
+    cv::Mat image(height, width, type, cv::Scalar(128, 128, 128));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(255, 255, 255), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(256));
+    return image + noise;
+}
+
+// Umbral de referencia sobre la magnitud ya calculada (ruta original)
+cv::Mat applyThresholdReference(const cv::Mat& magnitude, int threshold) {
+    cv::Mat thresholdedImage = cv::Mat::zeros(magnitude.size(), CV_8UC1);
+    for (int i = 0; i < magnitude.rows; i++) {
+        for (int j = 0; j < magnitude.cols; j++) {
+            if (magnitude.at<uchar>(i, j) > threshold) {
+                thresholdedImage.at<uchar>(i, j) = 255;
+            }
+        }
+    }
+    return thresholdedImage;
+}
+
+int countDifferences(const cv::Mat& a, const cv::Mat& b) {
+    cv::Mat diff;
+    cv::compare(a, b, diff, cv::CMP_NE);
+    return cv::countNonZero(diff);
+}
+
+int main() {
+    std::cout << "=== Prueba del Filtro Sobel SIMD ===" << std::endl;
+    std::cout << "Extensiones de la CPU: " << CpuFeatures::get().toString() << std::endl;
+    std::cout << "Mejor variante detectada: "
+              << SobelFilterSIMD::levelToString(SobelFilterSIMD::detectBestLevel()) << std::endl;
+
+    const std::vector<SimdLevel> levels = {SimdLevel::SCALAR, SimdLevel::SSE41, SimdLevel::AVX2, SimdLevel::AVX512};
+    const std::vector<MagnitudeMode> modes = {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF};
+    bool allPassed = true;
+
+    for (SimdLevel level : levels) {
+        if (!SobelFilterSIMD::isLevelSupported(level)) {
+            std::cout << "⚠️  " << SobelFilterSIMD::levelToString(level) << " no soportado, se omite" << std::endl;
+            continue;
+        }
+
+        for (MagnitudeMode mode : modes) {
+            SobelFilterSIMD filter(level, mode);
+            int failures = 0;
+
+            // Anchos pequeños e irregulares para cubrir las colas escalares
+            for (int width = 1; width <= 80; width++) {
+                cv::Mat image = createTestImage(width, 7, CV_8UC1);
+                failures += countDifferences(applySobelReference(image, mode), filter.applySobel(image)) != 0;
+            }
+
+            // Imagen en color de tamaño medio
+            cv::Mat colorImage = createTestImage(641, 479, CV_8UC3);
+            cv::Mat reference = applySobelReference(colorImage, mode);
+            failures += countDifferences(reference, filter.applySobel(colorImage)) != 0;
+
+            // Umbral directo (sin raíz) frente a umbralizar la magnitud, incluidos los extremos
+            for (int threshold : {-1, 0, 1, 50, 128, 254, 255, 300}) {
+                failures += countDifferences(applyThresholdReference(reference, threshold),
+                                             filter.applySobelWithThreshold(colorImage, threshold)) != 0;
+            }
+            for (int width = 1; width <= 80; width += 7) {
+                cv::Mat image = createTestImage(width, 5, CV_8UC1);
+                failures += countDifferences(applyThresholdReference(applySobelReference(image, mode), 50),
+                                             filter.applySobelWithThreshold(image, 50)) != 0;
+            }
+
+            // Máscara empaquetada: mismos bits que la de bytes y conteos con popcount
+            for (int threshold : {-1, 0, 50, 255}) {
+                cv::Mat mask = applyThresholdReference(reference, threshold);
+                EdgeBitmap bitmap = filter.applySobelPacked(colorImage, threshold);
+                failures += countDifferences(mask, bitmap.toMask()) != 0;
+                failures += bitmap.count() != static_cast<size_t>(cv::countNonZero(mask));
+                failures += bitmap.countRow(100) != cv::countNonZero(mask.row(100));
+                failures += bitmap.countTile(37, 21, 100, 50) != cv::countNonZero(mask(cv::Rect(37, 21, 100, 50)));
+                failures += bitmap.countTiles(64, 64).at<int>(2, 3) != cv::countNonZero(mask(cv::Rect(192, 128, 64, 64)));
+            }
+            for (int width = 1; width <= 80; width += 7) {
+                cv::Mat image = createTestImage(width, 5, CV_8UC1);
+                failures += countDifferences(filter.applySobelWithThreshold(image, 50),
+                                             filter.applySobelPacked(image, 50).toMask()) != 0;
+            }
+
+            std::string name = SobelFilterSIMD::levelToString(level) + "/" + magnitudeModeToString(mode);
+            if (failures == 0) {
+                std::cout << "✅ " << name << ": idéntico a la referencia" << std::endl;
+            } else {
+                std::cout << "❌ " << name << ": " << failures << " casos con diferencias" << std::endl;
+                allPassed = false;
+            }
+        }
+    }
+
+    // Comparación de rendimiento con la mejor variante
+    cv::Mat largeImage = createTestImage(1920, 1080, CV_8UC3);
+    SobelFilterSIMD bestFilter;
+
+    auto startRef = std::chrono::high_resolution_clock::now();
+    cv::Mat refResult = applySobelReference(largeImage);
+    auto endRef = std::chrono::high_resolution_clock::now();
+
+    auto startSimd = std::chrono::high_resolution_clock::now();
+    cv::Mat simdResult = bestFilter.applySobel(largeImage);
+    auto endSimd = std::chrono::high_resolution_clock::now();
+
+    auto durationRef = std::chrono::duration_cast<std::chrono::microseconds>(endRef - startRef);
+    auto durationSimd = std::chrono::duration_cast<std::chrono::microseconds>(endSimd - startSimd);
+
+    std::cout << std::endl;
+    std::cout << "=== Resultados de Rendimiento (1920x1080) ===" << std::endl;
+    std::cout << "Tiempo referencia: " << durationRef.count() << " microsegundos" << std::endl;
+    std::cout << "Tiempo SIMD:       " << durationSimd.count() << " microsegundos" << std::endl;
+    std::cout << "Speedup: " << static_cast<double>(durationRef.count()) / durationSimd.count() << "x" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,234 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "sobel_filter.h"
+
+// Imagen de prueba con bordes fuertes y ruido, escalada al rango de T
+template<typename T>
+cv::Mat createTestImage(int width, int height, double scale) {
+    cv::Mat image(height, width, CV_8UC1, cv::Scalar(128));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(255), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0), -1);
+    cv::Mat noise(image.size(), CV_8UC1);
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(40));
+    image = image + noise;
+
+    cv::Mat converted;
+    image.convertTo(converted, CV_MAKETYPE(SobelPixelTraits<T>::DEPTH, 1), scale);
+    return converted;
+}
+
+// Pesos de Sobel KxK recalculados aquí, independientes de SobelKernel
+int pascal(int n, int k) {
+    if (k < 0 || k > n) {
+        return 0;
+    }
+    int result = 1;
+    for (int i = 1; i <= k; i++) {
+        result = result * (n - k + i) / i;
+    }
+    return result;
+}
+
+int borderIndex(int i, int n, int border) {
+    if (border == 1) {
+        return std::min(std::max(i, 0), n - 1);
+    }
+    if (n == 1) {
+        return 0;
+    }
+    while (i < 0 || i >= n) {
+        i = (i < 0) ? -i : 2 * n - 2 - i;
+    }
+    return i;
+}
+
+// Sobel de referencia en double con kernel y borde en tiempo de ejecución
+// (border: 0 = marco a 0, 1 = replicar, 2 = reflejo 101)
+template<typename T>
+cv::Mat referenceSobel(const cv::Mat& gray, int k, int border, MagnitudeMode mode) {
+    const int off = k / 2;
+    cv::Mat output = cv::Mat::zeros(gray.size(), gray.type());
+    for (int i = 0; i < gray.rows; i++) {
+        for (int j = 0; j < gray.cols; j++) {
+            bool inside = i >= off && i < gray.rows - off && j >= off && j < gray.cols - off;
+            if (border == 0 && !inside) {
+                continue;
+            }
+            double gx = 0.0, gy = 0.0;
+            for (int r = 0; r < k; r++) {
+                for (int c = 0; c < k; c++) {
+                    double v = gray.at<T>(borderIndex(i + r - off, gray.rows, border),
+                                          borderIndex(j + c - off, gray.cols, border));
+                    int smoothR = pascal(k - 1, r), smoothC = pascal(k - 1, c);
+                    int derivR = pascal(k - 2, r - 1) - pascal(k - 2, r);
+                    int derivC = pascal(k - 2, c - 1) - pascal(k - 2, c);
+                    gx += smoothR * derivC * v;
+                    gy += derivR * smoothC * v;
+                }
+            }
+            double magnitude = mode == MagnitudeMode::L1   ? std::abs(gx) + std::abs(gy)
+                             : mode == MagnitudeMode::LINF ? std::max(std::abs(gx), std::abs(gy))
+                                                           : std::sqrt(gx * gx + gy * gy);
+            if constexpr (std::is_integral_v<T>) {
+                magnitude = std::floor(std::min(magnitude, static_cast<double>(std::numeric_limits<T>::max())));
+            }
+            output.at<T>(i, j) = static_cast<T>(magnitude);
+        }
+    }
+    return output;
+}
+
+// Diferencia máxima (relativa en float, donde el orden de las sumas cambia el redondeo)
+template<typename T>
+bool matches(const cv::Mat& a, const cv::Mat& b) {
+    if (a.size() != b.size() || a.type() != b.type()) {
+        return false;
+    }
+    for (int i = 0; i < a.rows; i++) {
+        for (int j = 0; j < a.cols; j++) {
+            double x = a.at<T>(i, j), y = b.at<T>(i, j);
+            double tolerance = std::is_floating_point_v<T> ? 1e-4 * std::max(1.0, std::abs(y)) : 0.0;
+            if (std::abs(x - y) > tolerance) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T, int K, typename Border>
+int checkAgainstReference(int border, double scale) {
+    int failures = 0;
+    for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+        SobelFilterTemplate<T, K, Border> filter;
+        filter.setMagnitudeMode(mode);
+        for (cv::Size size : {cv::Size(1, 1), cv::Size(2, 7), cv::Size(K, K), cv::Size(37, 23)}) {
+            cv::Mat image = createTestImage<T>(size.width, size.height, scale);
+            auto result = filter.applyFilter(image);
+            if (!result || !matches<T>(*result, referenceSobel<T>(image, K, border, mode))) {
+                std::cout << "❌ " << filter.getVariantName() << " (" << magnitudeModeToString(mode) << ") "
+                          << size.width << "x" << size.height << " difiere de la referencia" << std::endl;
+                failures++;
+            }
+        }
+    }
+    return failures;
+}
+
+// Mediana de varias ejecuciones en milisegundos
+template<typename Fn>
+double medianMs(Fn&& fn, int runs = 7) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+template<typename Filter>
+void benchmarkRow(const Filter& filter, const cv::Mat& image, double runtimeMs) {
+    double ms = medianMs([&] { filter.applyFilter(image); });
+    std::cout << std::left << std::setw(30) << Filter::getVariantName()
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << ms
+              << std::setw(11) << std::setprecision(1) << runtimeMs / ms << "x" << std::endl;
+}
+
+int main() {
+    std::cout << "=== Prueba de SobelFilterTemplate ===" << std::endl;
+    bool allPassed = true;
+
+    // uint8_t 3x3 sin borde: idéntico a SobelFilter (kernel en tiempo de ejecución)
+    int failures = 0;
+    for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+        FilterConfig config;
+        config.magnitudeMode = mode;
+        SobelFilter runtimeFilter(config);
+        SobelFilterTemplate<uint8_t> templateFilter(config);
+        for (cv::Size size : {cv::Size(1, 1), cv::Size(3, 3), cv::Size(64, 9), cv::Size(641, 479)}) {
+            cv::Mat image = createTestImage<uint8_t>(size.width, size.height, 1.0);
+            cv::Mat color;
+            cv::cvtColor(image, color, cv::COLOR_GRAY2BGR);
+            for (const cv::Mat& input : {image, color}) {
+                auto expected = runtimeFilter.applyFilter(input);
+                auto actual = templateFilter.applyFilter(input);
+                auto expectedMask = runtimeFilter.applyFilterWithThreshold(input, 60);
+                auto actualMask = templateFilter.applyFilterWithThreshold(input, 60);
+                if (!expected || !actual || !matches<uchar>(*expected, *actual) ||
+                    !expectedMask || !actualMask || !matches<uchar>(*expectedMask, *actualMask)) {
+                    failures++;
+                }
+            }
+        }
+    }
+    if (failures == 0) {
+        std::cout << "✅ SobelFilterTemplate<uint8_t> idéntico a SobelFilter (3 modos, gris y BGR, con umbral)" << std::endl;
+    } else {
+        std::cout << "❌ " << failures << " diferencias con SobelFilter" << std::endl;
+        allPassed = false;
+    }
+
+    // Cada combinación de tipo, kernel y borde contra la referencia en double
+    failures = 0;
+    failures += checkAgainstReference<uint8_t, 3, BorderReplicate>(1, 1.0);
+    failures += checkAgainstReference<uint8_t, 3, BorderReflect101>(2, 1.0);
+    failures += checkAgainstReference<uint8_t, 5, BorderSkip>(0, 1.0);
+    failures += checkAgainstReference<uint8_t, 5, BorderReflect101>(2, 1.0);
+    failures += checkAgainstReference<uint8_t, 7, BorderReplicate>(1, 1.0);
+    failures += checkAgainstReference<uint16_t, 3, BorderSkip>(0, 257.0);
+    failures += checkAgainstReference<uint16_t, 5, BorderReplicate>(1, 257.0);
+    failures += checkAgainstReference<float, 3, BorderSkip>(0, 1.0 / 255.0);
+    failures += checkAgainstReference<float, 7, BorderReflect101>(2, 1.0 / 255.0);
+    if (failures == 0) {
+        std::cout << "✅ uint8_t/uint16_t/float, 3x3/5x5/7x7 y los tres bordes coinciden con la referencia" << std::endl;
+    } else {
+        allPassed = false;
+    }
+
+    // Umbral fuera del rango del tipo
+    SobelFilterTemplate<uint16_t> deepFilter;
+    cv::Mat deepImage = createTestImage<uint16_t>(32, 32, 257.0);
+    if (deepFilter.applyFilterWithThreshold(deepImage, 70000) || !deepFilter.applyFilterWithThreshold(deepImage, 50000)) {
+        std::cout << "❌ Validación del umbral en uint16_t" << std::endl;
+        allPassed = false;
+    }
+
+    // Rendimiento frente al kernel recorrido en tiempo de ejecución
+    const int width = 1280, height = 720;
+    cv::Mat image8 = createTestImage<uint8_t>(width, height, 1.0);
+    cv::Mat image16 = createTestImage<uint16_t>(width, height, 257.0);
+    cv::Mat image32 = createTestImage<float>(width, height, 1.0 / 255.0);
+
+    SobelFilter runtimeFilter;
+    double runtimeMs = medianMs([&] { runtimeFilter.applyFilter(image8); });
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << ", mediana de 7) ===" << std::endl;
+    std::cout << std::left << std::setw(30) << "Variante" << std::right << std::setw(10) << "ms"
+              << std::setw(12) << "vs runtime" << std::endl;
+    std::cout << std::string(52, '-') << std::endl;
+    std::cout << std::left << std::setw(30) << "SobelFilter (runtime 3x3)"
+              << std::right << std::setw(10) << std::fixed << std::setprecision(2) << runtimeMs
+              << std::setw(11) << std::setprecision(1) << 1.0 << "x" << std::endl;
+    benchmarkRow(SobelFilterTemplate<uint8_t>(), image8, runtimeMs);
+    benchmarkRow(SobelFilterTemplate<uint8_t, 3, BorderReplicate>(), image8, runtimeMs);
+    benchmarkRow(SobelFilterTemplate<uint8_t, 5>(), image8, runtimeMs);
+    benchmarkRow(SobelFilterTemplate<uint16_t>(), image16, runtimeMs);
+    benchmarkRow(SobelFilterTemplate<float>(), image32, runtimeMs);
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
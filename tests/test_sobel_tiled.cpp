@@ -0,0 +1,160 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include "sobel_filter_tiled.h"
+#include "sobel_filter_simd.h"
+#include "filter_factory.h"
+#include "cpu_features.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Función para crear una imagen de prueba con ruido (bordes fuertes y débiles)
+cv::Mat createTestImage(int width, int height, int type) {
+    cv::Mat image(height, width, type, cv::Scalar(128, 128, 128));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(255, 255, 255), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(256));
+    return image + noise;
+}
+
+int countDifferences(const cv::Mat& a, const cv::Mat& b) {
+    cv::Mat diff;
+    cv::compare(a, b, diff, cv::CMP_NE);
+    return cv::countNonZero(diff);
+}
+
+// Mediana de varias ejecuciones en milisegundos
+template <typename Fn>
+double medianMs(Fn&& fn, int runs = 7) {
+    std::vector<double> times;
+    for (int r = 0; r < runs; r++) {
+        auto start = std::chrono::high_resolution_clock::now();
+        fn();
+        auto end = std::chrono::high_resolution_clock::now();
+        times.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    std::sort(times.begin(), times.end());
+    return times[times.size() / 2];
+}
+
+int main() {
+    std::cout << "=== Prueba del Filtro Sobel por Bloques ===" << std::endl;
+    std::cout << "L2 detectada: " << CpuFeatures::get().l2CacheBytes / 1024 << " KB" << std::endl;
+
+    SobelFilterSIMD reference;
+    bool allPassed = true;
+    int failures = 0;
+
+    // Bloques automáticos y fijos (incluidos anchos no múltiplos de 64, que se redondean)
+    const std::vector<cv::Size> tileSizes = {{0, 0}, {64, 8}, {64, 1}, {100, 7}, {512, 64}, {4096, 4096}};
+    for (const cv::Size& tileSize : tileSizes) {
+        SobelFilterTiled filter(tileSize.width, tileSize.height);
+
+        for (int width : {1, 2, 3, 63, 64, 65, 130, 641}) {
+            cv::Mat image = createTestImage(width, 37, CV_8UC1);
+            failures += countDifferences(reference.applySobel(image), filter.applySobel(image)) != 0;
+        }
+
+        cv::Mat colorImage = createTestImage(641, 479, CV_8UC3);
+        failures += countDifferences(reference.applySobel(colorImage), filter.applySobel(colorImage)) != 0;
+        for (int threshold : {-1, 0, 50, 255}) {
+            failures += countDifferences(reference.applySobelWithThreshold(colorImage, threshold),
+                                         filter.applySobelWithThreshold(colorImage, threshold)) != 0;
+        }
+    }
+
+    if (failures == 0) {
+        std::cout << "✅ Bloques automáticos y fijos: idéntico a SobelFilterSIMD" << std::endl;
+    } else {
+        std::cout << "❌ " << failures << " casos con diferencias" << std::endl;
+        allPassed = false;
+    }
+
+    // Anchos no múltiplos de 64: los hilos escriben en filas alineadas a 64 bytes
+    // y la salida del llamador (step = ancho) recibe la copia
+    {
+        SobelFilterTiled filter(64, 8);
+        SobelFilterTiled::Scratch scratch;
+        cv::Mat output;
+        bool ok = true;
+        for (int width : {65, 130, 641}) {
+            cv::Mat image = createTestImage(width, 53, CV_8UC1);
+            filter.applySobelInto(image, output, scratch);
+            ok = ok && countDifferences(reference.applySobel(image), output) == 0;
+            filter.applySobelWithThresholdInto(image, output, 50, scratch);
+            ok = ok && countDifferences(reference.applySobelWithThreshold(image, 50), output) == 0;
+
+            const cv::Mat& aligned = scratch.alignedOutput;
+            ok = ok && aligned.size() == image.size() &&
+                 aligned.step % SobelFilterTiled::TILE_ALIGN == 0 &&
+                 reinterpret_cast<uintptr_t>(aligned.data) % SobelFilterTiled::TILE_ALIGN == 0;
+        }
+        if (ok) {
+            std::cout << "✅ Anchos no múltiplos de 64: salida calculada con filas alineadas a 64 bytes" << std::endl;
+        } else {
+            std::cout << "❌ Salida con filas alineadas a 64 bytes" << std::endl;
+            allPassed = false;
+        }
+    }
+
+    // Curva de speedup frente a la versión collapse(2) por píxel
+    cv::Mat largeImage = createTestImage(3840, 2160, CV_8UC1);
+    auto collapsed = FilterFactory::createFilter(FilterFactory::FilterType::SOBEL_OMP);
+    SobelFilterTiled tiled;
+
+    int maxThreads = 1;
+#ifdef _OPENMP
+    maxThreads = omp_get_num_procs();
+#endif
+
+    std::cout << std::endl;
+    std::cout << "=== Curva de speedup (3840x2160, mediana de 7) ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "Hilos"
+              << std::setw(18) << "collapse(2) ms"
+              << std::setw(14) << "tiled ms"
+              << std::setw(16) << "simd 1 hilo ms"
+              << std::setw(12) << "speedup"
+              << std::setw(10) << "bloque" << std::endl;
+    std::cout << std::string(80, '-') << std::endl;
+
+    // 1, 2, 4, ... hasta el número de núcleos (incluido aunque no sea potencia de 2)
+    std::vector<int> threadCounts;
+    for (int threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(maxThreads);
+
+    for (int threads : threadCounts) {
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+        double collapsedMs = medianMs([&] { collapsed->detectEdges(largeImage); });
+        double tiledMs = medianMs([&] { tiled.applySobel(largeImage); });
+        // Mismo kernel SIMD sin bloques ni hilos: separa la parte debida a la vectorización
+        double simdMs = medianMs([&] { reference.applySobel(largeImage); });
+        cv::Size tile = tiled.getTileSize(largeImage.size());
+
+        std::cout << std::left << std::setw(10) << threads
+                  << std::setw(18) << std::fixed << std::setprecision(2) << collapsedMs
+                  << std::setw(14) << tiledMs
+                  << std::setw(16) << simdMs
+                  << std::setw(12) << (collapsedMs / tiledMs)
+                  << tile.width << "x" << tile.height << std::endl;
+    }
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
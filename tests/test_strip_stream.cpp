@@ -0,0 +1,196 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <filesystem>
+#include <vector>
+#include <chrono>
+#include "sobel_strip_stream.h"
+#include "sobel_filter_simd.h"
+#include "sobel_filter_tiled.h"
+#include "pnm_io.h"
+#include "alloc_counter.h"
+#include "test_utils.h"
+
+namespace fs = std::filesystem;
+
+// Ruido con formas: bordes en todas las direcciones
+cv::Mat createTestImage(int width, int height, int type) {
+    cv::Mat image(height, width, type, cv::Scalar(90, 120, 150));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(255, 200, 30), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(64));
+    return image + noise;
+}
+
+// PGM (gris) o PPM (BGR guardado como RGB), opcionalmente con un comentario en la cabecera
+void writePnm(const std::string& path, const cv::Mat& image, bool comment = false) {
+    std::ofstream file(path, std::ios::binary);
+    file << (image.channels() == 1 ? "P5\n" : "P6\n");
+    if (comment) {
+        file << "# generado por test_strip_stream\n";
+    }
+    file << image.cols << " " << image.rows << "\n255\n";
+    cv::Mat rgb = image;
+    if (image.channels() == 3) {
+        rgb.create(image.size(), CV_8UC3);
+        for (int i = 0; i < image.rows; i++) {
+            for (int j = 0; j < image.cols; j++) {
+                const uchar* p = image.ptr<uchar>(i) + 3 * j;
+                uchar* q = rgb.ptr<uchar>(i) + 3 * j;
+                q[0] = p[2];
+                q[1] = p[1];
+                q[2] = p[0];
+            }
+        }
+    }
+    for (int i = 0; i < rgb.rows; i++) {
+        file.write(reinterpret_cast<const char*>(rgb.ptr<uchar>(i)), static_cast<std::streamsize>(rgb.cols) * rgb.channels());
+    }
+}
+
+cv::Mat readPgm(const std::string& path) {
+    PnmReader reader(path);
+    cv::Mat image(reader.rows(), reader.cols(), CV_8UC1);
+    reader.readGrayRows(image);
+    return image;
+}
+
+int main() {
+    std::cout << "=== Prueba de Sobel en Streaming por Franjas ===" << std::endl;
+
+    const fs::path dir = fs::temp_directory_path() / "sobel_strip_stream_test";
+    fs::create_directories(dir);
+    const std::string input = (dir / "input.pnm").string();
+    const std::string output = (dir / "output.pgm").string();
+    const std::string mask = (dir / "mask.pgm").string();
+
+    SobelFilterSIMD reference;
+    bool allPassed = true;
+
+    // Franjas de cualquier alto (también 1 fila y más altas que la imagen) = imagen completa
+    {
+        int failures = 0, cases = 0;
+        const std::vector<cv::Size> sizes = {cv::Size(1, 1), cv::Size(5, 2), cv::Size(67, 3), cv::Size(130, 97),
+                                             cv::Size(641, 479)};
+        for (const cv::Size& size : sizes) {
+            for (int type : {CV_8UC1, CV_8UC3}) {
+                cv::Mat image = createTestImage(size.width, size.height, type);
+                writePnm(input, image, type == CV_8UC3);
+                cv::Mat expected = reference.applySobel(image);
+                cv::Mat expectedMask = reference.applySobelWithThreshold(image, 50);
+                for (int stripRows : {1, 2, 3, 7, 64, 1000}) {
+                    for (int depth : {1, 3}) {
+                        SobelStripStreamer streamer(stripRows, depth);
+                        streamer.process(input, output, mask, 50);
+                        failures += !sameImage(readPgm(output), expected) || !sameImage(readPgm(mask), expectedMask);
+                        cases++;
+                    }
+                }
+            }
+        }
+        std::cout << (failures == 0 ? "✅" : "❌") << " Magnitud y máscara idénticas a la imagen completa ("
+                  << cases - failures << "/" << cases << " casos)" << std::endl;
+        allPassed = allPassed && failures == 0;
+    }
+
+    // Solo una de las dos salidas
+    {
+        cv::Mat image = createTestImage(300, 200, CV_8UC1);
+        writePnm(input, image);
+        SobelStripStreamer streamer(16);
+        streamer.process(input, "", mask, 80);
+        bool ok = sameImage(readPgm(mask), reference.applySobelWithThreshold(image, 80));
+        streamer.process(input, output);
+        ok = ok && sameImage(readPgm(output), reference.applySobel(image));
+        std::cout << (ok ? "✅" : "❌") << " Solo magnitud / solo máscara" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Errores: fichero truncado (falla en el hilo lector), formato no PNM, sin salidas
+    {
+        auto throws = [](auto&& fn) {
+            try {
+                fn();
+            } catch (const std::exception&) {
+                return true;
+            }
+            return false;
+        };
+        cv::Mat image = createTestImage(256, 300, CV_8UC1);
+        writePnm(input, image);
+        fs::resize_file(input, fs::file_size(input) - 1000);
+        SobelStripStreamer streamer(32);
+        bool ok = throws([&] { streamer.process(input, output, mask); });
+
+        std::ofstream(input) << "no es una imagen";
+        ok = ok && throws([&] { streamer.process(input, output); }) && !PnmReader::isPnmFile(input);
+        ok = ok && throws([&] { streamer.process(input, "", ""); });
+        ok = ok && throws([&] { SobelStripStreamer(0); });
+        std::cout << (ok ? "✅" : "❌") << " Truncado, formato y parámetros rechazados" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Memoria acotada: la imagen alta no cambia lo que se reserva
+    {
+        cv::Mat image = createTestImage(2000, 3000, CV_8UC3);
+        writePnm(input, image);
+        SobelStripStreamer streamer(64);
+        StripStreamStats stats;
+        AllocationCount count = countAllocations(1, [&](int) { stats = streamer.process(input, output, mask); });
+        size_t imageBytes = image.total() * image.elemSize();
+        bool ok = count.bytes < imageBytes / 4 && stats.bufferBytes < imageBytes / 4;
+        std::cout << (ok ? "✅" : "❌") << " Memoria reservada: " << count.bytes / 1024 << " KB (franjas "
+                  << stats.bufferBytes / 1024 << " KB) para una imagen de " << imageBytes / 1024 << " KB"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: streaming frente a cargar todo, filtrar y escribir en secuencia
+    const int width = 8000, height = 6000;
+    cv::Mat large = createTestImage(width, height, CV_8UC3);
+    writePnm(input, large);
+    large.release();
+
+    auto start = std::chrono::high_resolution_clock::now();
+    {
+        PnmReader reader(input);
+        cv::Mat gray(reader.rows(), reader.cols(), CV_8UC1);
+        reader.readGrayRows(gray);
+        SobelFilterTiled tiled;
+        cv::Mat magnitude = tiled.applySobel(gray);
+        cv::Mat binary = tiled.applySobelWithThreshold(gray, 50);
+        PnmWriter magnitudeWriter(output, height, width);
+        magnitudeWriter.writeRows(magnitude);
+        magnitudeWriter.close();
+        PnmWriter maskWriter(mask, height, width);
+        maskWriter.writeRows(binary);
+        maskWriter.close();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double wholeMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+    SobelStripStreamer streamer;
+    StripStreamStats stats = streamer.process(input, output, mask, 50);
+
+    std::cout << std::endl;
+    std::cout << "=== Rendimiento (" << width << "x" << height << " PPM, franjas de "
+              << streamer.getStripRows() << " filas) ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Imagen completa en secuencia: " << wholeMs << " ms, "
+              << static_cast<double>(width) * height * 3 / (1024.0 * 1024.0) << " MB" << std::endl;
+    std::cout << "Streaming:                    " << stats.totalMs << " ms, "
+              << stats.bufferBytes / (1024.0 * 1024.0) << " MB" << std::endl;
+    std::cout << "Etapas: lectura " << stats.decodeMs << " ms, filtro " << stats.filterMs
+              << " ms, escritura " << stats.encodeMs << " ms" << std::endl;
+
+    fs::remove_all(dir);
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,180 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "sobel_filter.h"
+#include "sobel_filter_hdr.h"
+#include "sobel_filter_simd.h"
+#include "sobel_magnitude.h"
+#include "test_utils.h"
+
+// Imagen de prueba: fondo con ruido, un círculo y un rectángulo oscuro
+cv::Mat createTestImage(int width, int height) {
+    cv::Mat image(height, width, CV_8UC3, cv::Scalar(60, 110, 150));
+    cv::circle(image, cv::Point(width / 2, height / 2), std::min(width, height) / 3, cv::Scalar(250, 250, 250), -1);
+    cv::rectangle(image, cv::Point(width / 8, height / 8), cv::Point(width / 3, height / 3), cv::Scalar(0, 0, 0), -1);
+    cv::Mat noise(image.size(), image.type());
+    cv::randu(noise, cv::Scalar::all(0), cv::Scalar::all(48));
+    return image + noise;
+}
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+// applyThreshold sobre applyFilter frente a applyFilterWithThreshold
+template <typename Filter>
+bool thresholdMatches(const Filter& filter, const cv::Mat& input, const std::vector<int>& thresholds) {
+    auto magnitude = filter.applyFilter(input);
+    if (!magnitude) {
+        return false;
+    }
+    for (int threshold : thresholds) {
+        auto derived = filter.applyThreshold(*magnitude, threshold);
+        auto direct = filter.applyFilterWithThreshold(input, threshold);
+        if (!derived || !direct || !sameImage(*derived, *direct)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main() {
+    std::cout << "=== Prueba de Máscara con Umbral Derivada de la Magnitud ===" << std::endl;
+
+    bool allPassed = true;
+    cv::Mat color = createTestImage(203, 117);
+    cv::Mat gray;
+    cv::cvtColor(color, gray, cv::COLOR_BGR2GRAY);
+    const std::vector<int> thresholds = {-1, 0, 1, 50, 128, 254, 255};
+
+    // Todas las estrategias y modos: una pasada da la misma magnitud y máscara que dos
+    for (FilterFactory::FilterType type : FilterFactory::getAvailableFilterTypes()) {
+        auto strategy = FilterFactory::createFilter(type);
+        if (!strategy) {
+            continue;
+        }
+        bool ok = true;
+        for (MagnitudeMode mode : {MagnitudeMode::EXACT, MagnitudeMode::L1, MagnitudeMode::LINF}) {
+            strategy->setMagnitudeMode(mode);
+            cv::Mat magnitude, mask;
+            for (int threshold : thresholds) {
+                bool processed = strategy->detectEdgesAndThresholdInto(color, magnitude, mask, threshold);
+                auto expectedEdges = strategy->detectEdges(color);
+                auto expectedMask = strategy->detectEdgesWithThreshold(color, threshold);
+                ok = ok && processed == expectedMask.has_value() &&
+                     (!processed || (expectedEdges && sameImage(magnitude, *expectedEdges) &&
+                                     sameImage(mask, *expectedMask)));
+            }
+        }
+        std::cout << (ok ? "✅ " : "❌ ") << strategy->getName() << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Buffers del llamador reutilizados entre llamadas
+    {
+        auto strategy = FilterFactory::createFilter("auto");
+        cv::Mat magnitude, mask;
+        strategy->detectEdgesAndThresholdInto(gray, magnitude, mask, 50);
+        const uchar* magnitudeData = magnitude.data;
+        const uchar* maskData = mask.data;
+        strategy->detectEdgesAndThresholdInto(gray, magnitude, mask, 90);
+        bool ok = magnitude.data == magnitudeData && mask.data == maskData;
+        std::cout << (ok ? "✅" : "❌") << " Magnitud y máscara reutilizadas entre llamadas" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // SobelFilter: rutas de una pasada (directa, fusionada, con blur, sin normalizar)
+    {
+        FilterConfig fused;
+        fused.fusedPipeline = true;
+        FilterConfig blurred;
+        blurred.useGaussianBlur = true;
+        FilterConfig raw;
+        raw.normalize = false;
+        FilterConfig l1;
+        l1.magnitudeMode = MagnitudeMode::L1;
+        bool ok = true;
+        for (const FilterConfig& config : {FilterConfig{}, fused, blurred, raw, l1}) {
+            ok = ok && thresholdMatches(SobelFilter(config), color, {0, 1, 50, 128, 254, 255});
+        }
+        cv::Mat magnitude = *SobelFilter().applyFilter(gray);
+        ok = ok && !SobelFilter().applyThreshold(magnitude, 256) && !SobelFilter().applyThreshold(cv::Mat(), 50);
+        std::cout << (ok ? "✅" : "❌") << " SobelFilter::applyThreshold idéntico a applyFilterWithThreshold"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Entradas de 16 bits: salida de 16 bits con umbral en sus unidades
+    cv::Mat deep;
+    gray.convertTo(deep, CV_16U, 257.0);
+    {
+        FilterConfig config;
+        config.hdrOutput = HdrOutput::MAGNITUDE_16U;
+        bool ok = thresholdMatches(SobelFilter(config), deep, {0, 255, 1000, 40000, 65535}) &&
+                  thresholdMatches(SobelFilter(), deep, {0, 50, 255});
+
+        SobelFilterHDR hdr(SobelFilterSIMD::detectBestLevel(), MagnitudeMode::EXACT, HdrOutput::MAGNITUDE_16U);
+        cv::Mat magnitude = hdr.applySobel(deep);
+        for (int threshold : {0, 300, 20000, 65535}) {
+            cv::Mat mask;
+            sobelThresholdMagnitude(magnitude, mask, threshold);
+            ok = ok && sameImage(mask, hdr.applySobelWithThreshold(deep, threshold));
+        }
+        std::cout << (ok ? "✅" : "❌") << " Magnitud de 16 bits (SobelFilter y SobelFilterHDR)" << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // SobelFilterTemplate: 8/16 bits, float y bordes calculados
+    {
+        cv::Mat real;
+        gray.convertTo(real, CV_32F, 1.0 / 255.0);
+        bool ok = thresholdMatches(SobelFilterTemplate<uint8_t>(), color, {0, 50, 254, 255}) &&
+                  thresholdMatches(SobelFilterTemplate<uint8_t, 5, BorderReflect101>(), gray, {0, 50, 255}) &&
+                  thresholdMatches(SobelFilterTemplate<uint16_t>(), deep, {0, 1000, 65535}) &&
+                  thresholdMatches(SobelFilterTemplate<float, 3, BorderReplicate>(), real, {0, 1, 2}) &&
+                  !SobelFilterTemplate<uint8_t>().applyThreshold(*SobelFilterTemplate<uint16_t>().applyFilter(deep), 50);
+        std::cout << (ok ? "✅" : "❌") << " SobelFilterTemplate::applyThreshold idéntico a applyFilterWithThreshold"
+                  << std::endl;
+        allPassed = allPassed && ok;
+    }
+
+    // Rendimiento: magnitud + máscara con dos pasadas frente a una
+    const int runs = 10;
+    cv::Mat frame = createTestImage(1920, 1080);
+    auto strategy = FilterFactory::createFilter("auto");
+    cv::Mat magnitude, mask;
+    strategy->detectEdgesAndThresholdInto(frame, magnitude, mask, 50);   // Memoria de trabajo reservada
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        strategy->detectEdgesInto(frame, magnitude);
+        strategy->detectEdgesWithThresholdInto(frame, mask, 50);
+    }
+    double twoPassMs = elapsedMs(start) / runs;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (int r = 0; r < runs; r++) {
+        strategy->detectEdgesAndThresholdInto(frame, magnitude, mask, 50);
+    }
+    double onePassMs = elapsedMs(start) / runs;
+
+    std::cout << std::endl;
+    std::cout << "=== Magnitud + máscara (1920x1080 BGR, " << strategy->getName() << ", media de " << runs
+              << ") ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Dos pasadas: " << twoPassMs << " ms" << std::endl;
+    std::cout << "Una pasada:  " << onePassMs << " ms (" << twoPassMs / onePassMs << "x)" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,18 @@
+#ifndef TEST_UTILS_H
+#define TEST_UTILS_H
+
+// =============================================================
+//  Utilidades comunes de las pruebas
+//  -----------------------------------------------------------
+//  Comparaciones de imágenes que comparten varios ejecutables
+//  de prueba.
+// =============================================================
+
+#include <opencv2/opencv.hpp>
+
+// Mismo tamaño, mismo tipo y todos los píxeles iguales
+inline bool sameImage(const cv::Mat& a, const cv::Mat& b) {
+    return a.size() == b.size() && a.type() == b.type() && cv::norm(a, b, cv::NORM_INF) == 0;
+}
+
+#endif // TEST_UTILS_H
@@ -0,0 +1,140 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "work_stealing_scheduler.h"
+#include "pthread_pool.h"
+#include "sobel_filter_pthread.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Comprueba que cada tarea se ejecuta exactamente una vez
+bool allExecutedOnce(const std::vector<std::atomic<int>>& counts) {
+    for (const auto& count : counts) {
+        if (count.load() != 1) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int countDifferences(const cv::Mat& a, const cv::Mat& b) {
+    cv::Mat diff;
+    cv::compare(a, b, diff, cv::CMP_NE);
+    return cv::countNonZero(diff);
+}
+
+// Simula un núcleo compartido: el hilo 0 tarda slowFactor veces más por tarea
+double makespanMs(PThreadPool& pool, int numTasks, int slowFactor, bool stealing) {
+    const int workers = pool.size();
+    WorkStealingScheduler scheduler(workers);
+    scheduler.reset(numTasks);
+
+    auto task = [slowFactor](int worker) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(worker == 0 ? slowFactor : 1));
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    pool.parallelFor(workers, [&](int worker) {
+        if (stealing) {
+            scheduler.run(worker, [&](int) { task(worker); });
+        } else {
+            // Reparto estático: un rango fijo de tareas por hilo
+            for (int t = numTasks * worker / workers; t < numTasks * (worker + 1) / workers; t++) {
+                task(worker);
+            }
+        }
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main() {
+    std::cout << "=== Prueba del Planificador con Robo de Trabajo ===" << std::endl;
+    bool allPassed = true;
+
+    // Cada tarea exactamente una vez, con pThreads y con OpenMP
+    int failures = 0;
+    for (int workers : {1, 2, 3, 8}) {
+        PThreadPool pool(workers);
+        WorkStealingScheduler scheduler(workers);
+        for (int numTasks : {0, 1, 5, 1000}) {
+            for (int repeat = 0; repeat < 20; repeat++) {
+                std::vector<std::atomic<int>> counts(numTasks);
+                scheduler.reset(numTasks);
+                pool.parallelFor(workers, [&](int worker) {
+                    scheduler.run(worker, [&](int t) { counts[t]++; });
+                });
+                failures += !allExecutedOnce(counts);
+
+                std::vector<std::atomic<int>> ompCounts(numTasks);
+                scheduler.reset(numTasks);
+                #pragma omp parallel num_threads(workers)
+                {
+                    int worker = 0;
+#ifdef _OPENMP
+                    worker = omp_get_thread_num();
+#endif
+                    scheduler.run(worker, [&](int t) { ompCounts[t]++; });
+                }
+                failures += !allExecutedOnce(ompCounts);
+            }
+        }
+    }
+    if (failures == 0) {
+        std::cout << "✅ Cada tarea se ejecuta exactamente una vez (pThreads y OpenMP)" << std::endl;
+    } else {
+        std::cout << "❌ " << failures << " repartos con tareas perdidas o repetidas" << std::endl;
+        allPassed = false;
+    }
+
+    // Rejilla de bloques: cubre la imagen sin solaparse
+    cv::Mat coverage = cv::Mat::zeros(479, 641, CV_32SC1);
+    for (const cv::Rect& tile : makeTileGrid(coverage.size(), cv::Size(64, 50))) {
+        for (int i = tile.y; i < tile.y + tile.height; i++) {
+            for (int j = tile.x; j < tile.x + tile.width; j++) {
+                coverage.at<int>(i, j)++;
+            }
+        }
+    }
+    double minCount = 0.0, maxCount = 0.0;
+    cv::minMaxLoc(coverage, &minCount, &maxCount);
+    if (minCount == 1.0 && maxCount == 1.0) {
+        std::cout << "✅ makeTileGrid cubre la imagen sin solapes" << std::endl;
+    } else {
+        std::cout << "❌ makeTileGrid deja huecos o solapes" << std::endl;
+        allPassed = false;
+    }
+
+    // El filtro pThreads con bandas robadas sigue dando la salida secuencial
+    cv::Mat image(479, 641, CV_8UC3);
+    cv::randu(image, cv::Scalar::all(0), cv::Scalar::all(256));
+    SobelFilterPThread filter(4);
+    if (countDifferences(filter.applySobel(image), filter.applySobelSequential(image)) == 0) {
+        std::cout << "✅ SobelFilterPThread idéntico a la versión secuencial" << std::endl;
+    } else {
+        std::cout << "❌ SobelFilterPThread difiere de la versión secuencial" << std::endl;
+        allPassed = false;
+    }
+
+    // Vecino ruidoso simulado: el hilo 0 va 4 veces más lento
+    PThreadPool pool(4);
+    double staticMs = makespanMs(pool, 64, 4, false);
+    double stealingMs = makespanMs(pool, 64, 4, true);
+    std::cout << std::endl;
+    std::cout << "=== Núcleo compartido simulado (4 hilos, 64 tareas, hilo 0 a 1/4 de velocidad) ===" << std::endl;
+    std::cout << "Reparto estático: " << staticMs << " ms" << std::endl;
+    std::cout << "Robo de trabajo:  " << stealingMs << " ms" << std::endl;
+
+    std::cout << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,108 @@
+#include <opencv2/opencv.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include "filter_factory.h"
+#include "edge_detection_strategy.h"
+#include "alloc_counter.h"
+
+// Secuencia de fotogramas sintéticos del mismo tamaño
+std::vector<cv::Mat> createFrames(int count, int width, int height, int type) {
+    std::vector<cv::Mat> frames;
+    for (int f = 0; f < count; f++) {
+        cv::Mat frame(height, width, type);
+        cv::randu(frame, cv::Scalar::all(0), cv::Scalar::all(256));
+        cv::circle(frame, cv::Point(width / 2 + f * 4, height / 2), height / 4, cv::Scalar::all(255), -1);
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+int main() {
+    std::cout << "=== Prueba de Bucle de Vídeo sin Reservas de Memoria ===" << std::endl;
+
+    const int warmupFrames = 3;
+    const int measuredFrames = 100;
+    const int threshold = 60;
+    std::vector<cv::Mat> grayFrames = createFrames(8, 640, 480, CV_8UC1);
+    std::vector<cv::Mat> colorFrames = createFrames(8, 640, 480, CV_8UC3);
+    bool allPassed = true;
+
+    // Estrategias con memoria de trabajo propia: cero reservas con entrada gris
+    const std::vector<FilterFactory::FilterType> zeroAllocTypes = {
+        FilterFactory::FilterType::SOBEL_SIMD,
+        FilterFactory::FilterType::SOBEL_SEPARABLE,
+        FilterFactory::FilterType::SOBEL_TILED
+    };
+
+    for (FilterFactory::FilterType type : FilterFactory::getAvailableFilterTypes()) {
+        auto strategy = FilterFactory::createFilter(type);
+        if (!strategy) {
+            continue;
+        }
+        bool mustBeZero = std::find(zeroAllocTypes.begin(), zeroAllocTypes.end(), type) != zeroAllocTypes.end();
+
+        // La salida reutilizada debe coincidir con la de detectEdges
+        cv::Mat output, mask;
+        bool sameOutput = true;
+        for (const cv::Mat& frame : grayFrames) {
+            auto expected = strategy->detectEdges(frame);
+            auto expectedMask = strategy->detectEdgesWithThreshold(frame, threshold);
+            bool ok = strategy->detectEdgesInto(frame, output) &&
+                      strategy->detectEdgesWithThresholdInto(frame, mask, threshold);
+            sameOutput = sameOutput && ok && expected && expectedMask &&
+                         cv::norm(*expected, output, cv::NORM_INF) == 0 &&
+                         cv::norm(*expectedMask, mask, cv::NORM_INF) == 0;
+        }
+
+        // Calentamiento: dimensiona salida y memoria de trabajo
+        for (int f = 0; f < warmupFrames; f++) {
+            strategy->detectEdgesInto(grayFrames[f], output);
+            strategy->detectEdgesWithThresholdInto(grayFrames[f], mask, threshold);
+            strategy->detectEdgesInto(colorFrames[f], output);
+        }
+
+        size_t grayAllocs = countAllocations(measuredFrames, [&](int f) {
+            strategy->detectEdgesInto(grayFrames[f % grayFrames.size()], output);
+        }).allocations;
+        size_t maskAllocs = countAllocations(measuredFrames, [&](int f) {
+            strategy->detectEdgesWithThresholdInto(grayFrames[f % grayFrames.size()], mask, threshold);
+        }).allocations;
+        size_t colorAllocs = countAllocations(measuredFrames, [&](int f) {
+            strategy->detectEdgesInto(colorFrames[f % colorFrames.size()], output);
+        }).allocations;
+
+        std::cout << std::left << std::setw(28) << strategy->getName()
+                  << " gris: " << std::setw(6) << grayAllocs
+                  << " umbral: " << std::setw(6) << maskAllocs
+                  << " BGR: " << std::setw(6) << colorAllocs
+                  << " (reservas en " << measuredFrames << " fotogramas)";
+
+        bool passed = sameOutput && (!mustBeZero || (grayAllocs == 0 && maskAllocs == 0));
+        if (!sameOutput) {
+            std::cout << "  ❌ salida distinta de detectEdges";
+        } else if (mustBeZero) {
+            std::cout << (passed ? "  ✅" : "  ❌ se esperaban 0 reservas");
+        }
+        std::cout << std::endl;
+        allPassed = allPassed && passed;
+    }
+
+    // Una salida que comparte datos con la entrada se rechaza
+    auto simd = FilterFactory::createFilter(FilterFactory::FilterType::SOBEL_SIMD);
+    cv::Mat aliased = grayFrames[0].clone();
+    if (simd && simd->detectEdgesInto(aliased, aliased)) {
+        std::cout << "❌ Se aceptó una salida que comparte memoria con la entrada" << std::endl;
+        allPassed = false;
+    }
+
+    std::cout << std::endl;
+    std::cout << "BGR depende de cv::cvtColor, que puede reservar memoria según el backend de OpenCV" << std::endl;
+    if (!allPassed) {
+        std::cout << "Prueba fallida" << std::endl;
+        return -1;
+    }
+    std::cout << "Prueba completada exitosamente!" << std::endl;
+    return 0;
+}